@@ -31,10 +31,9 @@
 #ifndef DEBUG_AUTO_FREE
 #define DEBUG_AUTO_FREE 0
 #endif
-/* the period between free_auto_free()s in the main loop */
+/* the period between free_auto_free()s in the main loop,
+ * and so the minimum time between auto_free(p) and free(p) there */
 #define AF_SECONDS 11
-/* the minimum time between auto_free(p) and free(p) */
-#define AF_DELAY_SECONDS 10
 
 #define AF_USE_SYSOBJ 0
 
@@ -52,16 +51,19 @@
 gpointer auto_free_ex_(gpointer p, GDestroyNotify f, const char *file, int line, const char *func);
 gpointer auto_free_on_exit_ex_(gpointer p, GDestroyNotify f, const char *file, int line, const char *func);
 
-/* free all the auto_free marked items in the
- * current thread with age > AF_DELAY_SECONDS */
+/* free the auto_free marked items of the current
+ * thread that were there at its previous free_auto_free() */
 void free_auto_free();
 
-/* call at thread termination:
+/* call when a scan or job is done, or at thread termination:
  * free all the auto_free marked items in the
- * current thread regardless of age */
+ * current thread regardless of age; done by itself
+ * when a thread exits */
 void free_auto_free_thread_final();
 
-/* call at program termination */
+/* call at program termination, once other threads are done
+ * with auto_free(): free the items of all threads, and the
+ * auto_free_on_exit() ones */
 void free_auto_free_final();
 
 #endif
@@ -73,4 +73,8 @@ ids_query_list ids_file_all_get_all(const gchar *file, split_loc_function split_
 void ids_trace_start();
 void ids_trace_stop();
 
+/* called after each scan_ids_file(); start is from g_get_monotonic_time() */
+typedef void (*ids_timing_func)(gint64 start, const gchar *file, const gchar *qpath);
+void ids_set_timing_func(ids_timing_func func);
+
 #endif
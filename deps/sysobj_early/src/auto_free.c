@@ -27,32 +27,54 @@
 #define sysobj_stats af_stats
 static struct {
     double auto_free_next;
-    unsigned long long
-        auto_freed,
-        auto_free_len;
+    unsigned long long auto_freed;
 } af_stats;
 #endif
 
-static GMutex free_lock;
-static GSList *free_list = NULL;
-static gboolean free_final = FALSE;
-static GTimer *auto_free_timer = NULL;
-static guint free_event_source = 0;
-#define af_elapsed() (auto_free_timer ? g_timer_elapsed(auto_free_timer, NULL) : 0)
+/* Every thread has its own arena: auto_free() bumps a slot in the current
+ * block of it, without locking, and the arena is released all at once by
+ * that same thread. free_auto_free() only releases the previous
+ * generation, so what was just marked lives for at least one more tick.
+ * The list of arenas is only touched when a thread makes its first
+ * auto_free() or exits, and by free_auto_free_final(). */
 
-#define auto_free_msg(msg, ...)  fprintf (stderr, "[%s] " msg "\n", __FUNCTION__, ##__VA_ARGS__) /**/
+#define AF_BLOCK_ITEMS 256
 
 typedef struct {
     gpointer ptr;
-    GThread *thread;
     GDestroyNotify f_free;
-    double stamp;
-
+#if (DEBUG_AUTO_FREE > 1)
     const char *file;
     int  line;
     const char *func;
+#endif
 } auto_free_item;
 
+typedef struct af_block {
+    struct af_block *next;
+    int n;
+    auto_free_item items[AF_BLOCK_ITEMS];
+} af_block;
+
+typedef struct {
+    af_block *current, *previous;
+    af_block *spare;
+    unsigned long long len;
+} af_arena;
+
+static void af_arena_thread_exit(gpointer data);
+
+static GPrivate af_arena_key = G_PRIVATE_INIT(af_arena_thread_exit);
+static GMutex arenas_lock;
+static GSList *arenas = NULL;
+static GSList *on_exit_list = NULL;     /* auto_free_item */
+static gboolean free_final = FALSE;
+static GTimer *auto_free_timer = NULL;
+static guint free_event_source = 0;
+#define af_elapsed() (auto_free_timer ? g_timer_elapsed(auto_free_timer, NULL) : 0)
+
+#define auto_free_msg(msg, ...)  fprintf (stderr, "[%s] " msg "\n", __FUNCTION__, ##__VA_ARGS__) /**/
+
 gboolean free_auto_free_sf(gpointer trash) {
     (void)trash;
     if (free_final) {
@@ -64,7 +86,100 @@ gboolean free_auto_free_sf(gpointer trash) {
     return G_SOURCE_CONTINUE;
 }
 
+static af_arena *af_arena_get(void) {
+    af_arena *a = g_private_get(&af_arena_key);
+
+    if (!a) {
+        a = g_new0(af_arena, 1);
+        g_private_set(&af_arena_key, a);
+        g_mutex_lock(&arenas_lock);
+        arenas = g_slist_prepend(arenas, a);
+        g_mutex_unlock(&arenas_lock);
+    }
+    return a;
+}
+
+static auto_free_item *af_arena_slot(af_arena *a) {
+    af_block *b = a->current;
+
+    if (!b || b->n == AF_BLOCK_ITEMS) {
+        if (a->spare) {
+            b = a->spare;
+            a->spare = b->next;
+        } else {
+            b = g_new(af_block, 1);
+        }
+        b->n = 0;
+        b->next = a->current;
+        a->current = b;
+    }
+    a->len++;
+    return &b->items[b->n++];
+}
+
+static void free_auto_free_item(auto_free_item *z) {
+#if (DEBUG_AUTO_FREE > 1)
+    if (z->file || z->func)
+        auto_free_msg("free: %p from %s:%d %s()", z->ptr, z->file, z->line, z->func);
+    else
+        auto_free_msg("free: %p", z->ptr);
+#endif
+    z->f_free(z->ptr);
+}
+
+/* frees the items of the blocks, and keeps one of them for later */
+static unsigned long long af_blocks_free(af_arena *a, af_block *b) {
+    unsigned long long fc = 0;
+    af_block *n;
+    int i;
+
+    for (; b; b = n) {
+        n = b->next;
+        for (i = b->n - 1; i >= 0; i--)
+            free_auto_free_item(&b->items[i]);
+        fc += b->n;
+        if (!a->spare) {
+            b->next = NULL;
+            a->spare = b;
+        } else {
+            g_free(b);
+        }
+    }
+    a->len -= fc;
+    return fc;
+}
+
+static void af_arena_release(af_arena *a, gboolean all) {
+    unsigned long long fc;
+
+    fc = af_blocks_free(a, a->previous);
+    a->previous = a->current;
+    a->current = NULL;
+    if (all) {
+        fc += af_blocks_free(a, a->previous);
+        a->previous = NULL;
+    }
+
+    if (DEBUG_AUTO_FREE)
+        auto_free_msg("freed %llu, %llu left (from thread %p)", fc, a->len, g_thread_self());
+    sysobj_stats.auto_freed += fc;
+}
+
+static void af_arena_thread_exit(gpointer data) {
+    af_arena *a = (af_arena*)data;
+
+    g_mutex_lock(&arenas_lock);
+    arenas = g_slist_remove(arenas, a);
+    g_mutex_unlock(&arenas_lock);
+
+    af_arena_release(a, TRUE);
+    g_free(a->spare);
+    g_free(a);
+}
+
 gpointer auto_free_ex_(gpointer p, GDestroyNotify f, const char *file, int line, const char *func) {
+    auto_free_item *z;
+
     if (!p) return p;
 
     /* an auto_free() after free_auto_free_final()?
@@ -72,12 +187,12 @@ gpointer auto_free_ex_(gpointer p, GDestroyNotify f, const char *file, int line,
     if (free_final)
         free_final = FALSE;
 
-    if (!auto_free_timer) {
-        auto_free_timer = g_timer_new();
-        g_timer_start(auto_free_timer);
-    }
-
     if (!free_event_source) {
+        if (!auto_free_timer) {
+            auto_free_timer = g_timer_new();
+            g_timer_start(auto_free_timer);
+        }
+
         /* if there is a main loop, then this will call
          * free_auto_free() in idle time every AF_SECONDS seconds.
          * If there is no main loop, then free_auto_free()
@@ -87,108 +202,71 @@ gpointer auto_free_ex_(gpointer p, GDestroyNotify f, const char *file, int line,
         sysobj_stats.auto_free_next = sysobj_elapsed() + AF_SECONDS;
     }
 
-    auto_free_item *z = g_new0(auto_free_item, 1);
+    z = af_arena_slot(af_arena_get());
     z->ptr = p;
     z->f_free = f;
-    z->thread = g_thread_self();
+#if (DEBUG_AUTO_FREE > 1)
     z->file = file;
     z->line = line;
     z->func = func;
-    z->stamp = af_elapsed();
-    g_mutex_lock(&free_lock);
-    free_list = g_slist_prepend(free_list, z);
-    sysobj_stats.auto_free_len++;
-    g_mutex_unlock(&free_lock);
+#else
+    (void)file; (void)line; (void)func;
+#endif
     return p;
 }
 
 gpointer auto_free_on_exit_ex_(gpointer p, GDestroyNotify f, const char *file, int line, const char *func) {
+    auto_free_item *z;
+
     if (!p) return p;
 
-    auto_free_item *z = g_new0(auto_free_item, 1);
+    z = g_new0(auto_free_item, 1);
     z->ptr = p;
     z->f_free = f;
-    z->thread = g_thread_self();
+#if (DEBUG_AUTO_FREE > 1)
     z->file = file;
     z->line = line;
     z->func = func;
-    z->stamp = -1.0;
-    g_mutex_lock(&free_lock);
-    free_list = g_slist_prepend(free_list, z);
-    sysobj_stats.auto_free_len++;
-    g_mutex_unlock(&free_lock);
-    return p;
-}
-
-static struct { GDestroyNotify fptr; char *name; }
-    free_function_tab[] = {
-    { (GDestroyNotify) g_free,             "g_free" },
-#if (AF_USE_SYSOBJ)
-    { (GDestroyNotify) sysobj_free,        "sysobj_free" },
-    { (GDestroyNotify) class_free,         "class_free" },
-    { (GDestroyNotify) sysobj_filter_free, "sysobj_filter_free" },
-    { (GDestroyNotify) sysobj_virt_free,   "sysobj_virt_free" },
+#else
+    (void)file; (void)line; (void)func;
 #endif
-    { NULL, "(null)" },
-};
-
-static void free_auto_free_ex(gboolean thread_final) {
-    GThread *this_thread = g_thread_self();
-    GSList *l = NULL, *n = NULL;
-    long long unsigned fc = 0;
-    double now = af_elapsed();
-
-    if (!free_list) return;
-
-    g_mutex_lock(&free_lock);
-    if (DEBUG_AUTO_FREE)
-        auto_free_msg("%llu total items in queue, but will free from thread %p only... ", sysobj_stats.auto_free_len, this_thread);
-    for(l = free_list; l; l = n) {
-        auto_free_item *z = (auto_free_item*)l->data;
-        n = l->next;
-        if (!free_final && z->stamp < 0) continue;
-        double age = now - z->stamp;
-        if (free_final || (z->thread == this_thread && (thread_final || age > AF_DELAY_SECONDS) ) ) {
-            if (DEBUG_AUTO_FREE == 2) {
-                char fptr[128] = "", *fname;
-                for(int i = 0; i < (int)G_N_ELEMENTS(free_function_tab); i++)
-                    if (z->f_free == free_function_tab[i].fptr)
-                        fname = free_function_tab[i].name;
-                if (!fname) {
-                    snprintf(fname, 127, "%p", z->f_free);
-                    fname = fptr;
-                }
-                if (z->file || z->func)
-                    auto_free_msg("free: %s(%p) age:%lfs from %s:%d %s()", fname, z->ptr, age, z->file, z->line, z->func);
-                else
-                    auto_free_msg("free: %s(%p) age:%lfs", fname, z->ptr, age);
-            }
-
-            z->f_free(z->ptr);
-            g_free(z);
-            free_list = g_slist_delete_link(free_list, l);
-            fc++;
-        }
-    }
-    if (DEBUG_AUTO_FREE)
-        auto_free_msg("... freed %llu (from thread %p)", fc, this_thread);
-    sysobj_stats.auto_freed += fc;
-    sysobj_stats.auto_free_len -= fc;
-    g_mutex_unlock(&free_lock);
+    g_mutex_lock(&arenas_lock);
+    on_exit_list = g_slist_prepend(on_exit_list, z);
+    g_mutex_unlock(&arenas_lock);
+    return p;
 }
 
 void free_auto_free_thread_final() {
-    free_auto_free_ex(TRUE);
+    af_arena *a = g_private_get(&af_arena_key);
+
+    if (a)
+        af_arena_release(a, TRUE);
 }
 
 void free_auto_free_final() {
+    GSList *l;
+
     free_final = TRUE;
-    free_auto_free_ex(TRUE);
+
+    g_mutex_lock(&arenas_lock);
+    for (l = arenas; l; l = l->next)
+        af_arena_release((af_arena*)l->data, TRUE);
+    for (l = on_exit_list; l; l = l->next) {
+        free_auto_free_item((auto_free_item*)l->data);
+        g_free(l->data);
+    }
+    g_slist_free(on_exit_list);
+    on_exit_list = NULL;
+    g_mutex_unlock(&arenas_lock);
+
     if (auto_free_timer)
         g_timer_destroy(auto_free_timer);
     auto_free_timer = NULL;
 }
 
 void free_auto_free() {
-    free_auto_free_ex(FALSE);
+    af_arena *a = g_private_get(&af_arena_key);
+
+    if (a)
+        af_arena_release(a, FALSE);
 }
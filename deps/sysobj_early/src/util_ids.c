@@ -28,6 +28,8 @@
 static int ids_tracing = 0;
 void ids_trace_start() { ids_tracing = 1; }
 void ids_trace_stop() { ids_tracing = 0; }
+static ids_timing_func ids_timing = NULL;
+void ids_set_timing_func(ids_timing_func func) { ids_timing = func; }
 
 ids_query *ids_query_new(const gchar *qpath) {
     ids_query *s = g_new0(ids_query, 1);
@@ -88,7 +90,7 @@ static void ids_query_result_set_str(ids_query_result *ret, int tabs, gchar *p)
  * - usb.ids "<vendor>/<device>", "C <class>" etc
  * - edid.ids "<3letter_vendor>"
  */
-long scan_ids_file(const gchar *file, const gchar *qpath, ids_query_result *result, long start_offset) {
+static long _scan_ids_file(const gchar *file, const gchar *qpath, ids_query_result *result, long start_offset) {
     gchar **qparts = NULL;
     gchar buff[IDS_LOOKUP_BUFF_SIZE] = "";
     ids_query_result ret = {};
@@ -191,6 +193,19 @@ ids_lookup_done:
     return last_root_fpos;
 }
 
+long scan_ids_file(const gchar *file, const gchar *qpath, ids_query_result *result, long start_offset) {
+    gint64 start;
+    long ret;
+
+    if (!ids_timing)
+        return _scan_ids_file(file, qpath, result, start_offset);
+
+    start = g_get_monotonic_time();
+    ret = _scan_ids_file(file, qpath, result, start_offset);
+    ids_timing(start, file, qpath);
+    return ret;
+}
+
 static gint _ids_query_list_cmp(const ids_query *ql1, const ids_query *ql2) {
     return g_strcmp0(ql1->qpath, ql2->qpath);
 }
@@ -17,6 +17,8 @@
  *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+#define _GNU_SOURCE /* for CPU_COUNT_S() */
+#include <sched.h>
 #include <string.h>
 #include "hardinfo.h"
 #include "cpu_util.h"
@@ -125,6 +127,158 @@ int cpu_procs_cores_threads_nodes(int *p, int *c, int *t, int *n)
     return 1;
 }
 
+/* the cgroup this process belongs to, for a v1 controller, or for the
+ * v2 unified hierarchy if controller is NULL */
+static gchar *cpu_cgroup_path(const gchar *controller)
+{
+    gchar *contents, **lines, *ret = NULL;
+    int i;
+
+    if (!g_file_get_contents("/proc/self/cgroup", &contents, NULL, NULL))
+        return NULL;
+
+    lines = g_strsplit(contents, "\n", -1);
+    for (i = 0; lines[i] && !ret; i++) {
+        /* hierarchy-id:controller-list:path */
+        gchar **fields = g_strsplit(lines[i], ":", 3);
+
+        if (g_strv_length(fields) == 3) {
+            if (!controller) {
+                if (g_str_equal(fields[0], "0") && !*fields[1])
+                    ret = g_strdup(fields[2]);
+            } else {
+                gchar **ctrls = g_strsplit(fields[1], ",", -1);
+                if (g_strv_contains((const gchar * const *)ctrls, controller))
+                    ret = g_strdup(fields[2]);
+                g_strfreev(ctrls);
+            }
+        }
+        g_strfreev(fields);
+    }
+    g_strfreev(lines);
+    g_free(contents);
+
+    return ret;
+}
+
+static long cpu_cgroup_long(const gchar *dir, const gchar *file)
+{
+    gchar *path, *contents = NULL;
+    long ret = -1;
+
+    path = g_build_filename(dir, file, NULL);
+    if (g_file_get_contents(path, &contents, NULL, NULL))
+        ret = strtol(contents, NULL, 10);
+    g_free(path);
+    g_free(contents);
+
+    return ret;
+}
+
+/* The tightest CPU bandwidth limit from the cgroup up to the root of the
+ * mount. Without a cgroup namespace, /proc/self/cgroup shows a path from
+ * the host's root that may not exist under the container's mount, so
+ * missing levels are just skipped. */
+static gboolean cpu_cgroup_quota(const gchar *mount, const gchar *cgroup,
+                                 gboolean v2, long *quota, long *period)
+{
+    gchar *dir = g_strdup(cgroup);
+    gboolean found = FALSE;
+
+    for (;;) {
+        gchar *base = g_build_filename(mount, dir, NULL);
+        long q = -1, p = 0;
+
+        if (v2) {
+            gchar *path = g_build_filename(base, "cpu.max", NULL);
+            gchar *contents = NULL;
+
+            /* "$MAX $PERIOD", with $MAX "max" if unlimited */
+            if (g_file_get_contents(path, &contents, NULL, NULL) &&
+                sscanf(contents, "%ld %ld", &q, &p) != 2)
+                q = -1;
+            g_free(path);
+            g_free(contents);
+        } else {
+            q = cpu_cgroup_long(base, "cpu.cfs_quota_us");
+            p = cpu_cgroup_long(base, "cpu.cfs_period_us");
+        }
+        g_free(base);
+
+        if (q > 0 && p > 0 &&
+            (!found || (double)q / p < (double)*quota / *period)) {
+            *quota = q;
+            *period = p;
+            found = TRUE;
+        }
+
+        if (!*dir || g_str_equal(dir, "/") || g_str_equal(dir, "."))
+            break;
+        base = g_path_get_dirname(dir);
+        g_free(dir);
+        dir = base;
+    }
+    g_free(dir);
+
+    return found;
+}
+
+int cpu_limits_get(cpu_limits *l)
+{
+    cpu_set_t *set;
+    size_t size;
+    gchar *cgroup;
+    int procs, nodes, ncpus;
+
+    memset(l, 0, sizeof(*l));
+    l->affinity = -1;
+    l->quota = -1;
+
+    if (!cpu_procs_cores_threads_nodes(&procs, &l->cores, &l->threads, &nodes))
+        l->cores = l->threads = 1;
+    l->effective = l->threads;
+
+    /* the mask can be larger than the cpu_set_t default */
+    ncpus = MAX(l->threads, CPU_SETSIZE);
+    set = CPU_ALLOC(ncpus);
+    if (set) {
+        size = CPU_ALLOC_SIZE(ncpus);
+        CPU_ZERO_S(size, set);
+        if (sched_getaffinity(0, size, set) == 0) {
+            l->affinity = CPU_COUNT_S(size, set);
+            l->effective = MIN(l->effective, l->affinity);
+        }
+        CPU_FREE(set);
+    }
+
+    if ((cgroup = cpu_cgroup_path(NULL))) {
+        const gchar *mount =
+            g_file_test("/sys/fs/cgroup/cgroup.controllers", G_FILE_TEST_EXISTS)
+                ? "/sys/fs/cgroup"
+                : "/sys/fs/cgroup/unified";
+        cpu_cgroup_quota(mount, cgroup, TRUE, &l->quota, &l->period);
+        g_free(cgroup);
+    }
+    if (l->quota < 0 && (cgroup = cpu_cgroup_path("cpu"))) {
+        const gchar *mount =
+            g_file_test("/sys/fs/cgroup/cpu", G_FILE_TEST_IS_DIR)
+                ? "/sys/fs/cgroup/cpu"
+                : "/sys/fs/cgroup/cpu,cpuacct";
+        cpu_cgroup_quota(mount, cgroup, FALSE, &l->quota, &l->period);
+        g_free(cgroup);
+    }
+    if (l->quota > 0) {
+        /* a quota of 1.5 CPUs can keep two threads busy part of the time */
+        l->effective =
+            MIN(l->effective, (int)((l->quota + l->period - 1) / l->period));
+    }
+
+    if (l->effective < 1)
+        l->effective = 1;
+
+    return l->effective;
+}
+
 cpufreq_data *cpufreq_new(gint id)
 {
     cpufreq_data *cpufd;
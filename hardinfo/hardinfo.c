@@ -26,6 +26,9 @@
 #include <vendor.h>
 
 #include <binreloc.h>
+#include <trace.h>
+#include <snapshot.h>
+#include <report_diff.h>
 
 ProgramParameters params = { 0 };
 
@@ -43,6 +46,10 @@ int main(int argc, char **argv)
     /* parse all command line parameters */
     parameters_init(&argc, &argv, &params);
 
+    /* written when hardinfo exits */
+    if (params.trace_file)
+        trace_init(params.trace_file);
+
     /* show version information and quit */
     if (params.show_version) {
         g_print("HardInfo version " VERSION "\n");
@@ -91,7 +98,8 @@ int main(int argc, char **argv)
 	return 0;
     }
 
-    if (!params.create_report && !params.run_benchmark) {
+    if (!params.create_report && !params.run_benchmark &&
+        !params.compare_benchmarks && !params.diff_files && !params.query) {
         /* we only try to open the UI if the user didn't ask for a report. */
         params.gui_running = ui_init(&argc, &argv);
 
@@ -115,13 +123,59 @@ int main(int argc, char **argv)
 	modules = modules_load_all();
     }
 
+    /* data of earlier runs */
+    snapshot_init();
+
     /* initialize vendor database */
     vendor_init();
 
     /* initialize moreinfo */
     moreinfo_init();
 
-    if (params.run_benchmark) {
+    if (params.diff_files) {
+        gint changes = report_diff(params.diff_files[0], params.diff_files[1],
+                                   modules);
+
+        if (changes < 0)
+            exit_code = 2;
+        else if (changes > 0)
+            exit_code = 1;
+    } else if (params.query) {
+        /* modules are initialized as their entries are needed */
+        if (!report_query(modules, params.query, params.report_format, stdout))
+            exit_code = 1;
+    } else if (params.compare_benchmarks) {
+        gchar *result;
+
+        result = module_call_method_param("benchmark::compareBenchmarks",
+                                          params.compare_benchmarks);
+        if (!result) {
+          fprintf(stderr, _("benchmark.so not loaded"));
+          exit_code = 2;
+        } else {
+          gint regressions = g_ascii_strtoll(result, NULL, 10);
+
+          if (regressions < 0)
+            exit_code = 2;
+          else if (regressions > 0)
+            exit_code = 1;
+          g_free(result);
+        }
+    } else if (params.run_benchmark && (g_str_equal(params.run_benchmark, "all") ||
+                                 strchr(params.run_benchmark, ','))) {
+        gchar *result;
+
+        /* results are written to stdout as each benchmark finishes */
+        result = module_call_method_param("benchmark::runBenchmarks", params.run_benchmark);
+        if (!result) {
+          fprintf(stderr, _("benchmark.so not loaded"));
+          exit_code = 1;
+        } else {
+          if (g_ascii_strtoll(result, NULL, 10) > 0)
+            exit_code = 1;
+          g_free(result);
+        }
+    } else if (params.run_benchmark) {
         gchar *result;
 
         result = module_call_method_param("benchmark::runBenchmark", params.run_benchmark);
@@ -145,20 +199,26 @@ int main(int argc, char **argv)
 	gtk_main();
     } else if (params.create_report) {
 	/* generate report */
-	gchar *report;
+	gint64 start = trace_begin();
 
 	DEBUG("generating report");
 
-	report = report_create_from_module_list_format(modules,
-						       params.
-						       report_format);
-	g_print("%s", report);
+	/* every module is going to be needed */
+	modules_init_all(modules);
 
-	g_free(report);
+	if (!report_write_from_module_list_format(modules, params.report_format,
+						  stdout)) {
+	    /* e.g. a full disk; the report is cut short */
+	    fprintf(stderr, _("Could not write the report\n"));
+	    exit_code = 1;
+	}
+	trace_end(start, "report", "report");
     } else {
         g_error(_("Don't know what to do. Exiting."));
     }
 
+    snapshot_save();
+
     moreinfo_shutdown();
     vendor_cleanup();
     dmidecode_cache_free();
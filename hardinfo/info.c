@@ -18,6 +18,7 @@
 
 #include "hardinfo.h"
 #include "util_sysobj.h" /* for SEQ() */
+#include "trace.h"
 
 /* Using a slightly modified gg_key_file_parse_string_as_value()
  * from GLib in flatten(), to escape characters and the separator.
@@ -25,7 +26,7 @@
  * to pass it anyway. */
 /* Now in hardinfo.h -- #include "gg_key_file_parse_string_as_value.c" */
 
-static const gchar *info_column_titles[] = {
+const gchar *info_column_titles[INFO_N_COLUMNS] = {
     "TextValue", "Value", "Progress", "Extra1", "Extra2"
 };
 
@@ -277,21 +278,80 @@ static void free_group_fields(struct InfoGroup *group)
     }
 }
 
-static void flatten_group(GString *output, const struct InfoGroup *group, guint group_count)
+void info_group_sort(struct InfoGroup *group)
+{
+    if (group->fields && group->sort != INFO_GROUP_SORT_NONE)
+        g_array_sort(group->fields, sort_functions[group->sort]);
+}
+
+/* The key of a field in the flattened form, [$<flags><tag>$]<name>; see
+ * key_get_components(). Fields without a tag that need one (for flags or
+ * an icon) get ITEM<group_index>-<field_index>. */
+gchar *info_field_key(const struct InfoField *field, guint group_index, guint field_index)
+{
+    gchar tmp_tag[256] = ""; /* for generated tag */
+    gchar *escaped_name = NULL, *key;
+    const gchar *tp = field->tag;
+    gboolean escaped = field->label_is_escaped;
+
+    if (!escaped && (strchr(field->name, '=') || strchr(field->name, '$'))) {
+        // TODO: what about # ?
+        escaped_name = key_label_escape(field->name);
+        escaped = TRUE;
+    }
+
+    if (!tp) {
+        snprintf(tmp_tag, 255, "ITEM%d-%d", group_index, field_index);
+        tp = tmp_tag;
+    }
+
+    if (field->tag || field->highlight || field->report_details ||
+        field->value_has_vendor || field->icon || escaped) {
+        key = g_strdup_printf("$%s%s%s%s%s$%s",
+            escaped ? "@" : "",
+            field->highlight ? "*" : "",
+            field->report_details ? "!" : "",
+            field->value_has_vendor ? "^" : "",
+            tp, escaped_name ? escaped_name : field->name);
+    } else {
+        key = g_strdup(field->name);
+    }
+
+    g_free(escaped_name);
+    return key;
+}
+
+/* what the shell passes to hi_get_field() for an UpdateInterval field */
+gchar *info_field_update_name(const struct InfoField *field)
+{
+    gchar *escaped_name = NULL, *name;
+
+    if (!field->label_is_escaped &&
+        (strchr(field->name, '=') || strchr(field->name, '$')))
+        escaped_name = key_label_escape(field->name);
+
+    if (field->tag)
+        name = g_strdup_printf("$%s$%s", field->tag,
+                               escaped_name ? escaped_name : field->name);
+    else
+        name = g_strdup(escaped_name ? escaped_name : field->name);
+
+    g_free(escaped_name);
+    return name;
+}
+
+static void flatten_group(GString *output, struct InfoGroup *group, guint group_count)
 {
     guint i;
 
     if (group->name != NULL)
         g_string_append_printf(output, "[%s#%d]\n", group->name, group_count);
 
-    if (group->sort != INFO_GROUP_SORT_NONE)
-        g_array_sort(group->fields, sort_functions[group->sort]);
+    info_group_sort(group);
 
     if (group->fields) {
         for (i = 0; i < group->fields->len; i++) {
             struct InfoField *field = &g_array_index(group->fields, struct InfoField, i);
-            gchar tmp_tag[256] = ""; /* for generated tag */
-
             gboolean do_escape = TRUE; /* refers to the value side only */
             if (field->value && strchr(field->value, '|') ) {
                 /* turning off escaping for values that may have columns */
@@ -307,39 +367,16 @@ static void flatten_group(GString *output, const struct InfoGroup *group, guint
                  */
             }
 
-            const gchar *tp = field->tag;
-            gboolean tagged = !!tp;
-            gboolean flagged = field->highlight || field->report_details || field->value_has_vendor;
-            if (!tp) {
-                snprintf(tmp_tag, 255, "ITEM%d-%d", group_count, i);
-                tp = tmp_tag;
-            }
-            if (!field->label_is_escaped) {
-                if (strchr(field->name, '=')
-                    || strchr(field->name, '$')) {
-                        // TODO: what about # ?
-                        gchar *ofn = (gchar*)field->name;
-                        field->name = key_label_escape(ofn);
-                        g_free(ofn);
-                        field->label_is_escaped = TRUE;
-                }
-            }
-            if (tagged || flagged || field->icon) {
-                g_string_append_printf(output, "$%s%s%s%s%s$",
-                    field->label_is_escaped ? "@" : "",
-                    field->highlight ? "*" : "",
-                    field->report_details ? "!" : "",
-                    field->value_has_vendor ? "^" : "",
-                    tp);
-            }
+            gchar *key = info_field_key(field, group_count, i);
 
             if (do_escape) {
                 gchar *escaped_value = gg_key_file_parse_string_as_value(field->value, '|');
-                g_string_append_printf(output, "%s=%s\n", field->name, escaped_value);
+                g_string_append_printf(output, "%s=%s\n", key, escaped_value);
                 g_free(escaped_value);
             } else {
-                g_string_append_printf(output, "%s=%s\n", field->name, field->value);
+                g_string_append_printf(output, "%s=%s\n", key, field->value);
             }
+            g_free(key);
         }
     } else if (group->computed) {
         g_string_append_printf(output, "%s\n", group->computed);
@@ -358,17 +395,18 @@ static void flatten_shell_param(GString *output, const struct InfoGroup *group,
         gchar tmp_tag[256] = ""; /* for generated tag */
 
         const gchar *tp = field->tag;
-        gboolean tagged = !!tp;
         if (!tp) {
             snprintf(tmp_tag, 255, "ITEM%d-%d", group_count, i);
             tp = tmp_tag;
         }
 
         if (field->update_interval) {
-            g_string_append_printf(output, "UpdateInterval$%s%s%s=%d\n",
-                tagged ? tp : "", tagged ? "$" : "", /* tag and close or nothing */
-                field->name,
-                field->update_interval);
+            gchar *name = info_field_update_name(field);
+
+            /* the shell takes what follows the first '$' */
+            g_string_append_printf(output, "UpdateInterval%s%s=%d\n",
+                field->tag ? "" : "$", name, field->update_interval);
+            g_free(name);
         }
 
         if (field->icon) {
@@ -404,13 +442,10 @@ static void flatten_shell_param_global(GString *output, const struct Info *info)
     }
 }
 
-gchar *info_flatten(struct Info *info)
+/* The key-file form of a struct Info, which is left as it was (but for
+ * the order of sorted groups) */
+gchar *info_to_key_file(struct Info *info)
 {
-    /* This is a scaffolding method: eventually the HardInfo shell should
-     * understand a struct Info instead of parsing these strings, which are
-     * brittle and unnecessarily complicates things.  Being a temporary
-     * method, no attention is paid to improve the memory allocation
-     * strategy. */
     GString *values;
     GString *shell_param;
     guint i;
@@ -425,22 +460,94 @@ gchar *info_flatten(struct Info *info)
 
             flatten_group(values, group, i);
             flatten_shell_param(shell_param, group, i);
-
-            free_group_fields(group);
         }
-
-        g_array_free(info->groups, TRUE);
     }
 
     flatten_shell_param_global(shell_param, info);
     g_string_append_printf(values, "[$ShellParam$]\n%s", shell_param->str);
 
     g_string_free(shell_param, TRUE);
-    g_free(info);
 
     return g_string_free(values, FALSE);
 }
 
+gchar *info_flatten(struct Info *info)
+{
+    /* The key-file form of a struct Info, for whatever still wants the
+     * string: remote connections, the shell report format, and entries
+     * without an info_callback. The shell and the reports walk the struct
+     * Info of entries that have one instead of parsing this back; see
+     * module_entry_info(). */
+    gint64 start = trace_begin();
+    guint n_groups = info->groups ? info->groups->len : 0;
+    gchar *values;
+
+    values = info_to_key_file(info);
+    info_free(info);
+
+    trace_end(start, "info", "info_flatten (%u groups)", n_groups);
+
+    return values;
+}
+
+/* Copies every string the info points to into info->strings, so it can be
+ * kept after the idle_free()d and static buffers the module used are gone. */
+void info_detach(struct Info *info)
+{
+    guint i, j;
+
+    if (!info->strings)
+        info->strings = g_string_chunk_new(1024);
+
+#define DETACH(str) ((str) ? g_string_chunk_insert(info->strings, (str)) : NULL)
+    for (i = 0; i < INFO_N_COLUMNS; i++)
+        info->column_titles[i] = DETACH(info->column_titles[i]);
+
+    for (i = 0; i < info->groups->len; i++) {
+        struct InfoGroup *group = &g_array_index(info->groups, struct InfoGroup, i);
+
+        group->name = DETACH(group->name);
+        group->computed = DETACH(group->computed);
+        if (!group->fields)
+            continue;
+
+        for (j = 0; j < group->fields->len; j++) {
+            struct InfoField *field = &g_array_index(group->fields, struct InfoField, j);
+            const gchar *name = DETACH(field->name);
+            const gchar *value = DETACH(field->value);
+
+            if (field->free_name_on_flatten)
+                g_free((gchar *)field->name);
+            if (field->free_value_on_flatten)
+                g_free((gchar *)field->value);
+
+            field->name = name;
+            field->value = value;
+            field->icon = DETACH(field->icon);
+            field->free_name_on_flatten = FALSE;
+            field->free_value_on_flatten = FALSE;
+        }
+    }
+#undef DETACH
+}
+
+void info_free(struct Info *info)
+{
+    guint i;
+
+    if (!info)
+        return;
+
+    if (info->groups) {
+        for (i = 0; i < info->groups->len; i++)
+            free_group_fields(&g_array_index(info->groups, struct InfoGroup, i));
+        g_array_free(info->groups, TRUE);
+    }
+    if (info->strings)
+        g_string_chunk_free(info->strings);
+    g_free(info);
+}
+
 void info_remove_group(struct Info *info, guint index)
 {
     struct InfoGroup *grp;
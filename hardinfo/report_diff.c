@@ -0,0 +1,446 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Both reports are flattened into a list of fields, each with a key made of
+ * the ids of its module and entry, and the names of its group and field;
+ * for a field with a moreinfo tag, the tag is used instead of its name, as
+ * it is what identifies a device (PCI address, USB bus and device, DIMM
+ * locator, interface name...) while its name may change with it. The
+ * details of a field are fields of their own, under the key of that field.
+ * Names found more than once under the same key get "#2", "#3"...
+ *
+ * Group and field names are translated, so reports made in different
+ * languages have their groups, and fields without a tag, matched by
+ * position instead.
+ *
+ * The fields are then looked up by key in a hash table of the other report,
+ * so it takes linear time. The details of an added or removed field aren't
+ * listed on their own.
+ */
+
+#include <json-glib/json-glib.h>
+
+#include "hardinfo.h"
+#include "report.h"
+#include "report_diff.h"
+
+typedef struct {
+    gchar *key;
+    gchar *path;                /* the same, with names only, to show */
+    const gchar *value;
+    gint parent;                /* field these are the details of, or -1 */
+} DiffField;
+
+typedef struct {
+    JsonParser *parser;
+    JsonArray *modules;
+    const gchar *locale;
+    gboolean by_position;       /* groups and untagged fields */
+
+    GArray *fields;             /* DiffField */
+    GHashTable *keys;           /* key -> index in fields + 1 */
+} DiffReport;
+
+static const gchar *diff_get_string(JsonObject *object, const gchar *member)
+{
+    JsonNode *node = json_object_get_member(object, member);
+
+    if (!node || JSON_NODE_TYPE(node) != JSON_NODE_VALUE)
+        return NULL;
+    return json_node_get_string(node);
+}
+
+static JsonArray *diff_get_list(JsonObject *object, const gchar *member)
+{
+    JsonNode *node = json_object_get_member(object, member);
+
+    if (!node || JSON_NODE_TYPE(node) != JSON_NODE_ARRAY)
+        return NULL;
+    return json_node_get_array(node);
+}
+
+/* parent + "/" + id, unique among the keys seen so far */
+static gchar *diff_key(GHashTable *seen, const gchar *parent, const gchar *id)
+{
+    gchar *key = g_strdup_printf("%s/%s", parent, id);
+    gint n = GPOINTER_TO_INT(g_hash_table_lookup(seen, key)) + 1;
+
+    g_hash_table_replace(seen, g_strdup(key), GINT_TO_POINTER(n));
+    if (n > 1) {
+        gchar *unique = g_strdup_printf("%s#%d", key, n);
+
+        g_free(key);
+        key = unique;
+    }
+
+    return key;
+}
+
+static void diff_add_groups(DiffReport *report, GHashTable *seen,
+                            JsonArray *groups, const gchar *key,
+                            const gchar *path, gint parent);
+
+static void diff_add_fields(DiffReport *report, GHashTable *seen,
+                            JsonArray *fields, const gchar *key,
+                            const gchar *path, gint parent)
+{
+    guint i;
+
+    for (i = 0; i < json_array_get_length(fields); i++) {
+        JsonObject *field = json_array_get_object_element(fields, i);
+        const gchar *name, *tag;
+        JsonArray *details;
+        DiffField f;
+
+        if (!field)
+            continue;
+
+        name = diff_get_string(field, "name");
+        tag = diff_get_string(field, "tag");
+
+        if (tag) {
+            f.key = diff_key(seen, key, tag);
+        } else if (report->by_position) {
+            gchar *pos = g_strdup_printf("@%u", i);
+
+            f.key = diff_key(seen, key, pos);
+            g_free(pos);
+        } else {
+            f.key = diff_key(seen, key, name ? name : "");
+        }
+        f.path = g_strdup_printf("%s/%s", path, name ? name : "");
+        f.value = diff_get_string(field, "value");
+        f.parent = parent;
+        g_array_append_val(report->fields, f);
+        g_hash_table_insert(report->keys, f.key,
+                            GINT_TO_POINTER(report->fields->len));
+
+        if ((details = diff_get_list(field, "details")))
+            diff_add_groups(report, seen, details, f.key, f.path,
+                            report->fields->len - 1);
+    }
+}
+
+static void diff_add_groups(DiffReport *report, GHashTable *seen,
+                            JsonArray *groups, const gchar *key,
+                            const gchar *path, gint parent)
+{
+    guint i;
+
+    for (i = 0; i < json_array_get_length(groups); i++) {
+        JsonObject *group = json_array_get_object_element(groups, i);
+        const gchar *name;
+        JsonArray *fields;
+        gchar *group_key, *group_path;
+
+        if (!group || !(fields = diff_get_list(group, "fields")))
+            continue;
+
+        name = diff_get_string(group, "name");
+        if (report->by_position) {
+            gchar *pos = g_strdup_printf("@%u", i);
+
+            group_key = diff_key(seen, key, pos);
+            g_free(pos);
+        } else {
+            group_key = diff_key(seen, key, name ? name : "");
+        }
+        group_path = g_strdup_printf("%s/%s", path, name ? name : "");
+
+        diff_add_fields(report, seen, fields, group_key, group_path, parent);
+
+        g_free(group_key);
+        g_free(group_path);
+    }
+}
+
+/* the id of a module or entry, or its name in reports from before ids */
+static const gchar *diff_get_id(JsonObject *object)
+{
+    const gchar *id = diff_get_string(object, "id");
+
+    if (!id)
+        id = diff_get_string(object, "name");
+    return id ? id : "";
+}
+
+/* modules/entries/groups */
+static void diff_report_load(DiffReport *report)
+{
+    GHashTable *seen;
+    JsonArray *entries, *groups;
+    guint i, j;
+
+    seen = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+    for (i = 0; i < json_array_get_length(report->modules); i++) {
+        JsonObject *module = json_array_get_object_element(report->modules, i);
+        const gchar *module_name;
+
+        if (!module || !(entries = diff_get_list(module, "entries")))
+            continue;
+        module_name = diff_get_string(module, "name");
+
+        for (j = 0; j < json_array_get_length(entries); j++) {
+            JsonObject *entry = json_array_get_object_element(entries, j);
+            const gchar *entry_name;
+            gchar *key, *path;
+
+            if (!entry || !(groups = diff_get_list(entry, "groups")))
+                continue;
+
+            entry_name = diff_get_string(entry, "name");
+            key = g_strdup_printf("%s/%s", diff_get_id(module),
+                                  diff_get_id(entry));
+            path = g_strdup_printf("%s/%s", module_name ? module_name : "",
+                                   entry_name ? entry_name : "");
+            diff_add_groups(report, seen, groups, key, path, -1);
+            g_free(key);
+            g_free(path);
+        }
+    }
+
+    g_hash_table_destroy(seen);
+}
+
+/* from file, or from data if file is NULL */
+static DiffReport *diff_report_new(const gchar *file, const gchar *data)
+{
+    DiffReport *report = g_new0(DiffReport, 1);
+    GError *error = NULL;
+    gboolean loaded;
+
+    report->parser = json_parser_new();
+    report->fields = g_array_new(FALSE, FALSE, sizeof(DiffField));
+    report->keys = g_hash_table_new(g_str_hash, g_str_equal);
+
+    if (file)
+        loaded = json_parser_load_from_file(report->parser, file, &error);
+    else
+        loaded = json_parser_load_from_data(report->parser, data, -1, &error);
+
+    if (!loaded) {
+        g_printerr(_("hardinfo: could not read %s: %s\n"),
+                   file ? file : _("the report"), error->message);
+        g_error_free(error);
+    } else {
+        JsonNode *root = json_parser_get_root(report->parser);
+
+        if (root && JSON_NODE_TYPE(root) == JSON_NODE_OBJECT) {
+            report->modules = diff_get_list(json_node_get_object(root),
+                                            "modules");
+            report->locale = diff_get_string(json_node_get_object(root),
+                                             "locale");
+        }
+        if (!report->modules) {
+            g_printerr(_("hardinfo: %s is not a JSON report (-f json)\n"),
+                       file ? file : _("the report"));
+            loaded = FALSE;
+        }
+    }
+
+    if (!loaded) {
+        g_hash_table_destroy(report->keys);
+        g_array_free(report->fields, TRUE);
+        g_object_unref(report->parser);
+        g_free(report);
+        return NULL;
+    }
+
+    return report;
+}
+
+static void diff_report_free(DiffReport *report)
+{
+    guint i;
+
+    if (!report)
+        return;
+
+    for (i = 0; i < report->fields->len; i++) {
+        DiffField *f = &g_array_index(report->fields, DiffField, i);
+
+        g_free(f->key);
+        g_free(f->path);
+    }
+    g_hash_table_destroy(report->keys);
+    g_array_free(report->fields, TRUE);
+    g_object_unref(report->parser);
+    g_free(report);
+}
+
+static DiffField *diff_report_lookup(DiffReport *report, const gchar *key)
+{
+    gint i = GPOINTER_TO_INT(g_hash_table_lookup(report->keys, key));
+
+    return i ? &g_array_index(report->fields, DiffField, i - 1) : NULL;
+}
+
+/* the details of a field that isn't in the other report aren't listed */
+static gboolean diff_parent_missing(DiffReport *report, DiffField *f,
+                                    DiffReport *other)
+{
+    DiffField *parent;
+
+    if (f->parent < 0)
+        return FALSE;
+    parent = &g_array_index(report->fields, DiffField, f->parent);
+    return !diff_report_lookup(other, parent->key);
+}
+
+static void diff_print_change(JsonBuilder *builder, gchar change,
+                              DiffField *from, DiffField *to)
+{
+    DiffField *f = to ? to : from;
+
+    if (!builder) {
+        switch (change) {
+        case '~':
+            g_print("~ %s: %s -> %s\n", f->path,
+                    from->value ? from->value : "",
+                    to->value ? to->value : "");
+            break;
+        default:
+            g_print("%c %s: %s\n", change, f->path, f->value ? f->value : "");
+        }
+        return;
+    }
+
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "key");
+    json_builder_add_string_value(builder, f->key);
+    json_builder_set_member_name(builder, "path");
+    json_builder_add_string_value(builder, f->path);
+    if (from) {
+        json_builder_set_member_name(builder, change == '~' ? "old" : "value");
+        json_builder_add_string_value(builder, from->value ? from->value : "");
+    }
+    if (to) {
+        json_builder_set_member_name(builder, change == '~' ? "new" : "value");
+        json_builder_add_string_value(builder, to->value ? to->value : "");
+    }
+    json_builder_end_object(builder);
+}
+
+/* one pass over a report: fields of it missing from the other one (added or
+ * removed), or, with changed, those with a different value */
+static gint diff_pass(JsonBuilder *builder, const gchar *member, gchar change,
+                      DiffReport *report, DiffReport *other, gboolean changed)
+{
+    gint n = 0;
+    guint i;
+
+    if (builder) {
+        json_builder_set_member_name(builder, member);
+        json_builder_begin_array(builder);
+    }
+
+    for (i = 0; i < report->fields->len; i++) {
+        DiffField *f = &g_array_index(report->fields, DiffField, i);
+        DiffField *o = diff_report_lookup(other, f->key);
+
+        if (changed) {
+            if (!o || !g_strcmp0(f->value, o->value))
+                continue;
+            diff_print_change(builder, change, o, f);
+        } else {
+            if (o || diff_parent_missing(report, f, other))
+                continue;
+            if (change == '+')
+                diff_print_change(builder, change, NULL, f);
+            else
+                diff_print_change(builder, change, f, NULL);
+        }
+        n++;
+    }
+
+    if (builder)
+        json_builder_end_array(builder);
+
+    return n;
+}
+
+gint report_diff(const gchar *old_file, const gchar *new_file, GSList *modules)
+{
+    DiffReport *old_report, *new_report = NULL;
+    JsonBuilder *builder = NULL;
+    gint n = -1;
+
+    if (!(old_report = diff_report_new(old_file, NULL)))
+        return -1;
+
+    if (new_file) {
+        new_report = diff_report_new(new_file, NULL);
+    } else {
+        gchar *data;
+
+        /* every module is going to be needed */
+        modules_init_all(modules);
+        data = report_create_from_module_list_format(modules,
+                                                     REPORT_FORMAT_JSON);
+        new_report = diff_report_new(NULL, data);
+        g_free(data);
+    }
+    if (!new_report)
+        goto out;
+
+    if (old_report->locale && new_report->locale &&
+        !g_str_equal(old_report->locale, new_report->locale)) {
+        g_printerr(_("hardinfo: the reports are in different languages; "
+                     "groups, and fields without a tag, are matched by "
+                     "position\n"));
+        old_report->by_position = new_report->by_position = TRUE;
+    }
+    diff_report_load(old_report);
+    diff_report_load(new_report);
+
+    if (params.report_format == REPORT_FORMAT_JSON) {
+        builder = json_builder_new();
+        json_builder_begin_object(builder);
+    }
+
+    n = diff_pass(builder, "removed", '-', old_report, new_report, FALSE);
+    n += diff_pass(builder, "added", '+', new_report, old_report, FALSE);
+    n += diff_pass(builder, "changed", '~', new_report, old_report, TRUE);
+
+    if (builder) {
+        JsonGenerator *generator = json_generator_new();
+        JsonNode *root;
+        gchar *json;
+
+        json_builder_end_object(builder);
+        root = json_builder_get_root(builder);
+        json_generator_set_root(generator, root);
+        json_generator_set_pretty(generator, TRUE);
+
+        json = json_generator_to_data(generator, NULL);
+        g_print("%s\n", json);
+
+        g_free(json);
+        json_node_free(root);
+        g_object_unref(generator);
+        g_object_unref(builder);
+    }
+
+out:
+    diff_report_free(old_report);
+    diff_report_free(new_report);
+
+    return n;
+}
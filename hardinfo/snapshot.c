@@ -0,0 +1,532 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * The snapshot is ~/.cache/hardinfo/snapshot.ini: for each entry with
+ * MODULE_FLAG_SNAPSHOT, the key-file data of its last scan, the details of
+ * its tags and the values of its "..." fields, so it can be shown (or put
+ * in a report) without loading its module.
+ *
+ * It is only used if its fingerprint is the one of the running system: a
+ * hash of the boot_id, hardinfo's version and modules, the user, the
+ * language, the mtime of the files telling whether packages, kernel
+ * modules or ids files changed (fingerprint_paths[]), and the devices on
+ * hotpluggable buses (fingerprint_dirs[]).
+ *
+ * A scan only replaces the data; asking the module for the details and
+ * fields, which can be expensive, is left for when they're needed: after
+ * a report has rendered the entry, or when the snapshot is saved. Only
+ * entries collected that way are used: the shell shows them while the
+ * entry is scanned again, and reports trust them, unless --rescan is
+ * given.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "config.h"
+#include "hardinfo.h"
+#include "snapshot.h"
+
+#define SNAPSHOT_GROUP "$Snapshot$"
+
+typedef struct {
+    gchar *data;
+    GHashTable *more_info;      /* tag -> details */
+    GHashTable *fields;         /* key -> value of a "..." field */
+    gboolean collected;         /* more_info and fields are there */
+    ShellModuleEntry *entry;    /* still to be collected from */
+} SnapshotEntry;
+
+static const gchar *fingerprint_paths[] = {
+    "/proc/self/exe",
+    "/etc/os-release",
+    "/var/lib/dpkg/status",
+    "/var/lib/rpm",
+    "/var/lib/pacman/local",
+    "/lib/modules",
+    "/usr/bin",
+    "/usr/local/bin",
+    "/usr/share/hwdata",
+    "/usr/share/misc",
+    NULL
+};
+
+/* their mtimes don't change when something is plugged in; the names of
+ * what's in them do */
+static const gchar *fingerprint_dirs[] = {
+    "/sys/bus/pci/devices",
+    "/sys/bus/usb/devices",
+    NULL
+};
+
+static GMutex snapshot_mutex;
+static GHashTable *snapshot = NULL; /* "<module file>/<entry number>" -> SnapshotEntry */
+static gchar *snapshot_path = NULL;
+static gchar *snapshot_fingerprint = NULL;
+static gboolean snapshot_dirty = FALSE;
+
+static SnapshotEntry *snapshot_entry_new(const gchar *data)
+{
+    SnapshotEntry *se = g_new0(SnapshotEntry, 1);
+
+    se->data = g_strdup(data);
+    se->more_info = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    se->fields = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+
+    return se;
+}
+
+static void snapshot_entry_free(SnapshotEntry *se)
+{
+    g_free(se->data);
+    g_hash_table_destroy(se->more_info);
+    g_hash_table_destroy(se->fields);
+    g_free(se);
+}
+
+static void fingerprint_add_path(GString *fp, const gchar *path)
+{
+    struct stat st;
+
+    if (stat(path, &st) == 0)
+        g_string_append_printf(fp, "%s:%ld.%09ld:%lld\n", path,
+                               (long)st.st_mtim.tv_sec, (long)st.st_mtim.tv_nsec,
+                               (long long)st.st_size);
+    else
+        g_string_append_printf(fp, "%s:-\n", path);
+}
+
+static void fingerprint_add_dir(GString *fp, const gchar *path)
+{
+    GSList *names = NULL, *l;
+    const gchar *name;
+    GDir *dir;
+
+    if ((dir = g_dir_open(path, 0, NULL))) {
+        while ((name = g_dir_read_name(dir)))
+            names = g_slist_prepend(names, g_strdup(name));
+        g_dir_close(dir);
+    }
+    names = g_slist_sort(names, (GCompareFunc)strcmp);
+
+    g_string_append_printf(fp, "%s:", path);
+    for (l = names; l; l = l->next)
+        g_string_append_printf(fp, " %s", (gchar *)l->data);
+    g_string_append_c(fp, '\n');
+    g_slist_free_full(names, g_free);
+}
+
+static gchar *snapshot_compute_fingerprint(void)
+{
+    GString *fp = g_string_new("hardinfo " VERSION "\n");
+    gchar *boot_id = NULL, *dir, *path, *ret;
+    const gchar *name;
+    GDir *gdir;
+    gint i;
+
+    if (!g_file_get_contents("/proc/sys/kernel/random/boot_id", &boot_id,
+                             NULL, NULL))
+        boot_id = g_strdup("?\n");
+    g_string_append_printf(fp, "boot:%s", boot_id);
+    g_free(boot_id);
+
+    g_string_append_printf(fp, "uid:%d lang:%s\n", (int)getuid(),
+                           g_get_language_names()[0]);
+
+    for (i = 0; fingerprint_paths[i]; i++)
+        fingerprint_add_path(fp, fingerprint_paths[i]);
+    for (i = 0; fingerprint_dirs[i]; i++)
+        fingerprint_add_dir(fp, fingerprint_dirs[i]);
+    fingerprint_add_path(fp, params.path_data);
+
+    dir = g_build_filename(params.path_lib, "modules", NULL);
+    if ((gdir = g_dir_open(dir, 0, NULL))) {
+        while ((name = g_dir_read_name(gdir))) {
+            path = g_build_filename(dir, name, NULL);
+            fingerprint_add_path(fp, path);
+            g_free(path);
+        }
+        g_dir_close(gdir);
+    }
+    g_free(dir);
+
+    ret = g_compute_checksum_for_string(G_CHECKSUM_SHA1, fp->str, -1);
+    g_string_free(fp, TRUE);
+
+    return ret;
+}
+
+static gchar *snapshot_key(ShellModuleEntry *entry)
+{
+    gchar *base = g_path_get_basename(g_module_name(entry->module->dll));
+    gchar *key = g_strdup_printf("%s/%d", base, entry->number);
+
+    g_free(base);
+    return key;
+}
+
+static void snapshot_load_table(GKeyFile *key_file, const gchar *group,
+                                const gchar *keys_name, const gchar *values_name,
+                                GHashTable *table)
+{
+    gchar **keys, **values;
+    gint i;
+
+    keys = g_key_file_get_string_list(key_file, group, keys_name, NULL, NULL);
+    values = g_key_file_get_string_list(key_file, group, values_name, NULL, NULL);
+
+    for (i = 0; keys && values && keys[i] && values[i]; i++)
+        g_hash_table_insert(table, g_strdup(keys[i]), g_strdup(values[i]));
+
+    g_strfreev(keys);
+    g_strfreev(values);
+}
+
+void snapshot_init(void)
+{
+    GKeyFile *key_file;
+    gchar **groups, *fingerprint;
+    gint i;
+
+    if (snapshot)
+        return;
+
+    snapshot = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                     (GDestroyNotify)snapshot_entry_free);
+    snapshot_path = g_build_filename(g_get_user_cache_dir(), "hardinfo",
+                                     "snapshot.ini", NULL);
+    snapshot_fingerprint = snapshot_compute_fingerprint();
+
+    key_file = g_key_file_new();
+    if (!g_key_file_load_from_file(key_file, snapshot_path, 0, NULL)) {
+        g_key_file_free(key_file);
+        return;
+    }
+
+    fingerprint = g_key_file_get_string(key_file, SNAPSHOT_GROUP,
+                                        "Fingerprint", NULL);
+    if (g_strcmp0(fingerprint, snapshot_fingerprint)) {
+        DEBUG("snapshot %s is stale", snapshot_path);
+        g_free(fingerprint);
+        g_key_file_free(key_file);
+        return;
+    }
+    g_free(fingerprint);
+
+    groups = g_key_file_get_groups(key_file, NULL);
+    for (i = 0; groups[i]; i++) {
+        SnapshotEntry *se;
+        gchar *data;
+
+        if (g_str_equal(groups[i], SNAPSHOT_GROUP))
+            continue;
+        if (!(data = g_key_file_get_string(key_file, groups[i], "Data", NULL)))
+            continue;
+
+        se = snapshot_entry_new(data);
+        se->collected = TRUE;
+        snapshot_load_table(key_file, groups[i], "MoreInfoTags", "MoreInfo",
+                            se->more_info);
+        snapshot_load_table(key_file, groups[i], "FieldKeys", "Fields",
+                            se->fields);
+        g_hash_table_insert(snapshot, g_strdup(groups[i]), se);
+        g_free(data);
+    }
+    g_strfreev(groups);
+    g_key_file_free(key_file);
+
+    DEBUG("snapshot %s has %d entries", snapshot_path,
+          g_hash_table_size(snapshot));
+}
+
+static void snapshot_save_table(GKeyFile *key_file, const gchar *group,
+                                const gchar *keys_name, const gchar *values_name,
+                                GHashTable *table)
+{
+    GHashTableIter iter;
+    gpointer key, value;
+    const gchar **keys, **values;
+    guint n = 0;
+
+    if (!g_hash_table_size(table))
+        return;
+
+    keys = g_new0(const gchar *, g_hash_table_size(table) + 1);
+    values = g_new0(const gchar *, g_hash_table_size(table) + 1);
+
+    g_hash_table_iter_init(&iter, table);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        keys[n] = key;
+        values[n++] = value;
+    }
+
+    g_key_file_set_string_list(key_file, group, keys_name, keys, n);
+    g_key_file_set_string_list(key_file, group, values_name, values, n);
+
+    g_free(keys);
+    g_free(values);
+}
+
+static void snapshot_collect_all(void)
+{
+    GHashTableIter iter;
+    gpointer value;
+    GSList *entries = NULL, *l;
+
+    g_mutex_lock(&snapshot_mutex);
+    g_hash_table_iter_init(&iter, snapshot);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        SnapshotEntry *se = value;
+
+        if (!se->collected && se->entry)
+            entries = g_slist_prepend(entries, se->entry);
+    }
+    g_mutex_unlock(&snapshot_mutex);
+
+    for (l = entries; l; l = l->next) {
+        module_entry_lock();
+        snapshot_collect(l->data);
+        module_entry_unlock();
+    }
+    g_slist_free(entries);
+}
+
+void snapshot_save(void)
+{
+    GKeyFile *key_file;
+    GHashTableIter iter;
+    gpointer key, value;
+    gchar *data, *dir;
+    gsize len;
+    GError *error = NULL;
+
+    if (!snapshot)
+        return;
+
+    snapshot_collect_all();
+
+    g_mutex_lock(&snapshot_mutex);
+    if (!snapshot_dirty) {
+        g_mutex_unlock(&snapshot_mutex);
+        return;
+    }
+
+    key_file = g_key_file_new();
+    g_key_file_set_string(key_file, SNAPSHOT_GROUP, "Fingerprint",
+                          snapshot_fingerprint);
+
+    g_hash_table_iter_init(&iter, snapshot);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        SnapshotEntry *se = value;
+
+        if (!se->collected)
+            continue;
+        g_key_file_set_string(key_file, key, "Data", se->data);
+        snapshot_save_table(key_file, key, "MoreInfoTags", "MoreInfo",
+                            se->more_info);
+        snapshot_save_table(key_file, key, "FieldKeys", "Fields", se->fields);
+    }
+
+    snapshot_dirty = FALSE;
+    g_mutex_unlock(&snapshot_mutex);
+
+    data = g_key_file_to_data(key_file, &len, NULL);
+    g_key_file_free(key_file);
+
+    dir = g_path_get_dirname(snapshot_path);
+    g_mkdir_with_parents(dir, 0700);
+    g_free(dir);
+
+    if (!g_file_set_contents(snapshot_path, data, len, &error)) {
+        DEBUG("could not save snapshot: %s", error->message);
+        g_error_free(error);
+    }
+    g_free(data);
+}
+
+gboolean snapshot_wants(ShellModuleEntry *entry)
+{
+    return snapshot && entry && (entry->flags & MODULE_FLAG_SNAPSHOT) &&
+           entry->module && entry->module->dll;
+}
+
+gchar *snapshot_get(ShellModuleEntry *entry)
+{
+    SnapshotEntry *se;
+    gchar *key, *data = NULL;
+
+    if (params.rescan || !snapshot_wants(entry))
+        return NULL;
+
+    key = snapshot_key(entry);
+    g_mutex_lock(&snapshot_mutex);
+    if ((se = g_hash_table_lookup(snapshot, key)) && se->collected)
+        data = g_strdup(se->data);
+    g_mutex_unlock(&snapshot_mutex);
+    g_free(key);
+
+    return data;
+}
+
+/* a copy, as a scan can replace the entry at any time */
+static gchar *snapshot_lookup(ShellModuleEntry *entry, gboolean field,
+                              const gchar *what)
+{
+    SnapshotEntry *se;
+    gchar *ret = NULL;
+    gchar *key;
+
+    if (!snapshot_wants(entry) || !what)
+        return NULL;
+
+    key = snapshot_key(entry);
+    g_mutex_lock(&snapshot_mutex);
+    if ((se = g_hash_table_lookup(snapshot, key)) && se->collected)
+        ret = g_strdup(g_hash_table_lookup(field ? se->fields : se->more_info,
+                                           what));
+    g_mutex_unlock(&snapshot_mutex);
+    g_free(key);
+
+    return ret;
+}
+
+gchar *snapshot_get_more_info(ShellModuleEntry *entry, const gchar *tag)
+{
+    return snapshot_lookup(entry, FALSE, tag);
+}
+
+gchar *snapshot_get_field(ShellModuleEntry *entry, const gchar *key)
+{
+    return snapshot_lookup(entry, TRUE, key);
+}
+
+/* asks the module for the details and "..." fields of key_data, the way
+ * the shell and the reports would */
+static void snapshot_entry_collect(SnapshotEntry *se, ShellModuleEntry *entry,
+                                   const gchar *key_data, gboolean details)
+{
+    GKeyFile *key_file = g_key_file_new();
+    gchar **groups, **keys;
+    gint i, j;
+
+    g_key_file_load_from_data(key_file, key_data, strlen(key_data), 0, NULL);
+    groups = g_key_file_get_groups(key_file, NULL);
+
+    for (i = 0; groups[i]; i++) {
+        if (groups[i][0] == '$')
+            continue;
+
+        keys = g_key_file_get_keys(key_file, groups[i], NULL, NULL);
+        for (j = 0; keys && keys[j]; j++) {
+            gchar *value = g_key_file_get_value(key_file, groups[i], keys[j], NULL);
+            gchar *tag;
+
+            strend(keys[j], '#');
+
+            if (entry->fieldfunc && value && g_str_equal(value, "...") &&
+                !g_hash_table_contains(se->fields, keys[j])) {
+                gchar *field = entry->fieldfunc(keys[j]);
+
+                if (field)
+                    g_hash_table_insert(se->fields, g_strdup(keys[j]), field);
+            }
+
+            if (details && entry->morefunc && key_is_flagged(keys[j]) &&
+                (tag = key_mi_tag(keys[j]))) {
+                const gchar *more = entry->morefunc(tag);
+
+                if (more && !g_hash_table_contains(se->more_info, tag)) {
+                    g_hash_table_insert(se->more_info, tag, g_strdup(more));
+                    /* the details may have "..." fields of their own */
+                    snapshot_entry_collect(se, entry, more, FALSE);
+                } else {
+                    g_free(tag);
+                }
+            }
+
+            g_free(value);
+        }
+        g_strfreev(keys);
+    }
+
+    g_strfreev(groups);
+    g_key_file_free(key_file);
+}
+
+void snapshot_update(ShellModuleEntry *entry, const gchar *key_data)
+{
+    SnapshotEntry *se;
+    gchar *key;
+
+    if (!snapshot_wants(entry) || !key_data)
+        return;
+
+    key = snapshot_key(entry);
+    g_mutex_lock(&snapshot_mutex);
+    se = g_hash_table_lookup(snapshot, key);
+    if (!se || !g_str_equal(se->data, key_data)) {
+        se = snapshot_entry_new(key_data);
+        se->entry = entry;
+        g_hash_table_insert(snapshot, key, se);
+        snapshot_dirty = TRUE;
+    } else {
+        g_free(key);
+    }
+    g_mutex_unlock(&snapshot_mutex);
+}
+
+void snapshot_collect(ShellModuleEntry *entry)
+{
+    SnapshotEntry *se, *collected;
+    gchar *key, *data = NULL;
+
+    if (!snapshot_wants(entry))
+        return;
+
+    key = snapshot_key(entry);
+    g_mutex_lock(&snapshot_mutex);
+    if ((se = g_hash_table_lookup(snapshot, key)) && !se->collected)
+        data = g_strdup(se->data);
+    g_mutex_unlock(&snapshot_mutex);
+    if (!data) {
+        g_free(key);
+        return;
+    }
+
+    collected = snapshot_entry_new(data);
+    snapshot_entry_collect(collected, entry, data, TRUE);
+    collected->collected = TRUE;
+
+    /* unless it was scanned again meanwhile */
+    g_mutex_lock(&snapshot_mutex);
+    se = g_hash_table_lookup(snapshot, key);
+    if (se && !se->collected && g_str_equal(se->data, data)) {
+        g_hash_table_insert(snapshot, key, collected);
+        snapshot_dirty = TRUE;
+        key = NULL;
+        collected = NULL;
+    }
+    g_mutex_unlock(&snapshot_mutex);
+
+    if (collected)
+        snapshot_entry_free(collected);
+    g_free(key);
+    g_free(data);
+}
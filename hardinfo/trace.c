@@ -0,0 +1,175 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <stdarg.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <json-glib/json-glib.h>
+
+#include "hardinfo.h"
+#include "trace.h"
+#include "util_ids.h"
+
+/* "complete" events (ph X): a name, a start and a duration */
+typedef struct {
+    gchar *name;
+    const gchar *category;
+    gint64 ts, dur;             /* us */
+    gint tid;
+} TraceEvent;
+
+static gchar *trace_path = NULL;
+static GArray *trace_events = NULL;
+static GMutex trace_mutex;
+static gint64 trace_epoch;
+
+gint64 trace_begin(void)
+{
+    return trace_path ? g_get_monotonic_time() : 0;
+}
+
+void trace_end(gint64 start, const gchar *category, const gchar *fmt, ...)
+{
+    TraceEvent ev;
+    va_list args;
+
+    if (!start)
+        return;
+
+    ev.dur = g_get_monotonic_time() - start;
+    ev.ts = start - trace_epoch;
+    ev.category = category;
+    ev.tid = (gint)syscall(SYS_gettid);
+
+    va_start(args, fmt);
+    ev.name = g_strdup_vprintf(fmt, args);
+    va_end(args);
+
+    g_mutex_lock(&trace_mutex);
+    g_array_append_val(trace_events, ev);
+    g_mutex_unlock(&trace_mutex);
+}
+
+static void trace_ids(gint64 start, const gchar *file, const gchar *qpath)
+{
+    gchar *base = g_path_get_basename(file);
+
+    trace_end(start, "ids", "%s %s", base, qpath);
+    g_free(base);
+}
+
+static void trace_add_metadata(JsonBuilder *builder, const gchar *what,
+                               gint tid, const gchar *name)
+{
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "name");
+    json_builder_add_string_value(builder, what);
+    json_builder_set_member_name(builder, "ph");
+    json_builder_add_string_value(builder, "M");
+    json_builder_set_member_name(builder, "pid");
+    json_builder_add_int_value(builder, getpid());
+    json_builder_set_member_name(builder, "tid");
+    json_builder_add_int_value(builder, tid);
+    json_builder_set_member_name(builder, "args");
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "name");
+    json_builder_add_string_value(builder, name);
+    json_builder_end_object(builder);
+    json_builder_end_object(builder);
+}
+
+static void trace_write(void)
+{
+    JsonBuilder *builder;
+    JsonGenerator *generator;
+    JsonNode *root;
+    GError *error = NULL;
+    guint i;
+
+    ids_set_timing_func(NULL);
+
+    g_mutex_lock(&trace_mutex);
+
+    builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "displayTimeUnit");
+    json_builder_add_string_value(builder, "ms");
+    json_builder_set_member_name(builder, "traceEvents");
+    json_builder_begin_array(builder);
+
+    trace_add_metadata(builder, "process_name", getpid(), "hardinfo");
+    trace_add_metadata(builder, "thread_name", getpid(), "main");
+
+    for (i = 0; i < trace_events->len; i++) {
+        TraceEvent *ev = &g_array_index(trace_events, TraceEvent, i);
+
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "name");
+        json_builder_add_string_value(builder, ev->name);
+        json_builder_set_member_name(builder, "cat");
+        json_builder_add_string_value(builder, ev->category);
+        json_builder_set_member_name(builder, "ph");
+        json_builder_add_string_value(builder, "X");
+        json_builder_set_member_name(builder, "ts");
+        json_builder_add_int_value(builder, ev->ts);
+        json_builder_set_member_name(builder, "dur");
+        json_builder_add_int_value(builder, ev->dur);
+        json_builder_set_member_name(builder, "pid");
+        json_builder_add_int_value(builder, getpid());
+        json_builder_set_member_name(builder, "tid");
+        json_builder_add_int_value(builder, ev->tid);
+        json_builder_end_object(builder);
+
+        g_free(ev->name);
+    }
+    g_array_set_size(trace_events, 0);
+
+    json_builder_end_array(builder);
+    json_builder_end_object(builder);
+
+    g_mutex_unlock(&trace_mutex);
+
+    root = json_builder_get_root(builder);
+    generator = json_generator_new();
+    json_generator_set_root(generator, root);
+
+    if (!json_generator_to_file(generator, trace_path, &error)) {
+        g_printerr("hardinfo: could not write trace to %s: %s\n", trace_path,
+                   error->message);
+        g_error_free(error);
+    }
+
+    json_node_free(root);
+    g_object_unref(generator);
+    g_object_unref(builder);
+}
+
+void trace_init(const gchar *path)
+{
+    if (!path || trace_path)
+        return;
+
+    trace_path = g_strdup(path);
+    trace_events = g_array_new(FALSE, FALSE, sizeof(TraceEvent));
+    trace_epoch = g_get_monotonic_time();
+
+    ids_set_timing_func(trace_ids);
+
+    /* whichever way hardinfo ends */
+    atexit(trace_write);
+}
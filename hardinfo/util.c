@@ -17,7 +17,7 @@
  */
 
 /*
- * Functions h_strdup_cprintf and h_strconcat are based on GLib version 2.4.6
+ * Function h_strconcat is based on GLib version 2.4.6
  * Copyright (C) 1995-1997  Peter Mattis, Spencer Kimball and Josh MacDonald
  *
  * This library is free software; you can redistribute it and/or
@@ -37,6 +37,8 @@
 #include <gtk/gtk.h>
 
 #include <binreloc.h>
+#include <cpu_util.h>
+#include <trace.h>
 
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -56,16 +58,21 @@ gchar *find_program(gchar *program_name)
     int i;
     char *temp;
     static GHashTable *cache = NULL;
+    static GMutex cache_mutex;
     const char *path[] = { "/usr/local/bin", "/usr/local/sbin",
 		                   "/usr/bin", "/usr/sbin",
 		                   "/bin", "/sbin",
 		                   NULL };
 
-    /* we don't need to call stat() every time: cache the results */
+    /* we don't need to call stat() every time: cache the results;
+     * reports call this from several threads */
+    g_mutex_lock(&cache_mutex);
     if (!cache) {
     	cache = g_hash_table_new(g_str_hash, g_str_equal);
     } else if ((temp = g_hash_table_lookup(cache, program_name))) {
-    	return g_strdup(temp);
+    	temp = g_strdup(temp);
+    	g_mutex_unlock(&cache_mutex);
+    	return temp;
     }
 
     for (i = 0; path[i]; i++) {
@@ -73,6 +80,7 @@ gchar *find_program(gchar *program_name)
 
     	if (g_file_test(temp, G_FILE_TEST_IS_EXECUTABLE)) {
     		g_hash_table_insert(cache, program_name, g_strdup(temp));
+		g_mutex_unlock(&cache_mutex);
 		return temp;
     	}
 
@@ -80,12 +88,11 @@ gchar *find_program(gchar *program_name)
     }
 
     /* our search has failed; use GLib's search (which uses $PATH env var) */
-    if ((temp = g_find_program_in_path(program_name))) {
+    if ((temp = g_find_program_in_path(program_name)))
     	g_hash_table_insert(cache, program_name, g_strdup(temp));
-    	return temp;
-    }
+    g_mutex_unlock(&cache_mutex);
 
-    return NULL;
+    return temp;
 }
 
 gchar *seconds_to_string(unsigned int seconds)
@@ -397,6 +404,22 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
     static gchar *bench_user_note = NULL;
     static gchar **use_modules = NULL;
     static gint max_bench_results = 10;
+    static gint bench_timeout = 0;
+    static gboolean bench_isolate = FALSE;
+    static gboolean bench_child = FALSE;
+    static gchar *bench_filter = NULL;
+    static gchar *bench_reference = NULL;
+    static gchar *compare_benchmarks = NULL;
+    static gdouble compare_threshold = 5.0;
+    static gint bench_repeat = 3;
+    static gboolean bench_controlled = FALSE;
+    static gboolean bench_no_turbo = FALSE;
+    static gdouble bench_max_load = -1.0;
+    static gboolean bench_latency = FALSE;
+    static gchar *trace_file = NULL;
+    static gboolean rescan = FALSE;
+    static gboolean diff = FALSE;
+    static gchar **query = NULL;
 
     static GOptionEntry options[] = {
 	{
@@ -416,13 +439,13 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
 	 .short_name = 'f',
 	 .arg = G_OPTION_ARG_STRING,
 	 .arg_data = &report_format,
-	 .description = N_("chooses a report format ([text], html)")},
+	 .description = N_("chooses a report format ([text], html, shell, json)")},
 	{
 	 .long_name = "run-benchmark",
 	 .short_name = 'b',
 	 .arg = G_OPTION_ARG_STRING,
 	 .arg_data = &run_benchmark,
-	 .description = N_("run benchmark; requires benchmark.so to be loaded")},
+	 .description = N_("run benchmark (a name, a comma-separated list or \"all\"); requires benchmark.so to be loaded")},
 	{
 	 .long_name = "user-note",
 	 .short_name = 'u',
@@ -441,6 +464,98 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
 	 .arg = G_OPTION_ARG_INT,
 	 .arg_data = &max_bench_results,
 	 .description = N_("maximum number of benchmark results to include (-1 for no limit, default is 10)")},
+	{
+	 .long_name = "bench-timeout",
+	 .short_name = 'T',
+	 .arg = G_OPTION_ARG_INT,
+	 .arg_data = &bench_timeout,
+	 .description = N_("abort each benchmark after this many seconds (implies --bench-isolate)")},
+	{
+	 .long_name = "bench-isolate",
+	 .short_name = 'I',
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_isolate,
+	 .description = N_("run each benchmark in a separate process")},
+	{
+	 .long_name = "bench-child",
+	 .flags = G_OPTION_FLAG_HIDDEN,
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_child,
+	 .description = "used by --bench-isolate"},
+	{
+	 .long_name = "bench-filter",
+	 .short_name = 'F',
+	 .arg = G_OPTION_ARG_STRING,
+	 .arg_data = &bench_filter,
+	 .description = N_("only compare with results matching a filter (vendor=X,cores=N,memory=X)")},
+	{
+	 .long_name = "bench-reference",
+	 .short_name = 'R',
+	 .arg = G_OPTION_ARG_STRING,
+	 .arg_data = &bench_reference,
+	 .description = N_("machine id or CPU name the composite score is normalized to")},
+	{
+	 .long_name = "compare-benchmarks",
+	 .short_name = 'C',
+	 .arg = G_OPTION_ARG_FILENAME,
+	 .arg_data = &compare_benchmarks,
+	 .description = N_("run the benchmarks in a saved result file and compare with it")},
+	{
+	 .long_name = "compare-threshold",
+	 .short_name = 't',
+	 .arg = G_OPTION_ARG_DOUBLE,
+	 .arg_data = &compare_threshold,
+	 .description = N_("percent change counted as a regression (default is 5)")},
+	{
+	 .long_name = "bench-repeat",
+	 .short_name = 'p',
+	 .arg = G_OPTION_ARG_INT,
+	 .arg_data = &bench_repeat,
+	 .description = N_("times to run each benchmark when comparing (default is 3)")},
+	{
+	 .long_name = "bench-controlled",
+	 .short_name = 'c',
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_controlled,
+	 .description = N_("pin the CPU governor, lock memory and check the load before each benchmark")},
+	{
+	 .long_name = "bench-no-turbo",
+	 .short_name = 'N',
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_no_turbo,
+	 .description = N_("also disable turbo/boost during controlled runs")},
+	{
+	 .long_name = "bench-max-load",
+	 .short_name = 'L',
+	 .arg = G_OPTION_ARG_DOUBLE,
+	 .arg_data = &bench_max_load,
+	 .description = N_("do not start a controlled run above this load average (0 for no limit, default is the number of usable CPUs)")},
+	{
+	 .long_name = "bench-latency",
+	 .short_name = 'H',
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_latency,
+	 .description = N_("time each work unit and record latency percentiles")},
+	{
+	 .long_name = "trace",
+	 .arg = G_OPTION_ARG_FILENAME,
+	 .arg_data = &trace_file,
+	 .description = N_("record module loading, scans and probes to a Chrome trace-event JSON file")},
+	{
+	 .long_name = "query",
+	 .arg = G_OPTION_ARG_STRING_ARRAY,
+	 .arg_data = &query,
+	 .description = N_("prints only the fields matching module/entry/group/field globs, e.g. devices/sensors/*/temp* (can be used multiple times)")},
+	{
+	 .long_name = "diff",
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &diff,
+	 .description = N_("compares JSON reports: --diff OLD [NEW], against this machine without NEW")},
+	{
+	 .long_name = "rescan",
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &rescan,
+	 .description = N_("scan everything again instead of using the snapshot in the cache dir")},
 	{
 	 .long_name = "list-modules",
 	 .short_name = 'l',
@@ -498,7 +613,17 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
 
     g_option_context_free(ctx);
 
-    if (*argc >= 2) {
+    if (diff && (*argc < 2 || *argc > 3)) {
+	g_print(_("--diff takes one or two reports.\n"
+		"Try ``%s --help'' for more information.\n"), *(argv)[0]);
+	exit(1);
+    }
+
+    if (diff) {
+	param->diff_files = g_new0(gchar *, 3);
+	param->diff_files[0] = g_strdup((*argv)[1]);
+	param->diff_files[1] = g_strdup((*argv)[2]);
+    } else if (*argc >= 2) {
 	g_print(_("Unrecognized arguments.\n"
 		"Try ``%s --help'' for more information.\n"), *(argv)[0]);
 	exit(1);
@@ -512,6 +637,21 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
     param->run_benchmark = run_benchmark;
     param->result_format = result_format;
     param->max_bench_results = max_bench_results;
+    param->bench_timeout = MAX(bench_timeout, 0);
+    param->bench_isolate = bench_isolate || bench_timeout > 0;
+    param->bench_child = bench_child;
+    param->bench_filter = bench_filter;
+    param->bench_reference = bench_reference;
+    param->compare_benchmarks = compare_benchmarks;
+    param->compare_threshold = compare_threshold;
+    param->bench_repeat = MAX(bench_repeat, 1);
+    param->bench_controlled = bench_controlled || bench_no_turbo;
+    param->bench_no_turbo = bench_no_turbo;
+    param->bench_max_load = bench_max_load;
+    param->bench_latency = bench_latency;
+    param->trace_file = trace_file;
+    param->rescan = rescan;
+    param->query = query;
     param->autoload_deps = autoload_deps;
     param->run_xmlrpc_server = run_xmlrpc_server;
     param->skip_benchmarks = skip_benchmarks;
@@ -524,6 +664,8 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
             param->report_format = REPORT_FORMAT_HTML;
         if (g_str_equal(report_format, "shell"))
             param->report_format = REPORT_FORMAT_SHELL;
+        if (g_str_equal(report_format, "json"))
+            param->report_format = REPORT_FORMAT_JSON;
     }
 
     /* clean user note */
@@ -587,7 +729,106 @@ gchar *strreplace(gchar *string, gchar *replace, gchar *replacement)
     return ret;
 }
 
+/* hi_module_init() isn't called when a module is loaded, but the first
+ * time anything of it is needed: module_init_wait() is called before every
+ * call into a module, so modules the user never looks at aren't initialized
+ * at all. modules_init_all() initializes every module on a thread pool, for
+ * when all of them are going to be needed anyway.
+ *
+ * A module is initialized after the ones it depends on (its init_deps,
+ * from hi_module_get_dependencies(), with circular dependencies broken),
+ * so modules not depending on each other are initialized in parallel. */
+enum {
+    MODULE_INIT_NONE,
+    MODULE_INIT_RUNNING,
+    MODULE_INIT_DONE,
+};
+
+static GMutex module_init_mutex;
+static GCond module_init_cond;
+
+void module_init_wait(ShellModule * module)
+{
+    GSList *dep;
+
+    if (!module || g_atomic_int_get(&module->init_state) == MODULE_INIT_DONE)
+	return;
+
+    g_mutex_lock(&module_init_mutex);
+    if (module->init_state == MODULE_INIT_NONE) {
+	/* this thread does it */
+	module->init_state = MODULE_INIT_RUNNING;
+	g_mutex_unlock(&module_init_mutex);
+
+	for (dep = module->init_deps; dep; dep = dep->next)
+	    module_init_wait((ShellModule *) dep->data);
+
+	if (module->initfunc) {
+	    gint64 start = trace_begin();
+
+	    DEBUG("initializing module ``%s''", module->name);
+	    module->initfunc();
+	    trace_end(start, "init", "hi_module_init %s", module->name);
+	}
+
+	g_mutex_lock(&module_init_mutex);
+	g_atomic_int_set(&module->init_state, MODULE_INIT_DONE);
+	g_cond_broadcast(&module_init_cond);
+    } else {
+	while (module->init_state != MODULE_INIT_DONE)
+	    g_cond_wait(&module_init_cond, &module_init_mutex);
+    }
+    g_mutex_unlock(&module_init_mutex);
+}
+
+/* waits for an initialization in progress; TRUE if the module was
+ * initialized */
+static gboolean module_init_finish(ShellModule * module)
+{
+    gboolean initialized;
+
+    g_mutex_lock(&module_init_mutex);
+    while (module->init_state == MODULE_INIT_RUNNING)
+	g_cond_wait(&module_init_cond, &module_init_mutex);
+    initialized = module->init_state == MODULE_INIT_DONE;
+    g_mutex_unlock(&module_init_mutex);
+
+    return initialized;
+}
+
+static void module_init_worker(gpointer data, gpointer user_data)
+{
+    module_init_wait((ShellModule *) data);
+    free_auto_free_thread_final();
+}
+
+void modules_init_all(GSList * modules)
+{
+    GThreadPool *pool;
+    cpu_limits lim;
+
+    if (!modules)
+	return;
+
+    cpu_limits_get(&lim);
+    pool = g_thread_pool_new(module_init_worker, NULL,
+			     CLAMP(lim.effective, 1, (gint) g_slist_length(modules)),
+			     TRUE, NULL);
+    if (!pool) {
+	for (; modules; modules = modules->next)
+	    module_init_wait((ShellModule *) modules->data);
+	return;
+    }
+
+    for (; modules; modules = modules->next)
+	g_thread_pool_push(pool, modules->data, NULL);
+
+    /* waits for all of them */
+    g_thread_pool_free(pool, FALSE, TRUE);
+}
+
 static GHashTable *__module_methods = NULL;
+static GHashTable *__module_methods_owner = NULL;	/* method name -> ShellModule */
 
 static void module_register_methods(ShellModule * module)
 {
@@ -596,6 +837,7 @@ static void module_register_methods(ShellModule * module)
 
     if (__module_methods == NULL) {
 	__module_methods = g_hash_table_new(g_str_hash, g_str_equal);
+	__module_methods_owner = g_hash_table_new(g_str_hash, g_str_equal);
     }
 
     if (g_module_symbol
@@ -612,6 +854,7 @@ static void module_register_methods(ShellModule * module)
 	    method_name = g_strdup_printf("%s::%s", simple_name, method.name);
 	    g_hash_table_insert(__module_methods, method_name,
 				method.function);
+	    g_hash_table_insert(__module_methods_owner, method_name, module);
 	    g_free(name);
 	    g_free(simple_name);
 	}
@@ -622,26 +865,44 @@ static void module_register_methods(ShellModule * module)
 gchar *module_call_method(gchar * method)
 {
     gchar *(*function) (void);
+    gchar *ret;
 
     if (__module_methods == NULL) {
 	return NULL;
     }
 
     function = g_hash_table_lookup(__module_methods, method);
-    return function ? g_strdup(function()) : NULL;
+    if (!function)
+        return NULL;
+
+    module_init_wait(g_hash_table_lookup(__module_methods_owner, method));
+    module_entry_lock();
+    ret = g_strdup(function());
+    module_entry_unlock();
+
+    return ret;
 }
 
 /* FIXME: varargs? */
 gchar *module_call_method_param(gchar * method, gchar * parameter)
 {
     gchar *(*function) (gchar *param);
+    gchar *ret;
 
     if (__module_methods == NULL) {
 	return NULL;
     }
 
     function = g_hash_table_lookup(__module_methods, method);
-    return function ? g_strdup(function(parameter)) : NULL;
+    if (!function)
+        return NULL;
+
+    module_init_wait(g_hash_table_lookup(__module_methods_owner, method));
+    module_entry_lock();
+    ret = g_strdup(function(parameter));
+    module_entry_unlock();
+
+    return ret;
 }
 
 static gboolean remove_module_methods(gpointer key, gpointer value, gpointer data)
@@ -656,7 +917,7 @@ static void module_unload(ShellModule * module)
     if (module->dll) {
         gchar *name;
 
-        if (module->deinit) {
+        if (module->deinit && module_init_finish(module)) {
         	DEBUG("cleaning up module \"%s\"", module->name);
 		module->deinit();
 	} else {
@@ -665,22 +926,30 @@ static void module_unload(ShellModule * module)
 
         name = g_path_get_basename(g_module_name(module->dll));
         g_hash_table_foreach_remove(__module_methods, remove_module_methods, name);
+        g_hash_table_foreach_remove(__module_methods_owner, remove_module_methods, name);
 
     	g_module_close(module->dll);
     	g_free(name);
     }
 
     g_free(module->name);
+    g_free(module->id);
     g_object_unref(module->icon);
 
     for (entry = module->entries; entry; entry = entry->next) {
 	ShellModuleEntry *e = (ShellModuleEntry *)entry->data;
 
 	g_source_remove_by_user_data(e);
+	g_free(e->scan_data);
+	info_free(e->scan_info);
+	g_free(e->id);
     	g_free(e);
     }
 
     g_slist_free(module->entries);
+    g_slist_free(module->init_deps);
+    if (module->lock_group == module)
+	g_rec_mutex_clear(&module->lock);
     g_free(module);
 }
 
@@ -714,12 +983,33 @@ void module_unload_all(void)
     shell->selected = NULL;
 }
 
+/* "PCI Devices" is "pci-devices": entries are known by these where the
+ * locale shouldn't matter, as in JSON reports and queries */
+static gchar *module_entry_id(const gchar *name)
+{
+    GString *id = g_string_new(NULL);
+    const gchar *p;
+
+    for (p = name; *p; p++) {
+	if (g_ascii_isalnum(*p))
+	    g_string_append_c(id, g_ascii_tolower(*p));
+	else if (id->len && id->str[id->len - 1] != '-')
+	    g_string_append_c(id, '-');
+    }
+    if (id->len && id->str[id->len - 1] == '-')
+	g_string_truncate(id, id->len - 1);
+
+    return g_string_free(id, FALSE);
+}
+
 static ShellModule *module_load(gchar * filename)
 {
     ShellModule *module;
     gchar *tmp;
+    gint64 start = trace_begin();
 
     module = g_new0(ShellModule, 1);
+    module->id = g_strndup(filename, strcspn(filename, "."));
 
     if (params.gui_running) {
 	gchar *tmpicon, *dot, *simple_name;
@@ -745,7 +1035,6 @@ static ShellModule *module_load(gchar * filename)
     g_free(tmp);
 
     if (module->dll) {
-	void (*init) (void);
 	ModuleEntry *(*get_module_entries) (void);
 	gint(*weight_func) (void);
 	gchar *(*name_func) (void);
@@ -758,10 +1047,9 @@ static ShellModule *module_load(gchar * filename)
 	    goto failed;
 	}
 
-	if (g_module_symbol(module->dll, "hi_module_init", (gpointer) & init)) {
-	    DEBUG("initializing module ``%s''", filename);
-	    init();
-	}
+	/* called by module_init_wait() */
+	g_module_symbol(module->dll, "hi_module_init",
+			(gpointer) & (module->initfunc));
 
 	g_module_symbol(module->dll, "hi_module_get_weight",
 			(gpointer) & weight_func);
@@ -791,12 +1079,17 @@ static ShellModule *module_load(gchar * filename)
 			    (gpointer) & (entry->morefunc));
 	    g_module_symbol(module->dll, "hi_get_field",
 			    (gpointer) & (entry->fieldfunc));
+	    g_module_symbol(module->dll, "hi_get_fields",
+			    (gpointer) & (entry->fieldsfunc));
 	    g_module_symbol(module->dll, "hi_note_func",
 			    (gpointer) & (entry->notefunc));
 
+	    entry->module = module;
 	    entry->name = _(entries[i].name); //gettext unname N_() in computer.c line 67 etc...
+	    entry->id = module_entry_id(entries[i].name);
 	    entry->scan_func = entries[i].scan_callback;
 	    entry->func = entries[i].callback;
+	    entry->infofunc = entries[i].info_callback;
 	    entry->number = i;
 	    entry->flags = entries[i].flags;
 
@@ -813,10 +1106,13 @@ static ShellModule *module_load(gchar * filename)
 	DEBUG("loading module %s failed: %s", filename, g_module_error());
 
 	g_free(module->name);
+	g_free(module->id);
 	g_free(module);
 	module = NULL;
     }
 
+    trace_end(start, "module", "load %s", filename);
+
     return module;
 }
 
@@ -946,6 +1242,111 @@ static GSList *modules_check_deps(GSList * modules)
 }
 
 
+static ShellModule *module_find(GSList * modules, const gchar * filename)
+{
+    for (; modules; modules = modules->next) {
+	ShellModule *m = (ShellModule *) modules->data;
+	gchar *name = g_path_get_basename(g_module_name(m->dll));
+	gboolean found = g_str_equal(name, filename);
+
+	g_free(name);
+	if (found)
+	    return m;
+    }
+
+    return NULL;
+}
+
+/* depth-first; a dependency still being visited is circular, and is left
+ * out of init_deps so module_init_wait() can't deadlock */
+static void modules_set_init_deps_visit(GSList * modules, ShellModule * module,
+					GHashTable * visited)
+{
+    gchar **(*get_deps) (void);
+    gchar **deps;
+    gint i;
+
+    g_hash_table_insert(visited, module, GINT_TO_POINTER(MODULE_INIT_RUNNING));
+
+    if (g_module_symbol(module->dll, "hi_module_get_dependencies",
+			(gpointer) & get_deps)) {
+	for (i = 0, deps = get_deps(); deps[i]; i++) {
+	    ShellModule *dep = module_find(modules, deps[i]);
+
+	    if (!dep)
+		continue;
+
+	    switch (GPOINTER_TO_INT(g_hash_table_lookup(visited, dep))) {
+	    case MODULE_INIT_NONE:
+		modules_set_init_deps_visit(modules, dep, visited);
+		/* fall through */
+	    case MODULE_INIT_DONE:
+		module->init_deps = g_slist_append(module->init_deps, dep);
+		break;
+	    case MODULE_INIT_RUNNING:
+		DEBUG("circular dependency: %s <-> %s", module->name, dep->name);
+		break;
+	    }
+	}
+    }
+
+    g_hash_table_insert(visited, module, GINT_TO_POINTER(MODULE_INIT_DONE));
+}
+
+static ShellModule *module_lock_group_find(ShellModule * module)
+{
+    while (module->lock_group != module)
+	module = module->lock_group;
+
+    return module;
+}
+
+/* modules connected by dependencies, either way, share a lock group; the
+ * first module of each group holds its lock */
+static void modules_set_lock_groups(GSList * modules)
+{
+    GSList *l, *dep;
+
+    for (l = modules; l; l = l->next) {
+	ShellModule *module = (ShellModule *) l->data;
+
+	module->lock_group = module;
+    }
+
+    for (l = modules; l; l = l->next) {
+	ShellModule *module = (ShellModule *) l->data;
+
+	for (dep = module->init_deps; dep; dep = dep->next) {
+	    ShellModule *a = module_lock_group_find(module);
+	    ShellModule *b = module_lock_group_find((ShellModule *) dep->data);
+
+	    if (a != b)
+		b->lock_group = a;
+	}
+    }
+
+    for (l = modules; l; l = l->next) {
+	ShellModule *module = (ShellModule *) l->data;
+
+	module->lock_group = module_lock_group_find(module);
+	if (module->lock_group == module)
+	    g_rec_mutex_init(&module->lock);
+    }
+}
+
+static void modules_set_init_deps(GSList * modules)
+{
+    GHashTable *visited = g_hash_table_new(g_direct_hash, g_direct_equal);
+    GSList *l;
+
+    for (l = modules; l; l = l->next) {
+	if (!g_hash_table_lookup(visited, l->data))
+	    modules_set_init_deps_visit(modules, (ShellModule *) l->data, visited);
+    }
+
+    g_hash_table_destroy(visited);
+}
+
 GSList *modules_get_list()
 {
     return modules_list;
@@ -990,6 +1391,9 @@ static GSList *modules_load(gchar ** module_list)
     }
 
     modules_list = g_slist_sort(modules, module_cmp);
+    modules_set_init_deps(modules_list);
+    modules_set_lock_groups(modules_list);
+
     return modules_list;
 }
 
@@ -1043,7 +1447,10 @@ void module_entry_scan_all_except(ModuleEntry * entries, gint except_entry)
 	g_free(text);
 
 	if ((scan_callback = entry.scan_callback)) {
+	    gint64 start = trace_begin();
+
 	    scan_callback(FALSE);
+	    trace_end(start, "scan", "scan %s", entry.name);
 	}
     }
 
@@ -1056,75 +1463,163 @@ void module_entry_scan_all(ModuleEntry * entries)
     module_entry_scan_all_except(entries, -1);
 }
 
-void module_entry_reload(ShellModuleEntry * module_entry)
+/* Module code was written to be called from a single thread; the shell may
+ * run scans on a worker thread (see shell/shell.c), so every call into a
+ * module entry holds this lock. It is recursive as scans call methods of
+ * other modules.
+ *
+ * Modules only call methods of the modules they depend on, so modules that
+ * aren't connected by dependencies (see modules_set_lock_groups()) don't
+ * share anything but the thread-safe parts of hardinfo: a thread that
+ * called module_entry_lock_group() takes the lock of that module's group
+ * instead, and can run at the same time as threads of other groups. Only
+ * reports do that (see shell/report.c), as the shell takes the global
+ * lock. */
+static GRecMutex module_entry_mutex;
+static GPrivate module_entry_group = G_PRIVATE_INIT(NULL);
+
+static GRecMutex *module_entry_mutex_get(void)
+{
+    ShellModule *group = g_private_get(&module_entry_group);
+
+    return group ? &group->lock : &module_entry_mutex;
+}
+
+void module_entry_lock(void)
+{
+    g_rec_mutex_lock(module_entry_mutex_get());
+}
+
+gboolean module_entry_trylock(void)
 {
+    return g_rec_mutex_trylock(module_entry_mutex_get());
+}
+
+void module_entry_unlock(void)
+{
+    g_rec_mutex_unlock(module_entry_mutex_get());
+}
+
+/* the calling thread takes the lock of module's group from now on; NULL
+ * goes back to the global one */
+void module_entry_lock_group(ShellModule * module)
+{
+    g_private_set(&module_entry_group, module ? module->lock_group : NULL);
+}
 
+void module_entry_reload(ShellModuleEntry * module_entry)
+{
+    module_init_wait(module_entry->module);
     if (module_entry->scan_func) {
+	gint64 start;
+
+	module_entry_lock();
+	start = trace_begin();
 	module_entry->scan_func(TRUE);
+	trace_end(start, "scan", "scan %s (reload)", module_entry->name);
+	module_entry_unlock();
     }
 }
 
 void module_entry_scan(ShellModuleEntry * module_entry)
 {
+    module_init_wait(module_entry->module);
     if (module_entry->scan_func) {
+	gint64 start;
+
+	module_entry_lock();
+	start = trace_begin();
 	module_entry->scan_func(FALSE);
+	trace_end(start, "scan", "scan %s", module_entry->name);
+	module_entry_unlock();
     }
 }
 
 gchar *module_entry_get_field(ShellModuleEntry * module_entry, gchar * field)
 {
+   gchar *value = NULL;
+
+   module_init_wait(module_entry->module);
    if (module_entry->fieldfunc) {
-   	return module_entry->fieldfunc(field);
+	module_entry_lock();
+	value = module_entry->fieldfunc(field);
+	module_entry_unlock();
    }
 
-   return NULL;
+   return value;
 }
 
 gchar *module_entry_function(ShellModuleEntry * module_entry)
 {
+    gchar *data = NULL;
+
+    module_init_wait(module_entry->module);
     if (module_entry->func) {
-	return module_entry->func();
+	gint64 start;
+
+	module_entry_lock();
+	start = trace_begin();
+	data = module_entry->func();
+	trace_end(start, "callback", "%s", module_entry->name);
+	module_entry_unlock();
+    } else if (module_entry->infofunc) {
+	struct Info *info = module_entry_info(module_entry);
+
+	if (info)
+	    data = info_flatten(info);
     }
 
-    return NULL;
+    return data;
 }
 
-gchar *module_entry_get_moreinfo(ShellModuleEntry * module_entry, gchar * field)
+/* NULL if the entry only has the key-file form; free with info_free() */
+struct Info *module_entry_info(ShellModuleEntry * module_entry)
 {
-    if (module_entry->morefunc) {
-	return module_entry->morefunc(field);
+    struct Info *info = NULL;
+
+    module_init_wait(module_entry->module);
+    if (module_entry->infofunc) {
+	gint64 start;
+
+	module_entry_lock();
+	start = trace_begin();
+	info = module_entry->infofunc();
+	trace_end(start, "callback", "%s", module_entry->name);
+	/* before the module's idle_free()d strings go away */
+	if (info)
+	    info_detach(info);
+	module_entry_unlock();
     }
 
-    return NULL;
+    return info;
 }
 
-const gchar *module_entry_get_note(ShellModuleEntry * module_entry)
+gchar *module_entry_get_moreinfo(ShellModuleEntry * module_entry, gchar * field)
 {
-    if (module_entry->notefunc) {
-	return module_entry->notefunc(module_entry->number);
+    gchar *data = NULL;
+
+    module_init_wait(module_entry->module);
+    if (module_entry->morefunc) {
+	module_entry_lock();
+	data = module_entry->morefunc(field);
+	module_entry_unlock();
     }
 
-    return NULL;
+    return data;
 }
 
-gchar *h_strdup_cprintf(const gchar * format, gchar * source, ...)
+const gchar *module_entry_get_note(ShellModuleEntry * module_entry)
 {
-    gchar *buffer, *retn;
-    va_list args;
-
-    va_start(args, source);
-    buffer = g_strdup_vprintf(format, args);
-    va_end(args);
+    const gchar *note = NULL;
 
-    if (source) {
-	retn = g_strconcat(source, buffer, NULL);
-	g_free(buffer);
-        g_free(source);
-    } else {
-	retn = buffer;
+    module_init_wait(module_entry->module);
+    if (module_entry->notefunc) {
+	module_entry_lock();
+	note = module_entry->notefunc(module_entry->number);
+	module_entry_unlock();
     }
 
-    return retn;
+    return note;
 }
 
 gchar *h_strconcat(gchar * string1, ...)
@@ -1244,7 +1739,9 @@ h_sysfs_read_string(const gchar *endpoint, const gchar *entry)
 	return return_value;
 }
 
+/* shared by modules of different lock groups; see module_entry_lock() */
 static GHashTable *_moreinfo = NULL;
+static GMutex _moreinfo_mutex;
 
 void
 moreinfo_init(void)
@@ -1277,13 +1774,14 @@ moreinfo_add_with_prefix(gchar *prefix, gchar *key, gchar *value)
 		return;
 	}
 
+	g_mutex_lock(&_moreinfo_mutex);
 	if (prefix) {
 		gchar *hashkey = g_strconcat(prefix, ":", key, NULL);
 		g_hash_table_insert(_moreinfo, hashkey, value);
-		return;
+	} else {
+		g_hash_table_insert(_moreinfo, g_strdup(key), value);
 	}
-
-	g_hash_table_insert(_moreinfo, g_strdup(key), value);
+	g_mutex_unlock(&_moreinfo_mutex);
 }
 
 void
@@ -1306,7 +1804,9 @@ moreinfo_del_with_prefix(gchar *prefix)
 		return;
 	}
 
+	g_mutex_lock(&_moreinfo_mutex);
 	g_hash_table_foreach_remove(_moreinfo, _moreinfo_del_cb, prefix);
+	g_mutex_unlock(&_moreinfo_mutex);
 }
 
 void
@@ -1316,25 +1816,34 @@ moreinfo_clear(void)
 		DEBUG("moreinfo not initialized");
 		return;
 	}
+	g_mutex_lock(&_moreinfo_mutex);
 	h_hash_table_remove_all(_moreinfo);
+	g_mutex_unlock(&_moreinfo_mutex);
 }
 
+/* a copy, to be freed: another lock group's scan may replace the value
+ * at any time */
 gchar *
 moreinfo_lookup_with_prefix(gchar *prefix, gchar *key)
 {
+	gchar *result;
+
 	if (G_UNLIKELY(!_moreinfo)) {
 		DEBUG("moreinfo not initialized");
 		return 0;
 	}
 
+	g_mutex_lock(&_moreinfo_mutex);
 	if (prefix) {
 		gchar *lookup_key = g_strconcat(prefix, ":", key, NULL);
-		gchar *result = g_hash_table_lookup(_moreinfo, lookup_key);
+		result = g_strdup(g_hash_table_lookup(_moreinfo, lookup_key));
 		g_free(lookup_key);
-		return result;
+	} else {
+		result = g_strdup(g_hash_table_lookup(_moreinfo, key));
 	}
+	g_mutex_unlock(&_moreinfo_mutex);
 
-	return g_hash_table_lookup(_moreinfo, key);
+	return result;
 }
 
 gchar *
@@ -1439,7 +1948,13 @@ gboolean hardinfo_spawn_command_line_sync(const gchar *command_line,
                                           gint *exit_status,
                                           GError **error)
 {
+    gint64 start = trace_begin();
+    gboolean ret;
+
     shell_status_pulse();
-    return g_spawn_command_line_sync(command_line, standard_output,
-                                     standard_error, exit_status, error);
+    ret = g_spawn_command_line_sync(command_line, standard_output,
+                                    standard_error, exit_status, error);
+    trace_end(start, "spawn", "%s", command_line);
+
+    return ret;
 }
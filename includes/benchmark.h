@@ -8,44 +8,6 @@
 
 extern ProgramParameters params;
 
-enum BenchmarkEntries {
-    BENCHMARK_BLOWFISH_SINGLE,
-    BENCHMARK_BLOWFISH_THREADS,
-    BENCHMARK_BLOWFISH_CORES,
-    BENCHMARK_ZLIB,
-    BENCHMARK_CRYPTOHASH,
-    BENCHMARK_FIB,
-    BENCHMARK_NQUEENS,
-    BENCHMARK_FFT,
-    BENCHMARK_RAYTRACE,
-    BENCHMARK_SBCPU_SINGLE,
-    BENCHMARK_SBCPU_ALL,
-    BENCHMARK_SBCPU_QUAD,
-    BENCHMARK_MEMORY_SINGLE,
-    BENCHMARK_MEMORY_DUAL,
-    BENCHMARK_MEMORY_QUAD,
-    BENCHMARK_GUI,
-    BENCHMARK_N_ENTRIES
-};
-
-void benchmark_bfish_single(void);
-void benchmark_bfish_threads(void);
-void benchmark_bfish_cores(void);
-void benchmark_memory_single(void);
-void benchmark_memory_dual(void);
-void benchmark_memory_quad(void);
-void benchmark_sbcpu_single(void);
-void benchmark_sbcpu_all(void);
-void benchmark_sbcpu_quad(void);
-void benchmark_cryptohash(void);
-void benchmark_fft(void);
-void benchmark_fib(void);
-void benchmark_fish(void);
-void benchmark_gui(void);
-void benchmark_nqueens(void);
-void benchmark_raytrace(void);
-void benchmark_zlib(void);
-
 typedef struct {
     double result;
     double elapsed_time;
@@ -57,6 +19,83 @@ typedef struct {
 
 #define EMPTY_BENCH_VALUE {-1.0f,0,0,-1,""}
 
+/* Benchmark kernels
+ *
+ * Each benchmark is described by a bench_kernel. The built-in ones are
+ * listed in modules/benchmark/benches.c; more can be loaded at runtime from
+ * shared objects in <path_lib>/benchmarks, which must export:
+ *
+ *    const bench_kernel **hi_benchmark_get_kernels(void);
+ *
+ * returning a NULL-terminated list. A kernel either provides run(), which
+ * does all the work, or sets drive and work and lets the registry run it
+ * through benchmark_crunch_for() or benchmark_parallel_for().
+ */
+typedef struct _bench_kernel bench_kernel;
+
+enum {
+    BENCH_DRIVE_RUN = 0,      /* call run() */
+    BENCH_DRIVE_CRUNCH,       /* work(data, thread_number) for [amount] seconds,
+                               * result is iterations / scale */
+    BENCH_DRIVE_PARALLEL_FOR, /* work(start, end, data, thread_number) over
+                               * [amount] items, result is elapsed seconds */
+};
+
+/* used to group benchmarks in the composite score */
+enum {
+    BENCH_CATEGORY_NONE = 0,
+    BENCH_CATEGORY_INTEGER,
+    BENCH_CATEGORY_FP,
+    BENCH_CATEGORY_MEMORY,
+    BENCH_CATEGORY_STORAGE,
+    BENCH_CATEGORY_N
+};
+
+struct _bench_kernel {
+    const char *name;  /* untranslated, also the key in benchmark.json */
+    const char *icon;
+    const char *note;  /* untranslated, shown below the results */
+    const char *status;
+    guint32 flags;     /* MODULE_FLAG_* */
+    gboolean higher_is_better;
+    int category;      /* BENCH_CATEGORY_* */
+    int revision;      /* if anything in the kernel changes, increment it */
+    const char *params; /* copied to bench_value.extra by the driver */
+
+    bench_value (*run)(void);
+
+    int drive;
+    gint threads;      /* as in benchmark_crunch_for() */
+    double amount;
+    double scale;      /* 0 is the same as 1 */
+    gpointer (*setup)(void);
+    void (*teardown)(gpointer data);
+    gpointer work;
+};
+
+#define BENCH_MAX_KERNELS 32
+
+bench_value bench_kernel_run(const bench_kernel *k);
+
+/* built-in kernels */
+extern const bench_kernel bench_kernel_bfish_single;
+extern const bench_kernel bench_kernel_bfish_threads;
+extern const bench_kernel bench_kernel_bfish_cores;
+extern const bench_kernel bench_kernel_zlib;
+extern const bench_kernel bench_kernel_cryptohash;
+extern const bench_kernel bench_kernel_fib;
+extern const bench_kernel bench_kernel_nqueens;
+extern const bench_kernel bench_kernel_fft;
+extern const bench_kernel bench_kernel_raytrace;
+extern const bench_kernel bench_kernel_sbcpu_single;
+extern const bench_kernel bench_kernel_sbcpu_all;
+extern const bench_kernel bench_kernel_sbcpu_quad;
+extern const bench_kernel bench_kernel_memory_single;
+extern const bench_kernel bench_kernel_memory_dual;
+extern const bench_kernel bench_kernel_memory_quad;
+extern const bench_kernel bench_kernel_membw;
+extern const bench_kernel bench_kernel_gui;
+
 char *bench_value_to_str(bench_value r);
 bench_value bench_value_from_str(const char* str);
 
@@ -72,8 +111,6 @@ bench_value benchmark_parallel(gint n_threads, gpointer callback, gpointer callb
 bench_value benchmark_crunch_for(float seconds, gint n_threads,
                                gpointer callback, gpointer callback_data);
 
-extern bench_value bench_results[BENCHMARK_N_ENTRIES];
-
 /* in bench_util.c */
 
 /* guarantee a minimum size of data
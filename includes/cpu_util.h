@@ -49,4 +49,15 @@ gchar *cputopo_section_str(cpu_topology_data *cputd);
 
 int cpu_procs_cores_threads_nodes(int *p, int *c, int *t, int *n);
 
+/* what this process can actually use, which in a container may be much
+ * less than what is present */
+typedef struct {
+    int threads, cores;  /* present */
+    int affinity;        /* CPUs in the affinity mask, -1 if unknown */
+    long quota, period;  /* cgroup CPU bandwidth limit, quota < 0 if none */
+    int effective;       /* usable logical CPUs */
+} cpu_limits;
+
+int cpu_limits_get(cpu_limits *l);
+
 #endif
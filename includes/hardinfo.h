@@ -42,6 +42,8 @@ typedef enum {
   MODULE_FLAG_NO_REMOTE = 1<<0,
   MODULE_FLAG_HAS_HELP = 1<<1,
   MODULE_FLAG_HIDE = 1<<2,
+  MODULE_FLAG_SYNC_SCAN = 1<<3, /* scan_callback uses the GUI: don't run it on a worker thread */
+  MODULE_FLAG_SNAPSHOT = 1<<4, /* changes only across boots or package updates; see snapshot.c */
 } ModuleEntryFlags;
 
 typedef struct _ModuleEntry		ModuleEntry;
@@ -71,10 +73,26 @@ struct _ProgramParameters {
 
   gint     report_format;
   gint     max_bench_results;
+  gint     bench_timeout;     /* seconds, 0 = no limit; implies bench_isolate */
+  gboolean bench_isolate;     /* run each benchmark in a separate process */
+  gboolean bench_child;       /* that process; the parent set up bench_env */
+  gint     bench_repeat;      /* runs per benchmark with compare_benchmarks */
+  gdouble  compare_threshold; /* percent */
+  gboolean bench_controlled;  /* see modules/benchmark/bench_env.c */
+  gboolean bench_no_turbo;
+  gdouble  bench_max_load;
+  gboolean bench_latency;     /* time each work unit of crunch benchmarks */
+  gboolean rescan;            /* don't use the snapshot, only update it */
+  gchar  **diff_files;        /* --diff: old report, and new one or NULL */
+  gchar  **query;             /* --query: module/entry/group/field globs */
 
   gchar  **use_modules;
   gchar   *run_benchmark;
   gchar   *bench_user_note;
+  gchar   *bench_filter;      /* vendor=X,cores=N,memory=X */
+  gchar   *bench_reference;   /* machine id or CPU name, for the composite score */
+  gchar   *compare_benchmarks; /* baseline file */
+  gchar   *trace_file;        /* see trace.c */
   gchar   *result_format;
   gchar   *path_lib;
   gchar   *path_data;
@@ -94,6 +112,7 @@ struct _ModuleEntry {
     gpointer	 callback;
     gpointer	 scan_callback;
     guint32	 flags;
+    gpointer	 info_callback;	/* struct Info *(*)(void), instead of callback */
 };
 
 struct _ModuleAbout {
@@ -134,12 +153,12 @@ void          nonblock_sleep(guint msec);
 GSList	     *modules_get_list(void);
 GSList	     *modules_load_selected(void);
 GSList       *modules_load_all(void);
+void	      modules_init_all(GSList *modules);
+void	      module_init_wait(ShellModule *module);
 void	      module_unload_all(void);
 const ModuleAbout  *module_get_about(ShellModule *module);
 gchar        *seconds_to_string(unsigned int seconds);
 
-gchar        *h_strdup_cprintf(const gchar *format, gchar *source, ...)
-                                __attribute__((format(gnu_printf, 1, 3)));
 gchar	     *h_strconcat(gchar *string1, ...);
 void          h_hash_table_remove_all (GHashTable *hash_table);
 
@@ -148,9 +167,14 @@ void	      module_entry_scan_all(ModuleEntry *entries);
 void	      module_entry_reload(ShellModuleEntry *module_entry);
 void	      module_entry_scan(ShellModuleEntry *module_entry);
 gchar	     *module_entry_function(ShellModuleEntry *module_entry);
+struct Info  *module_entry_info(ShellModuleEntry *module_entry);
 const gchar  *module_entry_get_note(ShellModuleEntry *module_entry);
 gchar        *module_entry_get_field(ShellModuleEntry * module_entry, gchar * field);
 gchar        *module_entry_get_moreinfo(ShellModuleEntry * module_entry, gchar * field);
+void          module_entry_lock(void);
+gboolean      module_entry_trylock(void);
+void          module_entry_unlock(void);
+void          module_entry_lock_group(ShellModule *module);
 
 /* BinReloc stuff */
 gboolean binreloc_init(gboolean try_hardcoded);
@@ -32,10 +32,17 @@ enum InfoGroupSort {
     INFO_GROUP_SORT_MAX,
 };
 
+#define INFO_N_COLUMNS 5
+
+extern const gchar *info_column_titles[INFO_N_COLUMNS];
+
 struct Info {
     GArray *groups;
 
-    const gchar *column_titles[5];
+    /* owns the strings of an info_detach()ed Info */
+    GStringChunk *strings;
+
+    const gchar *column_titles[INFO_N_COLUMNS];
 
     ShellViewType view_type;
 
@@ -111,4 +118,12 @@ void info_set_view_type(struct Info *info, ShellViewType setting);
 void info_set_reload_interval(struct Info *info, int setting);
 
 gchar *info_flatten(struct Info *info);
+gchar *info_to_key_file(struct Info *info);
 struct Info *info_unflatten(const gchar *str);
+
+/* For consumers walking a struct Info instead of its flattened form */
+void info_detach(struct Info *info);
+void info_free(struct Info *info);
+void info_group_sort(struct InfoGroup *group);
+gchar *info_field_key(const struct InfoField *field, guint group_index, guint field_index);
+gchar *info_field_update_name(const struct InfoField *field);
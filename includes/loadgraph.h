@@ -26,6 +26,13 @@
 #include <math.h>
 
 typedef struct _LoadGraph LoadGraph;
+typedef struct _LoadGraphSeries LoadGraphSeries;
+
+typedef struct {
+    gdouble x;  /* in samples; 0 is the oldest of the span */
+    gdouble y;
+    gdouble lo, hi; /* range of the samples the point stands for */
+} LoadGraphPoint;
 
 typedef enum {
     LG_COLOR_GREEN = 0x4FB05A,
@@ -52,4 +59,18 @@ const gchar *load_graph_get_title(LoadGraph *lg);
 
 gint         load_graph_get_height(LoadGraph *lg);
 
+/* lines not fed by load_graph_update_ex() draw a series kept elsewhere */
+void         load_graph_set_series(LoadGraph *lg, guint line, LoadGraphSeries *series);
+void         load_graph_redraw(LoadGraph *lg);
+
+/* history of one value, see loadgraph-history.c */
+LoadGraphSeries *load_graph_series_new(gint interval);
+void         load_graph_series_free(LoadGraphSeries *series);
+void         load_graph_series_add(LoadGraphSeries *series, gdouble value);
+gboolean     load_graph_series_last(LoadGraphSeries *series, gdouble *value);
+guint        load_graph_series_span_max(LoadGraphSeries *series);
+gint         load_graph_series_get_interval(LoadGraphSeries *series);
+guint        load_graph_series_get(LoadGraphSeries *series, guint span,
+                                   LoadGraphPoint *points, guint max_points);
+
 #endif  /* __LOADGRAPH_H__ */
@@ -18,6 +18,7 @@
 
 #ifndef __REPORT_H__
 #define __REPORT_H__
+#include <stdio.h>
 #include <gtk/gtk.h>
 #include <shell.h>
 
@@ -25,6 +26,7 @@ typedef enum {
     REPORT_FORMAT_HTML,
     REPORT_FORMAT_TEXT,
     REPORT_FORMAT_SHELL,
+    REPORT_FORMAT_JSON,
     N_REPORT_FORMAT
 } ReportFormat;
 
@@ -40,8 +42,10 @@ typedef struct _ReportDialog	ReportDialog;
 typedef struct _ReportContext	ReportContext;
 
 struct _ReportContext {
+  ShellModule		*module;	/* the one after report_title() */
   ShellModuleEntry	*entry;
-  gchar			*output;
+  FILE			*stream;	/* where the report goes, if set... */
+  GString		*output;	/* ...else it's kept here */
 
   void (*header)      	(ReportContext *ctx);
   void (*footer)      	(ReportContext *ctx);
@@ -59,12 +63,17 @@ struct _ReportContext {
 
   gboolean		first_table;
   gboolean		in_details;
+  gboolean		snapshot;	/* entry's data is from the snapshot */
 
   gboolean		show_column_headers;
   guint			columns, parent_columns;
   GHashTable		*column_titles;
   GHashTable *icon_refs;
   GHashTable *icon_data;
+
+  /* REPORT_FORMAT_JSON: arrays open, each in an object but the first */
+  gint			json_depth, json_details;
+  gboolean		json_first[8];
 };
 
 struct _ReportDialog {
@@ -84,6 +93,7 @@ void		 report_dialog_show();
 ReportContext	*report_context_html_new();
 ReportContext	*report_context_text_new();
 ReportContext	*report_context_shell_new();
+ReportContext	*report_context_json_new();
 
 void		 report_header		(ReportContext *ctx);
 void		 report_footer		(ReportContext *ctx);
@@ -92,10 +102,13 @@ void 		 report_subtitle	(ReportContext *ctx, gchar *text);
 void 		 report_subsubtitle	(ReportContext *ctx, gchar *text);
 void		 report_key_value	(ReportContext *ctx, gchar *key, gchar *value, gsize longest_key);
 void		 report_table		(ReportContext *ctx, gchar *text);
+void		 report_table_info	(ReportContext *ctx, struct Info *info);
 void		 report_details		(ReportContext *ctx, gchar *key, gchar *value, gchar *details, gsize longest_key);
 
 void             report_create_from_module_list(ReportContext *ctx, GSList *modules);
 gchar           *report_create_from_module_list_format(GSList *modules, ReportFormat format);
+gboolean         report_write_from_module_list_format(GSList *modules, ReportFormat format, FILE *stream);
+gint             report_query(GSList *modules, gchar **patterns, ReportFormat format, FILE *stream);
 
 void		 report_context_free(ReportContext *ctx);
 void             report_module_list_free(GSList *modules);
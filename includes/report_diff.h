@@ -0,0 +1,30 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __REPORT_DIFF_H__
+#define __REPORT_DIFF_H__
+
+#include <glib.h>
+
+/* Compares two JSON reports (-f json), or old_file with a report of this
+ * machine made from modules if new_file is NULL, and prints what was
+ * added, removed or changed, as text or, with -f json, as JSON.
+ * Returns the number of differences, or -1 if a report can't be read. */
+gint report_diff(const gchar *old_file, const gchar *new_file, GSList *modules);
+
+#endif /* __REPORT_DIFF_H__ */
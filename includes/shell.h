@@ -33,6 +33,8 @@ typedef struct _ShellModule		ShellModule;
 typedef struct _ShellModuleMethod	ShellModuleMethod;
 typedef struct _ShellModuleEntry	ShellModuleEntry;
 
+struct Info;
+
 typedef struct _ShellFieldUpdate	ShellFieldUpdate;
 typedef struct _ShellFieldUpdateSource	ShellFieldUpdateSource;
 
@@ -138,16 +140,24 @@ struct _ShellNote {
 
 struct _ShellModule {
     gchar		*name;
+    gchar		*id;		/* file name without suffix: "devices" */
     GdkPixbuf		*icon;
     GModule		*dll;
 
     gconstpointer 	(*aboutfunc)(void);
     gchar		*(*summaryfunc) ();
+    void		(*initfunc) ();
     void		(*deinit) ();
 
     guchar		 weight;
 
     GSList		*entries;
+
+    gint		 init_state;	/* MODULE_INIT_*; see module_init_wait() */
+    GSList		*init_deps;	/* ShellModule, initialized before this one */
+
+    ShellModule		*lock_group;	/* see module_entry_lock_group() */
+    GRecMutex		 lock;		/* of the group, if lock_group is this one */
 };
 
 struct _ShellModuleMethod {
@@ -156,7 +166,9 @@ struct _ShellModuleMethod {
 };
 
 struct _ShellModuleEntry {
+    ShellModule		*module;
     gchar		*name;
+    gchar		*id;		/* untranslated name: "pci-devices" */
     GdkPixbuf		*icon;
     gchar		*icon_file;
     gboolean		 selected;
@@ -164,21 +176,32 @@ struct _ShellModuleEntry {
     guint32		 flags;
 
     gchar		*(*func) ();
+    struct Info		*(*infofunc) ();
     void		(*scan_func) ();
 
     gchar		*(*fieldfunc) (gchar * entry);
+    /* optional: every field of fields, NULL-terminated, into values, newly
+     * allocated or left NULL; the shell's periodic updates use it instead
+     * of one fieldfunc() call per field */
+    void		(*fieldsfunc) (gint entry, gchar ** fields, gchar ** values);
     gchar 		*(*morefunc)  (gchar * entry);
     gchar		*(*notefunc)  (gint entry);
+
+    gchar		*scan_data;	/* last func() output, shown while rescanning */
+    struct Info		*scan_info;	/* or infofunc() output */
+    gint		 scans_pending;	/* jobs queued on the scan pool */
 };
 
 struct _ShellFieldUpdate {
     ShellModuleEntry	*entry;
     gchar		*field_name;
+    LoadGraphSeries	*series;	/* owned by the shell's field history */
 };
 
 struct _ShellFieldUpdateSource {
     guint		 source_id;
-    ShellFieldUpdate	*sfu;
+    gint		 interval;	/* ms */
+    GSList		*sfus;		/* ShellFieldUpdate, updated together */
 };
 
 void		shell_init(GSList *modules);
@@ -0,0 +1,44 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include "shell.h"
+
+/* Data of the entries with MODULE_FLAG_SNAPSHOT, kept across runs in the
+ * user's cache dir for as long as the system looks the same: same boot,
+ * same packages, same hardinfo. See snapshot.c. */
+void         snapshot_init(void);
+void         snapshot_save(void);
+
+/* key-file data; NULL if the entry isn't in the snapshot, or its details
+ * weren't collected yet */
+gchar       *snapshot_get(ShellModuleEntry *entry);
+/* details of a tag in the data */
+gchar       *snapshot_get_more_info(ShellModuleEntry *entry, const gchar *tag);
+/* value of a "..." field; NULL if unknown */
+gchar       *snapshot_get_field(ShellModuleEntry *entry, const gchar *key);
+
+gboolean     snapshot_wants(ShellModuleEntry *entry);
+/* after a scan; only keeps the data */
+void         snapshot_update(ShellModuleEntry *entry, const gchar *key_data);
+/* with the module entry lock held, as the details are asked to the module */
+void         snapshot_collect(ShellModuleEntry *entry);
+
+#endif /* __SNAPSHOT_H__ */
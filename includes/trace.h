@@ -0,0 +1,37 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <glib.h>
+
+/* With --trace=file.json, spans are recorded from every thread and written
+ * at exit as Chrome trace events (chrome://tracing, ui.perfetto.dev):
+ *
+ *   gint64 start = trace_begin();
+ *   ...
+ *   trace_end(start, "scan", "%s", entry->name);
+ *
+ * Without it, trace_begin() returns 0 and trace_end() does nothing. */
+void   trace_init(const gchar *path);
+gint64 trace_begin(void);
+void   trace_end(gint64 start, const gchar *category, const gchar *fmt, ...)
+           G_GNUC_PRINTF(3, 4);
+
+#endif /* __TRACE_H__ */
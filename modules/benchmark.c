@@ -26,25 +26,40 @@
 #include <sys/resource.h>
 #include <sys/time.h>
 
+#include <errno.h>
+#include <poll.h>
 #include <signal.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 
 #include "appf.h"
 #include "benchmark.h"
+#include "cpu_util.h"
 
 #include "benchmark/bench_results.c"
 
-bench_value bench_results[BENCHMARK_N_ENTRIES];
+static gchar *find_benchmark_conf(void);
 
-static void do_benchmark(void (*benchmark_function)(void), int entry);
+#include "benchmark/bench_store.c"
+
+/* --bench-controlled */
+#include "benchmark/bench_env.c"
+
+/* --bench-latency */
+#include "benchmark/bench_hist.c"
+
+static void do_benchmark(gint slot);
 static gchar *benchmark_include_results_reverse(bench_value result,
                                                 const gchar *benchmark);
 static gchar *benchmark_include_results(bench_value result,
                                         const gchar *benchmark);
 
-/* ModuleEntry entries, scan_*(), callback_*(), etc. */
+/* kernel registry, ModuleEntry entries, scan_*(), callback_*(), etc. */
 #include "benchmark/benches.c"
 
+/* composite score and percentiles */
+#include "benchmark/bench_score.c"
+
 char *bench_value_to_str(bench_value r)
 {
     gboolean has_rev = r.revision >= 0;
@@ -52,6 +67,10 @@ char *bench_value_to_str(bench_value r)
     gboolean has_user_note = r.user_note && *r.user_note != 0;
     char *ret = g_strdup_printf("%lf; %lf; %d", r.result, r.elapsed_time,
                                 r.threads_used);
+
+    /* the separators can't be escaped, and would cut extra short */
+    g_strdelimit(r.extra, ";|\r\n", ',');
+    g_strdelimit(r.user_note, ";|\r\n", ',');
     if (has_rev || has_extra || has_user_note)
         ret = appf(ret, "; ", "%d", r.revision);
     if (has_extra || has_user_note)
@@ -97,6 +116,23 @@ bench_value bench_value_from_str(const char *str)
     return ret;
 }
 
+/* n_threads > 0: that many; 0: one per logical CPU; -1: one per core. In a
+ * container, only the CPUs the affinity mask and cgroup quota allow count. */
+static gint bench_thread_count(gint n_threads, gint *usable)
+{
+    cpu_limits lim;
+
+    cpu_limits_get(&lim);
+    if (usable)
+        *usable = lim.effective;
+
+    if (n_threads > 0)
+        return n_threads;
+    if (n_threads < 0)
+        return MAX(MIN(lim.cores, lim.effective), 1);
+    return lim.effective;
+}
+
 typedef struct _ParallelBenchTask ParallelBenchTask;
 
 struct _ParallelBenchTask {
@@ -104,6 +140,7 @@ struct _ParallelBenchTask {
     guint start, end;
     gpointer data, callback;
     int *stop;
+    bench_hist *hist; /* with --bench-latency */
 };
 
 static gpointer benchmark_crunch_for_dispatcher(gpointer data)
@@ -113,7 +150,16 @@ static gpointer benchmark_crunch_for_dispatcher(gpointer data)
     gpointer return_value = g_malloc(sizeof(double));
     int count = 0;
 
-    if ((callback = pbt->callback)) {
+    if ((callback = pbt->callback) && pbt->hist) {
+        while (!*pbt->stop) {
+            guint64 start = bench_hist_now();
+            callback(pbt->data, pbt->thread_number);
+            if (!*pbt->stop) {
+                bench_hist_record(pbt->hist, bench_hist_now() - start);
+                count++;
+            }
+        }
+    } else if (callback) {
         while (!*pbt->stop) {
             callback(pbt->data, pbt->thread_number);
             /* don't count if didn't finish in time */
@@ -136,21 +182,22 @@ bench_value benchmark_crunch_for(float seconds,
                                  gpointer callback,
                                  gpointer callback_data)
 {
-    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
     int thread_number, stop = 0;
     GSList *threads = NULL, *t;
     GTimer *timer;
+    bench_hist **hists = NULL;
     bench_value ret = EMPTY_BENCH_VALUE;
 
     timer = g_timer_new();
 
-    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
-    if (n_threads > 0)
-        ret.threads_used = n_threads;
-    else if (n_threads < 0)
-        ret.threads_used = cpu_cores;
-    else
-        ret.threads_used = cpu_threads;
+    ret.threads_used = bench_thread_count(n_threads, NULL);
+
+    if (params.bench_latency) {
+        hists = g_new0(bench_hist *, ret.threads_used);
+        for (thread_number = 0; thread_number < ret.threads_used;
+             thread_number++)
+            hists[thread_number] = g_new0(bench_hist, 1);
+    }
 
     g_timer_start(timer);
     for (thread_number = 0; thread_number < ret.threads_used; thread_number++) {
@@ -163,6 +210,7 @@ bench_value benchmark_crunch_for(float seconds,
         pbt->data = callback_data;
         pbt->callback = callback;
         pbt->stop = &stop;
+        pbt->hist = hists ? hists[thread_number] : NULL;
 
         thread = g_thread_new(
             "dispatcher", (GThreadFunc)benchmark_crunch_for_dispatcher, pbt);
@@ -190,6 +238,14 @@ bench_value benchmark_crunch_for(float seconds,
 
     ret.elapsed_time = g_timer_elapsed(timer, NULL);
 
+    if (hists) {
+        bench_hist_summarize(hists, ret.threads_used);
+        for (thread_number = 0; thread_number < ret.threads_used;
+             thread_number++)
+            g_free(hists[thread_number]);
+        g_free(hists);
+    }
+
     g_slist_free(threads);
     g_timer_destroy(timer);
 
@@ -224,13 +280,7 @@ static gpointer benchmark_parallel_for_dispatcher(gpointer data)
 bench_value
 benchmark_parallel(gint n_threads, gpointer callback, gpointer callback_data)
 {
-    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
-    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
-
-    if (n_threads == 0)
-        n_threads = cpu_threads;
-    else if (n_threads == -1)
-        n_threads = cpu_cores;
+    n_threads = bench_thread_count(n_threads, NULL);
 
     return benchmark_parallel_for(n_threads, 0, n_threads, callback,
                                   callback_data);
@@ -248,7 +298,7 @@ bench_value benchmark_parallel_for(gint n_threads,
                                    gpointer callback_data)
 {
     gchar *temp;
-    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
+    gint cpu_threads;
     guint iter_per_thread, iter, thread_number = 0;
     GSList *threads = NULL, *t;
     GTimer *timer;
@@ -257,14 +307,7 @@ bench_value benchmark_parallel_for(gint n_threads,
 
     timer = g_timer_new();
 
-    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
-
-    if (n_threads > 0)
-        ret.threads_used = n_threads;
-    else if (n_threads < 0)
-        ret.threads_used = cpu_cores;
-    else
-        ret.threads_used = cpu_threads;
+    ret.threads_used = bench_thread_count(n_threads, &cpu_threads);
 
     while (ret.threads_used > 0) {
         iter_per_thread = (end - start) / ret.threads_used;
@@ -330,22 +373,112 @@ bench_value benchmark_parallel_for(gint n_threads,
     return ret;
 }
 
+bench_value bench_kernel_run(const bench_kernel *k)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    gpointer data = NULL;
+    gboolean locked;
+
+    locked = bench_env_lock_memory();
+    g_free(bench_hist_last);
+    bench_hist_last = NULL;
+
+    if (k->run) {
+        r = k->run();
+        goto out;
+    }
+
+    if (k->setup)
+        data = k->setup();
+
+    switch (k->drive) {
+    case BENCH_DRIVE_CRUNCH:
+        r = benchmark_crunch_for(k->amount, k->threads, k->work, data);
+        if (k->scale > 0)
+            r.result /= k->scale;
+        break;
+    case BENCH_DRIVE_PARALLEL_FOR:
+        r = benchmark_parallel_for(k->threads, 0, (guint)k->amount, k->work,
+                                   data);
+        r.result = r.elapsed_time;
+        break;
+    default:
+        bench_msg("kernel ``%s'' has unknown drive %d", k->name, k->drive);
+    }
+
+    if (k->teardown)
+        k->teardown(data);
+
+    r.revision = k->revision;
+    if (k->params)
+        g_strlcpy(r.extra, k->params, sizeof(r.extra));
+
+out:
+    if (locked) {
+        munlockall();
+        bench_env_append(&r, "mlock");
+    }
+    bench_env_append(&r, bench_hist_last);
+
+    return r;
+}
+
+/* Result rows are tagged BENCH<slot>_<record> (or BENCH<slot>_this), and
+ * their details are only looked up when one is selected. */
+static bench_result *bench_result_from_tag(const gchar *tag)
+{
+    const bench_store *store;
+    const bench_store_section *section;
+    const gchar *name;
+    bench_result *b;
+    gint slot, n = 0;
+    guint rec;
+
+    if (sscanf(tag, "BENCH%d_%n", &slot, &n) != 1 || !n)
+        return NULL;
+    if (slot < 0 || slot >= bench_n_slots)
+        return NULL;
+
+    name = bench_slots[slot].kernel->name;
+    if (g_str_equal(tag + n, "this"))
+        return bench_result_this_machine(name, bench_slots[slot].result);
+
+    if (sscanf(tag + n, "%u", &rec) != 1)
+        return NULL;
+
+    store = bench_store_get();
+    section = store ? bench_store_find_section(store, name) : NULL;
+    b = (section && rec < section->n_records)
+            ? bench_store_result_new(store, section, rec)
+            : NULL;
+    bench_store_unref(store);
+
+    return b;
+}
+
 gchar *hi_more_info(gchar *entry)
 {
-    const gchar *info = moreinfo_lookup_with_prefix("BENCH", entry);
-    return g_strdup(info ? info : "?");
+    bench_result *b = bench_result_from_tag(entry);
+    gchar *info;
+
+    if (!b)
+        return g_strdup("?");
+
+    info = bench_result_more_info(b);
+    bench_result_free(b);
+
+    return info;
 }
 
 gchar *hi_get_field(gchar *field)
 {
-    const gchar *info = moreinfo_lookup_with_prefix("BENCH", field);
-    return g_strdup(info ? info : field);
+    return g_strdup(field);
 }
 
-static void br_mi_add(char **results_list, bench_result *b, gboolean select)
+static void br_mi_add(GString *results, bench_result *b, gint slot,
+                      const gchar *rec, gboolean select)
 {
-    static unsigned int ri = 0; /* to ensure key is unique */
-    gchar *rkey, *lbl, *elbl, *this_marker;
+    gchar *lbl, *elbl, *this_marker;
 
     if (select) {
         this_marker = format_with_ansi_color(_("This Machine"), "0;30;43",
@@ -354,91 +487,20 @@ static void br_mi_add(char **results_list, bench_result *b, gboolean select)
         this_marker = "";
     }
 
-    rkey = g_strdup_printf("%s__%d", b->machine->mid, ri++);
-
     lbl = g_strdup_printf("%s%s%s%s", this_marker, select ? " " : "",
                           b->machine->cpu_name,
                           b->legacy ? problem_marker() : "");
     elbl = key_label_escape(lbl);
 
-    *results_list = h_strdup_cprintf("$@%s%s$%s=%.2f|%s\n", *results_list,
-                                     select ? "*" : "", rkey, elbl,
-                                     b->bvalue.result, b->machine->cpu_config);
-
-    moreinfo_add_with_prefix("BENCH", rkey, bench_result_more_info(b));
+    g_string_append_printf(results, "$@%sBENCH%d_%s$%s=%.2f|%s\n",
+                           select ? "*" : "", slot, rec, elbl,
+                           b->bvalue.result, b->machine->cpu_config);
 
     g_free(lbl);
     g_free(elbl);
-    g_free(rkey);
     if (*this_marker)
         g_free(this_marker);
 }
-gint bench_result_sort(gconstpointer a, gconstpointer b)
-{
-    bench_result *A = (bench_result *)a, *B = (bench_result *)b;
-    if (A->bvalue.result < B->bvalue.result)
-        return -1;
-    if (A->bvalue.result > B->bvalue.result)
-        return 1;
-    return 0;
-}
-
-struct append_machine_result_json_data {
-    GSList **result_list;
-    const gchar *benchmark_name;
-};
-
-static void append_machine_result_json(JsonArray *array,
-                                       guint index,
-                                       JsonNode *element_node,
-                                       gpointer user_data)
-{
-    struct append_machine_result_json_data *data = user_data;
-    bench_result *result;
-
-    result = bench_result_benchmarkjson(data->benchmark_name, element_node);
-    *data->result_list = g_slist_append(*data->result_list, result);
-}
-
-static GSList *benchmark_include_results_json(const gchar *path,
-                                              bench_value r,
-                                              const gchar *benchmark)
-{
-    JsonParser *parser;
-    JsonNode *root;
-    bench_result *this_machine = NULL;
-    GSList *result_list = NULL;
-
-    DEBUG("Loading benchmark results from JSON file %s", path);
-
-    parser = json_parser_new();
-    if (!json_parser_load_from_file(parser, path, NULL))
-        goto out;
-
-    root = json_parser_get_root(parser);
-    if (json_node_get_node_type(root) != JSON_NODE_OBJECT)
-        goto out;
-
-    JsonObject *results = json_node_get_object(root);
-    if (results) {
-        JsonArray *machines = json_object_get_array_member(results, benchmark);
-
-        if (machines) {
-            struct append_machine_result_json_data data = {
-                .result_list = &result_list,
-                .benchmark_name = benchmark,
-            };
-            json_array_foreach_element(machines, append_machine_result_json,
-                                       &data);
-        }
-    }
-
-out:
-    g_object_unref(parser);
-
-    return result_list;
-}
-
 static gchar *find_benchmark_conf(void)
 {
     const gchar *config_dir = g_get_user_config_dir();
@@ -461,19 +523,26 @@ struct bench_window {
     int min, max;
 };
 
-static struct bench_window get_bench_window(GSList *result_list,
-                                            const bench_result *this_machine)
+/* Every row handed to the shell ends up in its GtkTreeStore, which has no
+ * way of being fed lazily; so the GUI stops at this many rows, around
+ * this machine if it has a result, and the ones past them can only be
+ * seen in a report. */
+#define BENCH_GUI_MAX_RESULTS 500
+
+/* len: number of results, including this machine;
+ * loc: where this machine is, -1 if not there */
+static struct bench_window get_bench_window(int len, int loc)
 {
     struct bench_window window = {};
     int size = params.max_bench_results;
-    int len = g_slist_length(result_list);
 
     if (size == 0)
         size = 1;
     else if (size < 0)
         size = len;
+    if (params.gui_running && size > BENCH_GUI_MAX_RESULTS)
+        size = BENCH_GUI_MAX_RESULTS;
 
-    int loc = g_slist_index(result_list, this_machine); /* -1 if not found */
     if (loc >= 0) {
         window.min = loc - size / 2;
         window.max = window.min + size;
@@ -485,8 +554,11 @@ static struct bench_window get_bench_window(GSList *result_list,
             window.min = MAX(len - size, 0);
         }
     } else {
+        /* all of them, as --max-results is about the neighbourhood of
+         * this machine; the GUI still stops at its limit */
         window.min = 0;
-        window.max = len;
+        window.max = params.gui_running ? MIN(len, BENCH_GUI_MAX_RESULTS)
+                                        : len;
     }
 
     DEBUG("...len: %d, loc: %d, win_size: %d, win: [%d..%d]\n", len, loc, size,
@@ -495,55 +567,64 @@ static struct bench_window get_bench_window(GSList *result_list,
     return window;
 }
 
-static gboolean is_in_bench_window(const struct bench_window *window, int i)
-{
-    return i >= window->min && i < window->max;
-}
-
 static gchar *benchmark_include_results_internal(bench_value this_machine_value,
                                                  const gchar *benchmark,
                                                  ShellOrderType order_type)
 {
-    bench_result *this_machine;
-    GSList *result_list, *li;
-    gchar *results = g_strdup("");
+    const bench_store *store;
+    const bench_store_section *section = NULL;
+    bench_store_filter filter;
+    bench_store_view view;
+    bench_result *this_machine = NULL;
+    gboolean descending = (order_type == SHELL_ORDER_DESCENDING);
+    gboolean filtered;
+    GString *results;
     gchar *output;
-    gchar *path;
-    gint i;
+    gint i, len, loc = -1, slot;
 
-    path = find_benchmark_conf();
-    if (path) {
-        result_list = benchmark_include_results_json(
-            path, this_machine_value, benchmark);
-    }
+    slot = bench_find_slot(benchmark);
+    filtered = bench_store_filter_parse(&filter, params.bench_filter);
+
+    store = bench_store_get();
+    if (store)
+        section = bench_store_find_section(store, benchmark);
+    bench_store_view_init(&view, store, section, filtered ? &filter : NULL);
+    bench_store_filter_clear(&filter);
+    len = view.len;
 
-    /* this result */
+    /* this result; loc is in ascending order */
     if (this_machine_value.result > 0.0) {
         this_machine = bench_result_this_machine(benchmark, this_machine_value);
-        result_list = g_slist_prepend(result_list, this_machine);
-    } else {
-        this_machine = NULL;
+        loc = bench_store_view_rank(&view, this_machine_value.result);
+        len++;
     }
 
-    /* sort */
-    result_list = g_slist_sort(result_list, bench_result_sort);
-    if (order_type == SHELL_ORDER_DESCENDING)
-        result_list = g_slist_reverse(result_list);
-
-    /* prepare for shell */
-    moreinfo_del_with_prefix("BENCH");
-
+    /* only the rows in the window are materialized */
+    results = g_string_new(NULL);
     const struct bench_window window =
-        get_bench_window(result_list, this_machine);
-    for (i = 0, li = result_list; li; li = g_slist_next(li), i++) {
-        bench_result *br = li->data;
-
-        if (is_in_bench_window(&window, i))
-            br_mi_add(&results, br, br == this_machine);
+        get_bench_window(len, (loc >= 0 && descending) ? len - 1 - loc : loc);
+    for (i = window.min; i < window.max; i++) {
+        gint asc = descending ? len - 1 - i : i;
+        gchar tag[16];
+        bench_result *br;
+        guint rec;
+
+        if (this_machine && asc == loc) {
+            br_mi_add(results, this_machine, slot, "this", TRUE);
+            continue;
+        }
 
-        bench_result_free(br); /* no longer needed */
+        if (this_machine && asc > loc)
+            asc--;
+        rec = bench_store_view_record(&view, asc);
+        g_snprintf(tag, sizeof(tag), "%u", rec);
+        br = bench_store_result_new(store, section, rec);
+        br_mi_add(results, br, slot, tag, FALSE);
+        bench_result_free(br);
     }
-    g_slist_free(result_list);
+    bench_result_free(this_machine);
+    bench_store_view_clear(&view);
+    bench_store_unref(store);
 
     output = g_strdup_printf("[$ShellParam$]\n"
                              "Zebra=1\n"
@@ -555,10 +636,9 @@ static gchar *benchmark_include_results_internal(bench_value this_machine_value,
                              "ShowColumnHeaders=true\n"
                              "[%s]\n%s",
                              order_type, _("CPU Config"), _("Results"),
-                             _("CPU"), benchmark, results);
+                             _("CPU"), benchmark, results->str);
 
-    g_free(path);
-    g_free(results);
+    g_string_free(results, TRUE);
 
     return output;
 }
@@ -612,17 +692,168 @@ do_benchmark_handler(GIOChannel *source, GIOCondition condition, gpointer data)
     return FALSE;
 }
 
-static void do_benchmark(void (*benchmark_function)(void), int entry)
+static void bench_child_setup(gpointer data)
+{
+    /* between fork() and exec(): only async-signal-safe calls here */
+    setpgid(0, 0);
+}
+
+/* Runs the kernel in a new hardinfo process (-b NAME --bench-child), which
+ * prints its result as usual; it's exec()'d rather than just forked, as
+ * this process has GLib threads of its own and a forked child could
+ * deadlock on a lock one of them held. The child is put in its own process
+ * group, so that whatever it spawned (e.g. sysbench) is killed with it if
+ * params.bench_timeout is reached. */
+static bench_value bench_kernel_run_isolated(const bench_kernel *k,
+                                             gboolean *timed_out)
+{
+    gchar *argv[] = {params.argv0, "-b",           (gchar *)k->name,
+                     "-m",         "benchmark.so", "-a",
+                     "--bench-child", NULL,        NULL,
+                     NULL};
+    GSpawnFlags spawn_flags = G_SPAWN_DO_NOT_REAP_CHILD;
+    bench_value r = EMPTY_BENCH_VALUE;
+    GError *error = NULL;
+    GString *buf;
+    gint64 deadline = 0;
+    gint argc = 7;
+    int out_fd, status;
+    GPid pid;
+
+    *timed_out = FALSE;
+
+    /* bench_env is already set up here; the child only locks its memory
+     * and times the work units */
+    if (params.bench_controlled)
+        argv[argc++] = "--bench-controlled";
+    if (params.bench_latency)
+        argv[argc++] = "--bench-latency";
+    if (!g_path_is_absolute(params.argv0))
+        spawn_flags |= G_SPAWN_SEARCH_PATH;
+
+    if (!g_spawn_async_with_pipes(NULL, argv, NULL, spawn_flags,
+                                  bench_child_setup, NULL, &pid, NULL, &out_fd,
+                                  NULL, &error)) {
+        bench_msg("could not start a new process (%s); running ``%s'' "
+                  "in-process",
+                  error->message, k->name);
+        g_error_free(error);
+        return bench_kernel_run(k);
+    }
+
+    /* also here, in case the child hasn't run yet */
+    setpgid(pid, pid);
+    bench_env_child = pid;
+    bench_env_catch_signals();
+
+    if (params.bench_timeout > 0)
+        deadline = g_get_monotonic_time() +
+                   (gint64)params.bench_timeout * G_USEC_PER_SEC;
+
+    buf = g_string_new(NULL);
+    for (;;) {
+        struct pollfd pfd = {.fd = out_fd, .events = POLLIN};
+        int wait_ms = -1;
+        char chunk[512];
+        ssize_t n;
+
+        if (deadline) {
+            gint64 left = deadline - g_get_monotonic_time();
+            if (left <= 0) {
+                *timed_out = TRUE;
+                break;
+            }
+            wait_ms = (int)(left / 1000) + 1;
+        }
+
+        n = poll(&pfd, 1, wait_ms);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            break;
+        if (n == 0)
+            continue; /* check the deadline again */
+
+        n = read(out_fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        g_string_append_len(buf, chunk, n);
+    }
+    close(out_fd);
+
+    if (*timed_out) {
+        bench_msg("``%s'' did not finish in %d seconds; killing it", k->name,
+                  params.bench_timeout);
+        kill(-pid, SIGKILL);
+    }
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+        ;
+    g_spawn_close_pid(pid);
+    bench_env_child = 0;
+    bench_env_release_signals();
+
+    if (!*timed_out && WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        r = bench_value_from_str(buf->str);
+    g_string_free(buf, TRUE);
+
+    return r;
+}
+
+static bench_value bench_run_kernel(const bench_kernel *k, gboolean *timed_out)
 {
+    bench_value r = EMPTY_BENCH_VALUE;
     int old_priority = 0;
+    bench_env env;
+
+    if (timed_out)
+        *timed_out = FALSE;
+
+    if (k->status) {
+        shell_view_set_enabled(FALSE);
+        shell_status_update(k->status);
+    }
+
+    /* --bench-isolate's child: the parent does all of the following */
+    if (params.bench_child)
+        return bench_kernel_run(k);
+
+    if (!bench_env_enter(&env, k)) {
+        bench_env_leave(&env, NULL);
+        return r;
+    }
+
+    setpriority(PRIO_PROCESS, 0, -20);
+    if (params.bench_isolate) {
+        gboolean dummy;
+        r = bench_kernel_run_isolated(k, timed_out ? timed_out : &dummy);
+    } else {
+        r = bench_kernel_run(k);
+    }
+    setpriority(PRIO_PROCESS, 0, old_priority);
+
+    if (r.result > 0.0)
+        bench_env_cpu_limits(&r);
+    bench_env_leave(&env, r.result > 0.0 ? &r : NULL);
+
+    return r;
+}
+
+static void do_benchmark(gint slot)
+{
+    const bench_kernel *kernel = bench_slots[slot].kernel;
 
     if (params.skip_benchmarks)
         return;
 
     if (params.gui_running) {
-        gchar *argv[] = {params.argv0, "-b",           entries[entry].name,
+        gchar *argv[] = {params.argv0, "-b",           (gchar *)kernel->name,
                          "-m",         "benchmark.so", "-a",
-                         NULL};
+                         NULL,         NULL,           NULL,
+                         NULL,         NULL};
+        gchar *max_load = NULL;
+        gint argc = 6;
         GPid bench_pid;
         gint bench_stdout;
         GtkWidget *bench_dialog;
@@ -632,10 +863,22 @@ static void do_benchmark(void (*benchmark_function)(void), int entry)
         gchar *bench_status;
 
         bench_value r = EMPTY_BENCH_VALUE;
-        bench_results[entry] = r;
+        bench_slots[slot].result = r;
+
+        /* the child does the actual run */
+        if (params.bench_controlled) {
+            argv[argc++] = "--bench-controlled";
+            if (params.bench_no_turbo)
+                argv[argc++] = "--bench-no-turbo";
+            max_load = g_strdup_printf("--bench-max-load=%f",
+                                       params.bench_max_load);
+            argv[argc++] = max_load;
+        }
+        if (params.bench_latency)
+            argv[argc++] = "--bench-latency";
 
         bench_status =
-            g_strdup_printf(_("Benchmarking: <b>%s</b>."), entries[entry].name);
+            g_strdup_printf(_("Benchmarking: <b>%s</b>."), _(kernel->name));
 
         shell_view_set_enabled(FALSE);
         shell_status_update(bench_status);
@@ -703,7 +946,7 @@ static void do_benchmark(void (*benchmark_function)(void), int entry)
                 kill(bench_pid, SIGINT);
             }
 
-            bench_results[entry] = benchmark_dialog->r;
+            bench_slots[slot].result = benchmark_dialog->r;
 
             g_io_channel_unref(channel);
             shell_view_set_enabled(TRUE);
@@ -711,6 +954,7 @@ static void do_benchmark(void (*benchmark_function)(void), int entry)
             gtk_widget_set_sensitive(
                 GTK_WIDGET(shell_get_main_shell()->transient_dialog), TRUE);
             g_free(benchmark_dialog);
+            g_free(max_load);
 
             shell_status_update(_("Done."));
 
@@ -719,20 +963,34 @@ static void do_benchmark(void (*benchmark_function)(void), int entry)
 
         gtk_widget_destroy(bench_dialog);
         g_free(benchmark_dialog);
+        g_free(max_load);
         shell_status_set_enabled(TRUE);
         shell_status_update(_("Done."));
     }
 
-    setpriority(PRIO_PROCESS, 0, -20);
-    benchmark_function();
-    setpriority(PRIO_PROCESS, 0, old_priority);
+    bench_slots[slot].result = bench_run_kernel(kernel, NULL);
 }
 
 gchar *hi_module_get_name(void) { return g_strdup(_("Benchmarks")); }
 
 guchar hi_module_get_weight(void) { return 240; }
 
-ModuleEntry *hi_module_get_entries(void) { return entries; }
+ModuleEntry *hi_module_get_entries(void)
+{
+    bench_registry_init();
+    return entries;
+}
+
+gchar *hi_module_get_summary(void)
+{
+    return g_strdup_printf("[%s]\n"
+                           "Icon=benchmark.png\n"
+                           "Method=benchmark::getCompositeScore\n"
+                           "[%s]\n"
+                           "Icon=benchmark.png\n"
+                           "Method=benchmark::getCategoryPercentiles\n",
+                           _("Composite Score"), _("Percentiles"));
+}
 
 const ModuleAbout *hi_module_get_about(void)
 {
@@ -746,6 +1004,49 @@ const ModuleAbout *hi_module_get_about(void)
     return &ma;
 }
 
+static void bench_json_add_result(JsonBuilder *builder,
+                                  bench_machine *this_machine,
+                                  const bench_value *r)
+{
+#define ADD_JSON_VALUE(type, name, value)                                      \
+    do {                                                                       \
+        json_builder_set_member_name(builder, (name));                         \
+        json_builder_add_##type##_value(builder, (value));                     \
+    } while (0)
+
+    ADD_JSON_VALUE(string, "Board", this_machine->board);
+    ADD_JSON_VALUE(int, "MemoryInKiB", this_machine->memory_kiB);
+    ADD_JSON_VALUE(string, "CpuName", this_machine->cpu_name);
+    ADD_JSON_VALUE(string, "CpuDesc", this_machine->cpu_desc);
+    ADD_JSON_VALUE(string, "CpuConfig", this_machine->cpu_config);
+    ADD_JSON_VALUE(string, "CpuConfig", this_machine->cpu_config);
+    ADD_JSON_VALUE(string, "OpenGlRenderer", this_machine->ogl_renderer);
+    ADD_JSON_VALUE(string, "GpuDesc", this_machine->gpu_desc);
+    ADD_JSON_VALUE(int, "NumCpus", this_machine->processors);
+    ADD_JSON_VALUE(int, "NumCores", this_machine->cores);
+    ADD_JSON_VALUE(int, "NumNodes", this_machine->nodes);
+    ADD_JSON_VALUE(int, "NumThreads", this_machine->threads);
+    ADD_JSON_VALUE(string, "MachineId", this_machine->mid);
+    ADD_JSON_VALUE(int, "PointerBits", this_machine->ptr_bits);
+    ADD_JSON_VALUE(boolean, "DataFromSuperUser", this_machine->is_su_data);
+    ADD_JSON_VALUE(int, "PhysicalMemoryInMiB",
+                   this_machine->memory_phys_MiB);
+    ADD_JSON_VALUE(string, "MemoryTypes", this_machine->ram_types);
+    ADD_JSON_VALUE(int, "MachineDataVersion",
+                   this_machine->machine_data_version);
+    ADD_JSON_VALUE(string, "MachineType", this_machine->machine_type);
+
+    ADD_JSON_VALUE(boolean, "Legacy", FALSE);
+    ADD_JSON_VALUE(string, "ExtraInfo", r->extra);
+    ADD_JSON_VALUE(string, "UserNote", r->user_note);
+    ADD_JSON_VALUE(double, "BenchmarkResult", r->result);
+    ADD_JSON_VALUE(double, "ElapsedTime", r->elapsed_time);
+    ADD_JSON_VALUE(int, "UsedThreads", r->threads_used);
+    ADD_JSON_VALUE(int, "BenchmarkVersion", r->revision);
+
+#undef ADD_JSON_VALUE
+}
+
 static gchar *get_benchmark_results(gsize *len)
 {
     void (*scan_callback)(gboolean);
@@ -756,69 +1057,33 @@ static gchar *get_benchmark_results(gsize *len)
     gchar *out;
     gint i;
 
-    for (i = 0; i < G_N_ELEMENTS(entries); i++) {
-        if (!entries[i].name || !entries[i].scan_callback)
-            continue;
+    for (i = 0; i < bench_n_slots; i++) {
         if (entries[i].flags & MODULE_FLAG_HIDE)
             continue;
 
         scan_callback = entries[i].scan_callback;
         if (scan_callback)
-            scan_callback(bench_results[i].result < 0.0);
+            scan_callback(bench_slots[i].result.result < 0.0);
     }
 
     this_machine = bench_machine_this();
     builder = json_builder_new();
     json_builder_begin_object(builder);
-    for (i = 0; i < G_N_ELEMENTS(entries); i++) {
-        if (!entries[i].name || entries[i].flags & MODULE_FLAG_HIDE)
+    for (i = 0; i < bench_n_slots; i++) {
+        const bench_value *r = &bench_slots[i].result;
+
+        if (entries[i].flags & MODULE_FLAG_HIDE)
             continue;
-        if (bench_results[i].result < 0.0) {
+        if (r->result < 0.0) {
             /* Benchmark failed? */
             continue;
         }
 
-        json_builder_set_member_name(builder, entries[i].name);
+        json_builder_set_member_name(builder, bench_slots[i].kernel->name);
 
         json_builder_begin_object(builder);
 
-#define ADD_JSON_VALUE(type, name, value)                                      \
-    do {                                                                       \
-        json_builder_set_member_name(builder, (name));                         \
-        json_builder_add_##type##_value(builder, (value));                     \
-    } while (0)
-
-        ADD_JSON_VALUE(string, "Board", this_machine->board);
-        ADD_JSON_VALUE(int, "MemoryInKiB", this_machine->memory_kiB);
-        ADD_JSON_VALUE(string, "CpuName", this_machine->cpu_name);
-        ADD_JSON_VALUE(string, "CpuDesc", this_machine->cpu_desc);
-        ADD_JSON_VALUE(string, "CpuConfig", this_machine->cpu_config);
-        ADD_JSON_VALUE(string, "CpuConfig", this_machine->cpu_config);
-        ADD_JSON_VALUE(string, "OpenGlRenderer", this_machine->ogl_renderer);
-        ADD_JSON_VALUE(string, "GpuDesc", this_machine->gpu_desc);
-        ADD_JSON_VALUE(int, "NumCpus", this_machine->processors);
-        ADD_JSON_VALUE(int, "NumCores", this_machine->cores);
-        ADD_JSON_VALUE(int, "NumNodes", this_machine->nodes);
-        ADD_JSON_VALUE(int, "NumThreads", this_machine->threads);
-        ADD_JSON_VALUE(string, "MachineId", this_machine->mid);
-        ADD_JSON_VALUE(int, "PointerBits", this_machine->ptr_bits);
-        ADD_JSON_VALUE(boolean, "DataFromSuperUser", this_machine->is_su_data);
-        ADD_JSON_VALUE(int, "PhysicalMemoryInMiB",
-                       this_machine->memory_phys_MiB);
-        ADD_JSON_VALUE(string, "MemoryTypes", this_machine->ram_types);
-        ADD_JSON_VALUE(int, "MachineDataVersion",
-                       this_machine->machine_data_version);
-        ADD_JSON_VALUE(string, "MachineType", this_machine->machine_type);
-
-        ADD_JSON_VALUE(boolean, "Legacy", FALSE);
-        ADD_JSON_VALUE(string, "ExtraInfo", bench_results[i].extra);
-        ADD_JSON_VALUE(string, "UserNote", bench_results[i].user_note);
-        ADD_JSON_VALUE(double, "BenchmarkResult", bench_results[i].result);
-        ADD_JSON_VALUE(double, "ElapsedTime", bench_results[i].elapsed_time);
-        ADD_JSON_VALUE(int, "UsedThreads", bench_results[i].threads_used);
-        ADD_JSON_VALUE(int, "BenchmarkVersion", bench_results[i].revision);
-
-#undef ADD_JSON_VALUE
+        bench_json_add_result(builder, this_machine, r);
 
         json_builder_end_object(builder);
     }
@@ -839,48 +1104,366 @@ static gchar *get_benchmark_results(gsize *len)
 
 static gchar *run_benchmark(gchar *name)
 {
-    int i;
+    void (*scan_callback)(gboolean rescan);
+    bench_value *r;
+    gint i;
 
     DEBUG("name = %s", name);
 
-    for (i = 0; entries[i].name; i++) {
-        if (g_str_equal(entries[i].name, name)) {
-            void (*scan_callback)(gboolean rescan);
+    i = bench_find_slot(name);
+    if (i < 0 || !(scan_callback = entries[i].scan_callback))
+        return NULL;
 
-            if ((scan_callback = entries[i].scan_callback)) {
-                scan_callback(FALSE);
+    scan_callback(FALSE);
+    r = &bench_slots[i].result;
 
 #define CHK_RESULT_FORMAT(F)                                                   \
     (params.result_format && strcmp(params.result_format, F) == 0)
 
-                if (params.run_benchmark) {
-                    /* attach the user note */
-                    if (params.bench_user_note)
-                        strncpy(bench_results[i].user_note,
-                                params.bench_user_note, 255);
-
-                    if (CHK_RESULT_FORMAT("shell")) {
-                        bench_result *b =
-                            bench_result_this_machine(name, bench_results[i]);
-                        char *temp = bench_result_more_info_complete(b);
-                        bench_result_free(b);
-                        return temp;
-                    }
-                    /* defaults to "short" which is below */
-                }
-
-                return bench_value_to_str(bench_results[i]);
-            }
+    if (params.run_benchmark) {
+        /* attach the user note */
+        if (params.bench_user_note)
+            strncpy(r->user_note, params.bench_user_note, 255);
+
+        if (CHK_RESULT_FORMAT("shell")) {
+            bench_result *b = bench_result_this_machine(name, *r);
+            char *temp = bench_result_more_info_complete(b);
+            bench_result_free(b);
+            return temp;
         }
+        /* defaults to "short" which is below */
     }
 
-    return NULL;
+    return bench_value_to_str(*r);
+}
+
+static void bench_print_json_line(JsonBuilder *builder)
+{
+    JsonGenerator *generator;
+    JsonNode *root;
+    gchar *out;
+
+    root = json_builder_get_root(builder);
+    generator = json_generator_new();
+    json_generator_set_root(generator, root);
+    json_generator_set_pretty(generator, FALSE);
+
+    out = json_generator_to_data(generator, NULL);
+    g_print("%s\n", out);
+    fflush(stdout);
+
+    g_free(out);
+    json_node_free(root);
+    g_object_unref(generator);
+}
+
+/* Runs every benchmark in a comma-separated list (or "all" that are not
+ * hidden) in this process, writing one JSON object per line to stdout as
+ * each one finishes. Returns the number of benchmarks that did not produce
+ * a result. */
+static gchar *run_benchmarks(gchar *list)
+{
+    bench_machine *this_machine;
+    gchar **names;
+    gint i, failed = 0;
+
+    if (g_str_equal(list, "all")) {
+        gint n = 0;
+
+        names = g_new0(gchar *, bench_n_slots + 1);
+        for (i = 0; i < bench_n_slots; i++) {
+            if (bench_slots[i].kernel->flags & MODULE_FLAG_HIDE)
+                continue;
+            names[n++] = g_strdup(bench_slots[i].kernel->name);
+        }
+    } else {
+        names = g_strsplit(list, ",", -1);
+    }
+
+    this_machine = bench_machine_this();
+
+    for (i = 0; names[i]; i++) {
+        const gchar *name = g_strstrip(names[i]);
+        const gchar *status;
+        JsonBuilder *builder;
+        gboolean timed_out;
+        bench_value r;
+        gint slot;
+
+        if (!*name)
+            continue;
+
+        builder = json_builder_new();
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "Benchmark");
+        json_builder_add_string_value(builder, name);
+
+        slot = bench_find_slot(name);
+        if (slot < 0) {
+            fprintf(stderr, _("Unknown benchmark ``%s''\n"), name);
+            json_builder_set_member_name(builder, "Status");
+            json_builder_add_string_value(builder, "unknown");
+            failed++;
+        } else {
+            r = bench_run_kernel(bench_slots[slot].kernel, &timed_out);
+            if (params.bench_user_note)
+                strncpy(r.user_note, params.bench_user_note, 255);
+            bench_slots[slot].result = r;
+
+            if (timed_out)
+                status = "timeout";
+            else if (r.result < 0.0)
+                status = "failed";
+            else
+                status = "ok";
+            if (r.result < 0.0)
+                failed++;
+
+            json_builder_set_member_name(builder, "Status");
+            json_builder_add_string_value(builder, status);
+            json_builder_set_member_name(builder, "HigherIsBetter");
+            json_builder_add_boolean_value(
+                builder, bench_slots[slot].kernel->higher_is_better);
+            bench_json_add_result(builder, this_machine, &r);
+        }
+
+        json_builder_end_object(builder);
+        bench_print_json_line(builder);
+        g_object_unref(builder);
+    }
+
+    bench_machine_free(this_machine);
+    g_strfreev(names);
+
+    return g_strdup_printf("%d", failed);
+}
+
+/* Baseline comparison: runs every benchmark found in a baseline, either
+ * written by get_benchmark_results() (a benchmark may also map to an array
+ * of runs) or the output of run_benchmarks(), params.bench_repeat times
+ * and reports the change of the mean. A change
+ * is significant if it is larger than twice the standard error of the
+ * difference; with a single run on both sides, there are no statistics
+ * and every change is taken at face value. */
+typedef struct {
+    gint n;
+    double mean, m2;
+} bench_stats;
+
+static void bench_stats_push(bench_stats *s, double x)
+{
+    double d = x - s->mean;
+
+    s->n++;
+    s->mean += d / s->n;
+    s->m2 += d * (x - s->mean);
+}
+
+static double bench_stats_var(const bench_stats *s)
+{
+    return s->n > 1 ? s->m2 / (s->n - 1) : 0.0;
+}
+
+static void bench_stats_push_json(bench_stats *s, JsonNode *node)
+{
+    JsonNode *result;
+
+    if (json_node_get_node_type(node) == JSON_NODE_ARRAY) {
+        JsonArray *runs = json_node_get_array(node);
+        guint i;
+
+        for (i = 0; i < json_array_get_length(runs); i++)
+            bench_stats_push_json(s, json_array_get_element(runs, i));
+        return;
+    }
+
+    if (json_node_get_node_type(node) != JSON_NODE_OBJECT)
+        return;
+    result = json_object_get_member(json_node_get_object(node),
+                                    "BenchmarkResult");
+    if (!result || !JSON_NODE_HOLDS_VALUE(result))
+        return;
+    if (json_node_get_value_type(result) != G_TYPE_DOUBLE &&
+        json_node_get_value_type(result) != G_TYPE_INT64)
+        return;
+    if (json_node_get_double(result) > 0.0)
+        bench_stats_push(s, json_node_get_double(result));
+}
+
+static gchar *bench_stats_format(const bench_stats *s)
+{
+    if (s->n > 1)
+        return g_strdup_printf("%.3f ±%.3f", s->mean, sqrt(bench_stats_var(s)));
+    return g_strdup_printf("%.3f", s->mean);
+}
+
+static void bench_baseline_push(GHashTable *baseline, const gchar *name,
+                                JsonNode *node)
+{
+    bench_stats *s = g_hash_table_lookup(baseline, name);
+
+    if (!s) {
+        s = g_new0(bench_stats, 1);
+        g_hash_table_insert(baseline, g_strdup(name), s);
+    }
+    bench_stats_push_json(s, node);
+}
+
+static void bench_baseline_member(JsonObject *object,
+                                  const gchar *member_name,
+                                  JsonNode *member_node,
+                                  gpointer user_data)
+{
+    bench_baseline_push(user_data, member_name, member_node);
+}
+
+/* benchmark name -> bench_stats */
+static GHashTable *bench_baseline_load(const gchar *path)
+{
+    GHashTable *baseline;
+    JsonParser *parser;
+    JsonNode *root;
+    gchar *contents, **lines;
+    gint i;
+
+    if (!g_file_get_contents(path, &contents, NULL, NULL))
+        return NULL;
+
+    baseline = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    parser = json_parser_new();
+
+    if (json_parser_load_from_data(parser, contents, -1, NULL) &&
+        (root = json_parser_get_root(parser)) &&
+        json_node_get_node_type(root) == JSON_NODE_OBJECT &&
+        !json_object_has_member(json_node_get_object(root), "Benchmark")) {
+        json_object_foreach_member(json_node_get_object(root),
+                                   bench_baseline_member, baseline);
+    } else {
+        /* one object per line, with the name in "Benchmark" */
+        lines = g_strsplit(contents, "\n", -1);
+        for (i = 0; lines[i]; i++) {
+            JsonObject *obj;
+            JsonNode *name;
+
+            if (!*g_strstrip(lines[i]))
+                continue;
+            if (!json_parser_load_from_data(parser, lines[i], -1, NULL))
+                continue;
+            root = json_parser_get_root(parser);
+            if (!root || json_node_get_node_type(root) != JSON_NODE_OBJECT)
+                continue;
+            obj = json_node_get_object(root);
+            name = json_object_get_member(obj, "Benchmark");
+            if (!name || !JSON_NODE_HOLDS_VALUE(name) ||
+                json_node_get_value_type(name) != G_TYPE_STRING)
+                continue;
+            bench_baseline_push(baseline, json_node_get_string(name), root);
+        }
+        g_strfreev(lines);
+    }
+
+    g_object_unref(parser);
+    g_free(contents);
+
+    return baseline;
+}
+
+static gchar *compare_benchmarks(gchar *path)
+{
+    GHashTable *baseline;
+    gint i, j, repeat, regressions = 0, compared = 0;
+
+    baseline = bench_baseline_load(path);
+    if (!baseline) {
+        fprintf(stderr, _("Cannot read baseline ``%s''\n"), path);
+        return g_strdup("-1");
+    }
+
+    repeat = MAX(params.bench_repeat, 1);
+
+    g_print("%-36s %20s %20s %9s\n", _("Benchmark"), _("Baseline"),
+            _("Current"), _("Change"));
+
+    for (i = 0; i < bench_n_slots; i++) {
+        const bench_kernel *k = bench_slots[i].kernel;
+        const bench_stats *base;
+        bench_stats cur = {0};
+        gboolean timed_out, better, crossed, significant;
+        gchar *base_str, *cur_str;
+        const gchar *verdict;
+        double delta, noise;
+
+        if (k->flags & MODULE_FLAG_HIDE)
+            continue;
+        base = g_hash_table_lookup(baseline, k->name);
+        if (!base || !base->n)
+            continue;
+        compared++;
+
+        for (j = 0; j < repeat; j++) {
+            bench_value r = bench_run_kernel(k, &timed_out);
+
+            bench_slots[i].result = r;
+            if (r.result > 0.0)
+                bench_stats_push(&cur, r.result);
+        }
+
+        base_str = bench_stats_format(base);
+        if (!cur.n) {
+            g_print("%-36s %20s %20s %9s  %s\n", k->name, base_str, "-", "-",
+                    _("FAILED"));
+            g_free(base_str);
+            regressions++;
+            continue;
+        }
+        cur_str = bench_stats_format(&cur);
+
+        delta = 100.0 * (cur.mean - base->mean) / base->mean;
+        better = k->higher_is_better ? delta > 0.0 : delta < 0.0;
+        crossed = fabs(delta) >= params.compare_threshold;
+        noise = 2.0 * sqrt(bench_stats_var(base) / base->n +
+                           bench_stats_var(&cur) / cur.n);
+        significant = (base->n > 1 || cur.n > 1)
+                          ? fabs(cur.mean - base->mean) > noise
+                          : TRUE;
+
+        if (!crossed)
+            verdict = _("ok");
+        else if (!significant)
+            verdict = _("ok (within noise)");
+        else if (better)
+            verdict = _("improved");
+        else
+            verdict = _("REGRESSION");
+
+        if (crossed && significant && !better)
+            regressions++;
+
+        g_print("%-36s %20s %20s %+8.2f%%  %s\n", k->name, base_str, cur_str,
+                delta, verdict);
+
+        g_free(base_str);
+        g_free(cur_str);
+    }
+
+    g_hash_table_destroy(baseline);
+
+    if (!compared) {
+        fprintf(stderr, _("No known benchmarks in baseline ``%s''\n"), path);
+        return g_strdup("-1");
+    }
+
+    return g_strdup_printf("%d", regressions);
 }
 
 const ShellModuleMethod *hi_exported_methods(void)
 {
     static const ShellModuleMethod m[] = {
         {"runBenchmark", run_benchmark},
+        {"runBenchmarks", run_benchmarks},
+        {"compareBenchmarks", compare_benchmarks},
+        {"getCompositeScore", get_composite_score},
+        {"getCategoryPercentiles", get_category_percentiles},
         {NULL},
     };
 
@@ -904,9 +1487,13 @@ void hi_module_init(void)
     sync_manager_add_entry(&se[0]);
     sync_manager_add_entry(&se[1]);
 
-    int i;
-    for (i = 0; i < G_N_ELEMENTS(entries) - 1 /* account for NULL */; i++)
-        bench_results[i] = (bench_value)EMPTY_BENCH_VALUE;
+    bench_registry_init();
+}
+
+void hi_module_deinit(void)
+{
+    bench_store_release();
+    bench_registry_deinit();
 }
 
 gchar **hi_module_get_dependencies(void)
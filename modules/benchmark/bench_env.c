@@ -0,0 +1,381 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Controlled runs (--bench-controlled): before a kernel runs, the cpufreq
+ * governor is set to performance, turbo is optionally disabled, the page
+ * cache is dropped for storage kernels, and the run is refused if the
+ * system is already busy; everything is put back afterwards, also when
+ * the run is interrupted (the GUI's Cancel sends SIGINT). Inside the run,
+ * memory is locked, which also prefaults the buffers if the limit allows.
+ *
+ * Most of this needs root; whatever is actually in effect is appended to
+ * bench_value.extra, e.g. "gov:performance turbo:off load:0.08 mlock". */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+#define BENCH_CPU_SYSFS "/sys/devices/system/cpu"
+
+typedef struct {
+    gchar *path;
+    gchar *value;
+} bench_env_knob;
+
+typedef struct {
+    GSList *saved; /* bench_env_knob, to be restored */
+    gchar *desc;   /* settings in effect */
+} bench_env;
+
+/* what to clean up if the run is interrupted: the environment to put
+ * back, and the process group of an isolated run (bench_kernel_run_isolated()
+ * puts the child in its own group, so it isn't sent the terminal's ^C) */
+static bench_env *bench_env_active;
+static volatile pid_t bench_env_child;
+static gboolean bench_env_catching;
+static struct sigaction bench_env_old_actions[3];
+static const int bench_env_signals[] = { SIGINT, SIGTERM, SIGHUP };
+
+static gchar *bench_env_read(const gchar *path)
+{
+    gchar *value;
+
+    if (!g_file_get_contents(path, &value, NULL, NULL))
+        return NULL;
+    return g_strstrip(value);
+}
+
+/* g_file_set_contents() can't be used for sysfs/procfs */
+static gboolean bench_env_write(const gchar *path, const gchar *value)
+{
+    FILE *f = fopen(path, "w");
+    gboolean ok;
+
+    if (!f)
+        return FALSE;
+    ok = fputs(value, f) >= 0;
+    return (fclose(f) == 0) && ok;
+}
+
+/* remembers the old value if the new one could be written */
+static gboolean bench_env_set(bench_env *env, const gchar *path,
+                              const gchar *value)
+{
+    bench_env_knob *knob;
+    gchar *old = bench_env_read(path);
+
+    if (!old)
+        return FALSE;
+    if (g_str_equal(old, value)) {
+        g_free(old);
+        return TRUE;
+    }
+    if (!bench_env_write(path, value)) {
+        g_free(old);
+        return FALSE;
+    }
+
+    knob = g_new(bench_env_knob, 1);
+    knob->path = g_strdup(path);
+    knob->value = old;
+    env->saved = g_slist_prepend(env->saved, knob);
+
+    return TRUE;
+}
+
+/* only async-signal-safe calls from here on; the knob list is complete
+ * whenever the signal can arrive, as bench_env_set() prepends to it */
+static void bench_env_restore_on_signal(int sig)
+{
+    GSList *l;
+
+    if (bench_env_child > 0)
+        kill(-bench_env_child, SIGKILL);
+    if (!bench_env_active)
+        goto out;
+
+    for (l = bench_env_active->saved; l; l = l->next) {
+        bench_env_knob *knob = l->data;
+        int fd = open(knob->path, O_WRONLY);
+
+        if (fd < 0)
+            continue;
+        if (write(fd, knob->value, strlen(knob->value)) < 0) {
+            /* nothing else can be done from here */
+        }
+        close(fd);
+    }
+
+out:
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static void bench_env_catch_signals(void)
+{
+    struct sigaction sa;
+    guint i;
+
+    if (bench_env_catching)
+        return;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = bench_env_restore_on_signal;
+    sigemptyset(&sa.sa_mask);
+    for (i = 0; i < G_N_ELEMENTS(bench_env_signals); i++)
+        sigaddset(&sa.sa_mask, bench_env_signals[i]);
+
+    for (i = 0; i < G_N_ELEMENTS(bench_env_signals); i++)
+        sigaction(bench_env_signals[i], &sa, &bench_env_old_actions[i]);
+    bench_env_catching = TRUE;
+}
+
+/* once there's nothing left to clean up */
+static void bench_env_release_signals(void)
+{
+    guint i;
+
+    if (!bench_env_catching || bench_env_active || bench_env_child > 0)
+        return;
+    for (i = 0; i < G_N_ELEMENTS(bench_env_signals); i++)
+        sigaction(bench_env_signals[i], &bench_env_old_actions[i], NULL);
+    bench_env_catching = FALSE;
+}
+
+static void bench_env_note(bench_env *env, const gchar *fmt, ...)
+{
+    gchar *item;
+    va_list args;
+
+    va_start(args, fmt);
+    item = g_strdup_vprintf(fmt, args);
+    va_end(args);
+
+    env->desc = appf(env->desc, " ", "%s", item);
+    g_free(item);
+}
+
+/* list of cpu<N>/cpufreq/<file> */
+static GSList *bench_env_cpufreq_files(const gchar *file)
+{
+    GSList *files = NULL;
+    const gchar *name;
+    GDir *dir;
+
+    dir = g_dir_open(BENCH_CPU_SYSFS, 0, NULL);
+    if (!dir)
+        return NULL;
+
+    while ((name = g_dir_read_name(dir))) {
+        gchar *path;
+
+        if (!g_str_has_prefix(name, "cpu") || !g_ascii_isdigit(name[3]))
+            continue;
+        path = g_build_filename(BENCH_CPU_SYSFS, name, "cpufreq", file, NULL);
+        if (g_file_test(path, G_FILE_TEST_EXISTS))
+            files = g_slist_prepend(files, path);
+        else
+            g_free(path);
+    }
+    g_dir_close(dir);
+
+    return files;
+}
+
+static void bench_env_governor(bench_env *env)
+{
+    GSList *files, *l;
+    gchar *in_effect = NULL;
+
+    files = bench_env_cpufreq_files("scaling_governor");
+    if (!files)
+        return;
+
+    for (l = files; l; l = l->next) {
+        gchar *gov;
+
+        bench_env_set(env, l->data, "performance");
+
+        gov = bench_env_read(l->data);
+        if (!in_effect) {
+            in_effect = gov;
+        } else if (gov && !g_str_equal(gov, in_effect)) {
+            g_free(in_effect);
+            g_free(gov);
+            in_effect = g_strdup("mixed");
+            break;
+        } else {
+            g_free(gov);
+        }
+    }
+    g_slist_free_full(files, g_free);
+
+    bench_env_note(env, "gov:%s", in_effect ? in_effect : "?");
+    g_free(in_effect);
+}
+
+static void bench_env_turbo(bench_env *env)
+{
+    static const struct {
+        const gchar *path;
+        const gchar *off;
+    } knobs[] = {
+        {BENCH_CPU_SYSFS "/intel_pstate/no_turbo", "1"},
+        {BENCH_CPU_SYSFS "/cpufreq/boost", "0"},
+    };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(knobs); i++) {
+        gchar *value;
+
+        if (!g_file_test(knobs[i].path, G_FILE_TEST_EXISTS))
+            continue;
+
+        if (params.bench_no_turbo)
+            bench_env_set(env, knobs[i].path, knobs[i].off);
+
+        value = bench_env_read(knobs[i].path);
+        bench_env_note(env, "turbo:%s",
+                       value && g_str_equal(value, knobs[i].off) ? "off" : "on");
+        g_free(value);
+        return;
+    }
+}
+
+/* Returns FALSE if the kernel should not run; the environment must be
+ * restored with bench_env_leave() in any case. */
+static gboolean bench_env_enter(bench_env *env, const bench_kernel *k)
+{
+    double load, max_load = params.bench_max_load;
+
+    memset(env, 0, sizeof(*env));
+
+    if (!params.bench_controlled)
+        return TRUE;
+
+    bench_env_active = env;
+    bench_env_catch_signals();
+
+    /* by default, busy means every CPU this process can use is taken */
+    if (max_load < 0.0) {
+        cpu_limits lim;
+
+        cpu_limits_get(&lim);
+        max_load = MAX(lim.effective, 1);
+    }
+
+    if (getloadavg(&load, 1) == 1) {
+        bench_env_note(env, "load:%.2f", load);
+        if (max_load > 0.0 && load > max_load) {
+            bench_msg("load average is %.2f (limit %.2f); not running ``%s''",
+                      load, max_load, k->name);
+            return FALSE;
+        }
+    }
+
+    bench_env_governor(env);
+    bench_env_turbo(env);
+
+    if (k->category == BENCH_CATEGORY_STORAGE) {
+        sync();
+        bench_env_note(env, "%s",
+                       bench_env_write("/proc/sys/vm/drop_caches", "3")
+                           ? "dropcache"
+                           : "cache:warm");
+    }
+
+    return TRUE;
+}
+
+static void bench_env_append(bench_value *r, const gchar *desc)
+{
+    if (!desc || !*desc)
+        return;
+    if (*r->extra)
+        g_strlcat(r->extra, " ", sizeof(r->extra));
+    g_strlcat(r->extra, desc, sizeof(r->extra));
+}
+
+/* Not part of --bench-controlled: a result from a container limited to a
+ * few CPUs says so, e.g. "cpus:4/96 cgroup:400000/100000". */
+static void bench_env_cpu_limits(bench_value *r)
+{
+    cpu_limits lim;
+    gchar *desc = NULL;
+
+    cpu_limits_get(&lim);
+    if (lim.effective >= lim.threads)
+        return;
+
+    desc = appf(desc, " ", "cpus:%d/%d", lim.effective, lim.threads);
+    if (lim.affinity >= 0 && lim.affinity < lim.threads)
+        desc = appf(desc, " ", "affinity:%d", lim.affinity);
+    if (lim.quota > 0)
+        desc = appf(desc, " ", "cgroup:%ld/%ld", lim.quota, lim.period);
+
+    bench_env_append(r, desc);
+    g_free(desc);
+}
+
+static void bench_env_leave(bench_env *env, bench_value *r)
+{
+    GSList *l;
+
+    if (bench_env_active == env) {
+        bench_env_active = NULL;
+        bench_env_release_signals();
+    }
+
+    /* in the reverse order they were changed */
+    for (l = env->saved; l; l = l->next) {
+        bench_env_knob *knob = l->data;
+
+        if (!bench_env_write(knob->path, knob->value))
+            bench_msg("could not restore %s to %s", knob->path, knob->value);
+        g_free(knob->path);
+        g_free(knob->value);
+        g_free(knob);
+    }
+    g_slist_free(env->saved);
+
+    if (r)
+        bench_env_append(r, env->desc);
+    g_free(env->desc);
+    memset(env, 0, sizeof(*env));
+}
+
+/* Called in the process running the kernel (mlockall() isn't inherited by
+ * fork()). With MCL_FUTURE, buffers allocated afterwards are locked and
+ * faulted in as soon as they are mapped, but then every allocation past
+ * RLIMIT_MEMLOCK fails; so that's only asked for when there's no limit. */
+static gboolean bench_env_lock_memory(void)
+{
+    struct rlimit rl;
+    int flags = MCL_CURRENT;
+
+    if (!params.bench_controlled)
+        return FALSE;
+    if (geteuid() == 0 ||
+        (getrlimit(RLIMIT_MEMLOCK, &rl) == 0 && rl.rlim_cur == RLIM_INFINITY))
+        flags |= MCL_FUTURE;
+    if (mlockall(flags) < 0) {
+        DEBUG("mlockall() failed: %s", g_strerror(errno));
+        return FALSE;
+    }
+    return TRUE;
+}
@@ -0,0 +1,191 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Work unit latency (--bench-latency): with it, each call of a crunch
+ * benchmark's callback is timed and counted in a histogram of the thread
+ * running it; the histograms are merged when the threads are joined.
+ *
+ * The histogram is log-linear, like HdrHistogram: values below
+ * BENCH_HIST_SUB are exact, then every power of two is split in
+ * BENCH_HIST_HALF buckets, so a bucket is within 1.6% of its values, from
+ * 1ns to 2^BENCH_HIST_MAX_BITS ns (~18 minutes), in a fixed 9KiB. */
+
+#include <math.h>
+#include <time.h>
+
+#define BENCH_HIST_SUB_BITS 6
+#define BENCH_HIST_SUB (1 << BENCH_HIST_SUB_BITS)
+#define BENCH_HIST_HALF (BENCH_HIST_SUB / 2)
+#define BENCH_HIST_MAX_BITS 40
+#define BENCH_HIST_N                                                           \
+    ((BENCH_HIST_MAX_BITS - BENCH_HIST_SUB_BITS + 2) * BENCH_HIST_HALF)
+
+typedef struct {
+    guint64 counts[BENCH_HIST_N];
+    guint64 n, min, max;
+} bench_hist;
+
+/* summary of the last benchmark_crunch_for() with --bench-latency, picked
+ * up by bench_kernel_run() */
+static gchar *bench_hist_last = NULL;
+
+static inline guint64 bench_hist_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (guint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static guint bench_hist_index(guint64 v)
+{
+    gint shift;
+
+    if (v < BENCH_HIST_SUB)
+        return (guint)v;
+    if (v >> BENCH_HIST_MAX_BITS)
+        return BENCH_HIST_N - 1;
+
+    /* keep the top BENCH_HIST_SUB_BITS bits */
+    shift = (63 - __builtin_clzll(v)) - (BENCH_HIST_SUB_BITS - 1);
+    return shift * BENCH_HIST_HALF + (guint)(v >> shift);
+}
+
+/* middle of the bucket */
+static guint64 bench_hist_value(guint i)
+{
+    gint shift;
+
+    if (i < BENCH_HIST_SUB)
+        return i;
+
+    shift = i / BENCH_HIST_HALF - 1;
+    return ((guint64)(i - shift * BENCH_HIST_HALF) << shift) +
+           ((guint64)1 << (shift - 1));
+}
+
+static void bench_hist_record(bench_hist *h, guint64 v)
+{
+    h->counts[bench_hist_index(v)]++;
+    if (!h->n || v < h->min)
+        h->min = v;
+    if (v > h->max)
+        h->max = v;
+    h->n++;
+}
+
+static void bench_hist_merge(bench_hist *into, const bench_hist *h)
+{
+    guint i;
+
+    if (!h->n)
+        return;
+    for (i = 0; i < BENCH_HIST_N; i++)
+        into->counts[i] += h->counts[i];
+    if (!into->n || h->min < into->min)
+        into->min = h->min;
+    if (h->max > into->max)
+        into->max = h->max;
+    into->n += h->n;
+}
+
+/* value at or below which pct percent of the samples are */
+static guint64 bench_hist_percentile(const bench_hist *h, double pct)
+{
+    guint64 want, seen = 0;
+    guint i;
+
+    if (!h->n)
+        return 0;
+
+    want = (guint64)ceil(pct / 100.0 * h->n);
+    if (want < 1)
+        want = 1;
+
+    for (i = 0; i < BENCH_HIST_N; i++) {
+        seen += h->counts[i];
+        if (seen >= want)
+            return CLAMP(bench_hist_value(i), h->min, h->max);
+    }
+    return h->max;
+}
+
+static gchar *bench_hist_ns_str(guint64 ns)
+{
+    if (ns < 10000)
+        return g_strdup_printf("%" G_GUINT64_FORMAT "ns", ns);
+    if (ns < 10000000)
+        return g_strdup_printf("%.1fus", ns / 1e3);
+    if (ns < G_GUINT64_CONSTANT(10000000000))
+        return g_strdup_printf("%.1fms", ns / 1e6);
+    return g_strdup_printf("%.1fs", ns / 1e9);
+}
+
+/* Merges the per-thread histograms; the summary goes in bench_hist_last,
+ * e.g. "p50:1.2us p90:1.3us p99:2.0us p99.9:45.1us p99@threads:1.9us-2.4us",
+ * the last one being the range of the threads' own p99. */
+static void bench_hist_summarize(bench_hist **hists, gint n_threads)
+{
+    static const double pcts[] = {50.0, 90.0, 99.0, 99.9};
+    bench_hist *all = g_new0(bench_hist, 1);
+    guint64 lo = 0, hi = 0;
+    gchar *desc = NULL, *a, *b;
+    guint i;
+    gint t;
+
+    for (t = 0; t < n_threads; t++) {
+        guint64 p99;
+
+        if (!hists[t]->n)
+            continue;
+        bench_hist_merge(all, hists[t]);
+
+        p99 = bench_hist_percentile(hists[t], 99.0);
+        if (!lo || p99 < lo)
+            lo = p99;
+        if (p99 > hi)
+            hi = p99;
+
+        DEBUG("thread %d: %" G_GUINT64_FORMAT " units, p50 %" G_GUINT64_FORMAT
+              "ns, p99 %" G_GUINT64_FORMAT "ns",
+              t, hists[t]->n, bench_hist_percentile(hists[t], 50.0), p99);
+    }
+
+    g_free(bench_hist_last);
+    bench_hist_last = NULL;
+
+    if (all->n) {
+        for (i = 0; i < G_N_ELEMENTS(pcts); i++) {
+            a = bench_hist_ns_str(bench_hist_percentile(all, pcts[i]));
+            desc = appf(desc, " ", "p%g:%s", pcts[i], a);
+            g_free(a);
+        }
+        if (n_threads > 1) {
+            a = bench_hist_ns_str(lo);
+            b = bench_hist_ns_str(hi);
+            desc = appf(desc, " ", "p99@threads:%s-%s", a, b);
+            g_free(a);
+            g_free(b);
+        }
+
+        bench_msg("%" G_GUINT64_FORMAT " work units: %s", all->n, desc);
+        bench_hist_last = desc;
+    }
+
+    g_free(all);
+}
@@ -230,6 +230,16 @@ bench_result *bench_result_this_machine(const char *bench_name, bench_value r)
     return b;
 }
 
+gint bench_result_sort(gconstpointer a, gconstpointer b)
+{
+    bench_result *A = (bench_result *)a, *B = (bench_result *)b;
+    if (A->bvalue.result < B->bvalue.result)
+        return -1;
+    if (A->bvalue.result > B->bvalue.result)
+        return 1;
+    return 0;
+}
+
 /* -1 for none */
 static int nx_prefix(const char *str)
 {
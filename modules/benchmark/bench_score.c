@@ -0,0 +1,279 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Composite score: the geometric mean, over every benchmark this machine
+ * has a result for, of that result normalized to a reference machine
+ * (> 1 is always better, whichever way the benchmark goes). The reference
+ * is the median of the loaded results matching --bench-reference (machine
+ * id or part of the CPU name), or the median of all of them.
+ *
+ * Percentiles are against all loaded results of a benchmark; a category's
+ * percentile is the mean of its benchmarks' percentiles. */
+
+#include <math.h>
+
+static const char *bench_category_names[BENCH_CATEGORY_N] = {
+    [BENCH_CATEGORY_NONE] = N_("Other"),
+    [BENCH_CATEGORY_INTEGER] = N_("Integer"),
+    [BENCH_CATEGORY_FP] = N_("Floating Point"),
+    [BENCH_CATEGORY_MEMORY] = N_("Memory"),
+    [BENCH_CATEGORY_STORAGE] = N_("Storage"),
+};
+
+typedef struct {
+    gint n;          /* benchmarks with a normalized result */
+    double log_sum;
+    gint n_pct;      /* benchmarks with a percentile */
+    double pct_sum;
+} bench_score_acc;
+
+typedef struct {
+    double normalized[BENCH_MAX_KERNELS]; /* 0 if unknown */
+    double percentile[BENCH_MAX_KERNELS]; /* < 0 if unknown */
+    guint n_results[BENCH_MAX_KERNELS];
+    bench_score_acc total;
+    bench_score_acc category[BENCH_CATEGORY_N];
+} bench_score;
+
+static double bench_score_acc_mean(const bench_score_acc *acc)
+{
+    return acc->n ? exp(acc->log_sum / acc->n) : 0.0;
+}
+
+static double bench_score_acc_percentile(const bench_score_acc *acc)
+{
+    return acc->n_pct ? acc->pct_sum / acc->n_pct : -1.0;
+}
+
+static gboolean bench_score_reference(const bench_store *store,
+                                      const bench_store_section *section,
+                                      double *ref)
+{
+    const bench_store_record *recs = bench_store_records(store, section);
+    const gchar *want = params.bench_reference;
+    GArray *matches;
+    gchar *needle;
+    guint i;
+
+    if (!section->n_records)
+        return FALSE;
+
+    if (!want || !*want) {
+        *ref = recs[section->n_records / 2].result;
+        return *ref > 0.0;
+    }
+
+    /* records are sorted, so the matches are too */
+    needle = g_utf8_casefold(want, -1);
+    matches = g_array_new(FALSE, FALSE, sizeof(double));
+    for (i = 0; i < section->n_records; i++) {
+        if (g_str_equal(bench_store_str(store, recs[i].mid), want) ||
+            bench_store_str_contains(store, recs[i].cpu_name, needle))
+            g_array_append_val(matches, recs[i].result);
+    }
+    g_free(needle);
+
+    *ref = matches->len ? g_array_index(matches, double, matches->len / 2)
+                        : 0.0;
+    g_array_free(matches, TRUE);
+
+    return *ref > 0.0;
+}
+
+static void bench_score_compute(bench_score *sc)
+{
+    const bench_store *store;
+    gint i;
+
+    memset(sc, 0, sizeof(*sc));
+    store = bench_store_get();
+
+    for (i = 0; i < bench_n_slots; i++) {
+        const bench_kernel *k = bench_slots[i].kernel;
+        const bench_store_section *section;
+        double value = bench_slots[i].result.result;
+        double ref;
+        guint n, below, above;
+        gint cat;
+
+        sc->percentile[i] = -1.0;
+
+        /* only what the page lists counts */
+        if (k->flags & MODULE_FLAG_HIDE)
+            continue;
+        if (value <= 0.0 || !store)
+            continue;
+        section = bench_store_find_section(store, k->name);
+        if (!section || !section->n_records)
+            continue;
+
+        cat = (k->category > 0 && k->category < BENCH_CATEGORY_N) ? k->category
+                                                                  : 0;
+
+        if (bench_score_reference(store, section, &ref)) {
+            sc->normalized[i] = k->higher_is_better ? value / ref : ref / value;
+            sc->total.n++;
+            sc->total.log_sum += log(sc->normalized[i]);
+            sc->category[cat].n++;
+            sc->category[cat].log_sum += log(sc->normalized[i]);
+        }
+
+        /* ties count as half */
+        n = section->n_records;
+        below = bench_store_rank(store, section, value);
+        above = n - bench_store_rank_upper(store, section, value);
+        sc->n_results[i] = n;
+        sc->percentile[i] =
+            100.0 * ((k->higher_is_better ? below : above) +
+                     (n - below - above) / 2.0) / n;
+        sc->total.n_pct++;
+        sc->total.pct_sum += sc->percentile[i];
+        sc->category[cat].n_pct++;
+        sc->category[cat].pct_sum += sc->percentile[i];
+    }
+
+    bench_store_unref(store);
+}
+
+static gchar *bench_score_reference_desc(void)
+{
+    if (params.bench_reference && *params.bench_reference)
+        return g_strdup(params.bench_reference);
+    return g_strdup(_("Median of the loaded results"));
+}
+
+static gchar *callback_bench_score(void)
+{
+    bench_score sc;
+    GString *categories, *benches;
+    gchar *ret, *ref, *pct_str;
+    gint i, n_run = 0, n_visible = 0;
+    double pct;
+
+    bench_score_compute(&sc);
+
+    for (i = 0; i < bench_n_slots; i++) {
+        if (bench_slots[i].result.result > 0.0)
+            n_run++;
+    }
+    if (!n_run)
+        return g_strdup_printf("[%s]\n%s=%s\n", _("Composite Score"),
+                               _("Score"), _("(Run some benchmarks first)"));
+    n_run = 0;
+
+    categories = g_string_new(NULL);
+    benches = g_string_new(NULL);
+
+    for (i = 0; i < BENCH_CATEGORY_N; i++) {
+        pct = bench_score_acc_percentile(&sc.category[i]);
+        if (!sc.category[i].n && pct < 0.0)
+            continue;
+
+        pct_str = pct < 0.0 ? g_strdup(_("(Unknown)"))
+                            : g_strdup_printf(_("%.1f percentile"), pct);
+        g_string_append_printf(categories, "%s=%.3f|%s\n",
+                                      _(bench_category_names[i]),
+                                      bench_score_acc_mean(&sc.category[i]),
+                                      pct_str);
+        g_free(pct_str);
+    }
+
+    for (i = 0; i < bench_n_slots; i++) {
+        const bench_kernel *k = bench_slots[i].kernel;
+
+        if (k->flags & MODULE_FLAG_HIDE)
+            continue;
+        n_visible++;
+        if (bench_slots[i].result.result <= 0.0)
+            continue;
+        n_run++;
+
+        if (sc.percentile[i] < 0.0) {
+            g_string_append_printf(benches, "%s=%s\n", _(k->name),
+                                       _("(No reference results)"));
+        } else {
+            pct_str = g_strdup_printf(_("%.1f percentile of %u"),
+                                      sc.percentile[i], sc.n_results[i]);
+
+            g_string_append_printf(benches, "%s=%.3f|%s\n", _(k->name),
+                                       sc.normalized[i], pct_str);
+            g_free(pct_str);
+        }
+    }
+
+    ref = bench_score_reference_desc();
+    pct = bench_score_acc_percentile(&sc.total);
+    pct_str = pct < 0.0 ? g_strdup(_("(Unknown)")) : g_strdup_printf("%.1f", pct);
+    ret = g_strdup_printf("[%s]\n"
+                          "%s=%.3f\n"
+                          "%s=%s\n"
+                          "%s=%s\n"
+                          "%s=%d/%d\n"
+                          "[%s]\n%s"
+                          "[%s]\n%s",
+                          _("Composite Score"),
+                          _("Score"), bench_score_acc_mean(&sc.total),
+                          _("Percentile"), pct_str,
+                          _("Reference"), ref,
+                          _("Benchmarks"), n_run, n_visible,
+                          _("Categories"), categories->str,
+                          _("Benchmarks"), benches->str);
+
+    g_free(ref);
+    g_free(pct_str);
+    g_string_free(categories, TRUE);
+    g_string_free(benches, TRUE);
+
+    return ret;
+}
+
+/* for the module summary */
+static gchar *get_composite_score(void)
+{
+    bench_score sc;
+
+    bench_score_compute(&sc);
+    if (!sc.total.n)
+        return g_strdup(_("(Unknown)"));
+
+    return g_strdup_printf(_("%.3f (%d benchmarks)"),
+                           bench_score_acc_mean(&sc.total), sc.total.n);
+}
+
+static gchar *get_category_percentiles(void)
+{
+    bench_score sc;
+    GString *ret = g_string_new(NULL);
+    gint i;
+
+    bench_score_compute(&sc);
+    for (i = 0; i < BENCH_CATEGORY_N; i++) {
+        double pct = bench_score_acc_percentile(&sc.category[i]);
+
+        if (pct < 0.0)
+            continue;
+        if (ret->len)
+            g_string_append_c(ret, '\n');
+        g_string_append_printf(ret, "%s: %.1f", _(bench_category_names[i]),
+                               pct);
+    }
+
+    if (!ret->len)
+        g_string_append(ret, _("(Unknown)"));
+    return g_string_free(ret, FALSE);
+}
@@ -0,0 +1,744 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Binary, mmap()-able index of benchmark.json, so showing a benchmark page
+ * doesn't parse the whole file again.
+ *
+ * Layout (host endianness; it is only a cache):
+ *    bench_store_header
+ *    bench_store_section[n_sections]     sorted by name
+ *    bench_store_record[...]             per section, sorted by result
+ *    string pool                         NUL-terminated, deduplicated;
+ *                                        offset 0 is ""
+ *
+ * The header records the path, mtime and size of the JSON file it was
+ * built from (and the locale, as some strings are translated while
+ * parsing); if any of these change, e.g. after a sync, it is rebuilt. */
+
+#include <sys/stat.h>
+#include <glib/gstdio.h>
+
+#define BENCH_STORE_MAGIC "HIBENCH"
+#define BENCH_STORE_VERSION 1
+
+typedef struct {
+    char magic[8];
+    guint32 version;
+    guint32 n_sections;
+    gint64 src_mtime;
+    guint64 src_size;
+    guint32 src_path;
+    guint32 locale;
+    guint32 strings_offset;
+    guint32 strings_size;
+} bench_store_header;
+
+typedef struct {
+    guint32 name;
+    guint32 n_records;
+    guint32 records_offset;
+    guint32 reserved;
+} bench_store_section;
+
+typedef struct {
+    double result;
+    double elapsed_time;
+    guint64 memory_kiB;
+    guint64 memory_phys_MiB;
+    gint32 threads_used, revision;
+    gint32 processors, cores, threads, nodes;
+    gint32 ptr_bits, is_su_data, machine_data_version, legacy;
+    guint32 extra, user_note;
+    guint32 board, cpu_name, cpu_desc, cpu_config;
+    guint32 ogl_renderer, gpu_desc, mid, ram_types, machine_type;
+    guint32 reserved;
+} bench_store_record;
+
+typedef struct {
+    gint ref;
+    GMappedFile *file; /* or... */
+    GBytes *bytes;     /* ...if the cache couldn't be written */
+    const gchar *data;
+    gsize len;
+    const bench_store_header *hdr;
+    const bench_store_section *sections;
+} bench_store;
+
+/* replaced when benchmark.json changes, while pages may still be built
+ * from the old one on the scan pool; hence the references */
+static bench_store *bench_store_current = NULL;
+static GMutex bench_store_mutex;
+
+static const gchar *bench_store_str(const bench_store *store, guint32 offset)
+{
+    if (offset >= store->hdr->strings_size)
+        return "";
+    return store->data + store->hdr->strings_offset + offset;
+}
+
+static const bench_store_record *
+bench_store_records(const bench_store *store, const bench_store_section *s)
+{
+    return (const bench_store_record *)(store->data + s->records_offset);
+}
+
+static void bench_store_free(bench_store *store)
+{
+    if (!store)
+        return;
+    if (store->file)
+        g_mapped_file_unref(store->file);
+    if (store->bytes)
+        g_bytes_unref(store->bytes);
+    g_free(store);
+}
+
+static const bench_store *bench_store_ref(bench_store *store)
+{
+    g_atomic_int_inc(&store->ref);
+    return store;
+}
+
+static void bench_store_unref(const bench_store *store)
+{
+    bench_store *s = (bench_store *)store;
+
+    if (s && g_atomic_int_dec_and_test(&s->ref))
+        bench_store_free(s);
+}
+
+static gboolean bench_store_validate(bench_store *store)
+{
+    const bench_store_header *hdr;
+    guint32 i;
+
+    if (store->len < sizeof(bench_store_header))
+        return FALSE;
+
+    hdr = (const bench_store_header *)store->data;
+    if (memcmp(hdr->magic, BENCH_STORE_MAGIC, sizeof(BENCH_STORE_MAGIC)) != 0)
+        return FALSE;
+    if (hdr->version != BENCH_STORE_VERSION)
+        return FALSE;
+    if (hdr->n_sections >
+        (store->len - sizeof(bench_store_header)) / sizeof(bench_store_section))
+        return FALSE;
+    if (hdr->strings_size == 0 || hdr->strings_offset > store->len ||
+        hdr->strings_size > store->len - hdr->strings_offset)
+        return FALSE;
+    if (store->data[hdr->strings_offset + hdr->strings_size - 1] != '\0')
+        return FALSE;
+
+    store->hdr = hdr;
+    store->sections = (const bench_store_section *)(hdr + 1);
+
+    for (i = 0; i < hdr->n_sections; i++) {
+        const bench_store_section *s = &store->sections[i];
+
+        if (s->records_offset < sizeof(bench_store_header) +
+                                     hdr->n_sections * sizeof(bench_store_section) ||
+            s->records_offset > hdr->strings_offset ||
+            s->n_records > (hdr->strings_offset - s->records_offset) /
+                               sizeof(bench_store_record))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean bench_store_is_current(const bench_store *store,
+                                       const gchar *src_path,
+                                       const struct stat *st)
+{
+    const gchar *locale = setlocale(LC_MESSAGES, NULL);
+
+    return store->hdr->src_mtime == (gint64)st->st_mtime &&
+           store->hdr->src_size == (guint64)st->st_size &&
+           g_str_equal(bench_store_str(store, store->hdr->src_path), src_path) &&
+           g_str_equal(bench_store_str(store, store->hdr->locale),
+                       locale ? locale : "");
+}
+
+static bench_store *bench_store_open_file(const gchar *path)
+{
+    bench_store *store;
+    GMappedFile *file;
+
+    file = g_mapped_file_new(path, FALSE, NULL);
+    if (!file)
+        return NULL;
+
+    store = g_new0(bench_store, 1);
+    store->ref = 1;
+    store->file = file;
+    store->data = g_mapped_file_get_contents(file);
+    store->len = g_mapped_file_get_length(file);
+
+    if (!bench_store_validate(store)) {
+        DEBUG("benchmark store %s is invalid", path);
+        bench_store_free(store);
+        return NULL;
+    }
+
+    return store;
+}
+
+static bench_store *bench_store_open_bytes(GBytes *bytes)
+{
+    bench_store *store = g_new0(bench_store, 1);
+
+    store->ref = 1;
+    store->bytes = bytes;
+    store->data = g_bytes_get_data(bytes, &store->len);
+
+    if (!bench_store_validate(store)) {
+        bench_store_free(store);
+        return NULL;
+    }
+
+    return store;
+}
+
+/* building */
+
+typedef struct {
+    GByteArray *pool;
+    GHashTable *index;
+} bench_store_strings;
+
+static guint32 bench_store_intern(bench_store_strings *s, const gchar *str)
+{
+    gpointer offset;
+    guint32 ret;
+
+    if (!str || !*str)
+        return 0;
+
+    if (g_hash_table_lookup_extended(s->index, str, NULL, &offset))
+        return GPOINTER_TO_UINT(offset);
+
+    ret = s->pool->len;
+    g_byte_array_append(s->pool, (const guint8 *)str, strlen(str) + 1);
+    g_hash_table_insert(s->index, g_strdup(str), GUINT_TO_POINTER(ret));
+
+    return ret;
+}
+
+typedef struct {
+    gchar *name;
+    GPtrArray *results;
+} bench_store_build_section;
+
+static gint bench_store_cmp_section(gconstpointer a, gconstpointer b)
+{
+    const bench_store_build_section *A = a, *B = b;
+    return strcmp(A->name, B->name);
+}
+
+static gint bench_store_cmp_result(gconstpointer a, gconstpointer b)
+{
+    return bench_result_sort(*(bench_result **)a, *(bench_result **)b);
+}
+
+static void bench_store_collect(JsonObject *object,
+                                const gchar *member_name,
+                                JsonNode *member_node,
+                                gpointer user_data)
+{
+    GArray *sections = user_data;
+    bench_store_build_section s;
+    JsonArray *machines;
+    guint i;
+
+    if (json_node_get_node_type(member_node) != JSON_NODE_ARRAY)
+        return;
+
+    machines = json_node_get_array(member_node);
+    s.name = g_strdup(member_name);
+    s.results = g_ptr_array_new_with_free_func((GDestroyNotify)bench_result_free);
+
+    for (i = 0; i < json_array_get_length(machines); i++) {
+        bench_result *b = bench_result_benchmarkjson(
+            member_name, json_array_get_element(machines, i));
+        if (b)
+            g_ptr_array_add(s.results, b);
+    }
+    g_ptr_array_sort(s.results, bench_store_cmp_result);
+
+    g_array_append_val(sections, s);
+}
+
+static void bench_store_fill_record(bench_store_record *rec,
+                                    const bench_result *b,
+                                    bench_store_strings *strings)
+{
+    const bench_machine *m = b->machine;
+
+    memset(rec, 0, sizeof(*rec));
+    rec->result = b->bvalue.result;
+    rec->elapsed_time = b->bvalue.elapsed_time;
+    rec->threads_used = b->bvalue.threads_used;
+    rec->revision = b->bvalue.revision;
+    rec->extra = bench_store_intern(strings, b->bvalue.extra);
+    rec->user_note = bench_store_intern(strings, b->bvalue.user_note);
+    rec->legacy = b->legacy;
+
+    rec->memory_kiB = m->memory_kiB;
+    rec->memory_phys_MiB = m->memory_phys_MiB;
+    rec->processors = m->processors;
+    rec->cores = m->cores;
+    rec->threads = m->threads;
+    rec->nodes = m->nodes;
+    rec->ptr_bits = m->ptr_bits;
+    rec->is_su_data = m->is_su_data;
+    rec->machine_data_version = m->machine_data_version;
+    rec->board = bench_store_intern(strings, m->board);
+    rec->cpu_name = bench_store_intern(strings, m->cpu_name);
+    rec->cpu_desc = bench_store_intern(strings, m->cpu_desc);
+    rec->cpu_config = bench_store_intern(strings, m->cpu_config);
+    rec->ogl_renderer = bench_store_intern(strings, m->ogl_renderer);
+    rec->gpu_desc = bench_store_intern(strings, m->gpu_desc);
+    rec->mid = bench_store_intern(strings, m->mid);
+    rec->ram_types = bench_store_intern(strings, m->ram_types);
+    rec->machine_type = bench_store_intern(strings, m->machine_type);
+}
+
+static GBytes *bench_store_build(const gchar *src_path, const struct stat *st)
+{
+    JsonParser *parser;
+    JsonNode *root;
+    GArray *sections;
+    GByteArray *out;
+    bench_store_strings strings;
+    bench_store_header hdr;
+    const gchar *locale;
+    gsize offset;
+    guint i, j;
+
+    DEBUG("building benchmark store from %s", src_path);
+
+    parser = json_parser_new();
+    if (!json_parser_load_from_file(parser, src_path, NULL)) {
+        g_object_unref(parser);
+        return NULL;
+    }
+
+    sections = g_array_new(FALSE, FALSE, sizeof(bench_store_build_section));
+    root = json_parser_get_root(parser);
+    if (root && json_node_get_node_type(root) == JSON_NODE_OBJECT) {
+        json_object_foreach_member(json_node_get_object(root),
+                                   bench_store_collect, sections);
+    }
+    g_object_unref(parser);
+
+    g_array_sort(sections, bench_store_cmp_section);
+
+    strings.pool = g_byte_array_new();
+    strings.index = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    g_byte_array_append(strings.pool, (const guint8 *)"", 1);
+
+    locale = setlocale(LC_MESSAGES, NULL);
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, BENCH_STORE_MAGIC, sizeof(BENCH_STORE_MAGIC));
+    hdr.version = BENCH_STORE_VERSION;
+    hdr.n_sections = sections->len;
+    hdr.src_mtime = st->st_mtime;
+    hdr.src_size = st->st_size;
+    hdr.src_path = bench_store_intern(&strings, src_path);
+    hdr.locale = bench_store_intern(&strings, locale ? locale : "");
+
+    out = g_byte_array_new();
+    g_byte_array_set_size(out, sizeof(hdr) +
+                                   sections->len * sizeof(bench_store_section));
+    offset = out->len;
+
+    for (i = 0; i < sections->len; i++) {
+        bench_store_build_section *bs =
+            &g_array_index(sections, bench_store_build_section, i);
+        bench_store_section s = {
+            .name = bench_store_intern(&strings, bs->name),
+            .n_records = bs->results->len,
+            .records_offset = offset,
+        };
+
+        for (j = 0; j < bs->results->len; j++) {
+            bench_store_record rec;
+
+            bench_store_fill_record(&rec, g_ptr_array_index(bs->results, j),
+                                    &strings);
+            g_byte_array_append(out, (const guint8 *)&rec, sizeof(rec));
+        }
+        offset = out->len;
+
+        memcpy(out->data + sizeof(hdr) + i * sizeof(s), &s, sizeof(s));
+
+        g_free(bs->name);
+        g_ptr_array_free(bs->results, TRUE);
+    }
+    g_array_free(sections, TRUE);
+
+    hdr.strings_offset = out->len;
+    hdr.strings_size = strings.pool->len;
+    g_byte_array_append(out, strings.pool->data, strings.pool->len);
+    memcpy(out->data, &hdr, sizeof(hdr));
+
+    g_byte_array_free(strings.pool, TRUE);
+    g_hash_table_destroy(strings.index);
+
+    return g_byte_array_free_to_bytes(out);
+}
+
+static gchar *bench_store_cache_path(void)
+{
+    return g_build_filename(g_get_user_cache_dir(), "hardinfo", "benchmark.idx",
+                            NULL);
+}
+
+/* Returns the store for the current benchmark.json, (re)building it if
+ * needed; NULL if there are no results at all. To be released with
+ * bench_store_unref(). */
+static const bench_store *bench_store_get(void)
+{
+    const bench_store *ret = NULL;
+    gchar *src_path, *cache_path;
+    struct stat st;
+    GBytes *bytes;
+
+    g_mutex_lock(&bench_store_mutex);
+
+    src_path = find_benchmark_conf();
+    if (!src_path || g_stat(src_path, &st) < 0) {
+        bench_store_unref(bench_store_current);
+        bench_store_current = NULL;
+        goto out;
+    }
+
+    if (bench_store_current &&
+        bench_store_is_current(bench_store_current, src_path, &st))
+        goto out;
+
+    bench_store_unref(bench_store_current);
+
+    cache_path = bench_store_cache_path();
+    bench_store_current = bench_store_open_file(cache_path);
+    if (bench_store_current &&
+        !bench_store_is_current(bench_store_current, src_path, &st)) {
+        bench_store_unref(bench_store_current);
+        bench_store_current = NULL;
+    }
+
+    if (!bench_store_current) {
+        bytes = bench_store_build(src_path, &st);
+        if (bytes) {
+            gchar *dir = g_path_get_dirname(cache_path);
+            gsize len;
+            gconstpointer data = g_bytes_get_data(bytes, &len);
+
+            g_mkdir_with_parents(dir, 0755);
+            g_free(dir);
+
+            if (g_file_set_contents(cache_path, data, len, NULL))
+                bench_store_current = bench_store_open_file(cache_path);
+            if (!bench_store_current)
+                bench_store_current = bench_store_open_bytes(bytes);
+            else
+                g_bytes_unref(bytes);
+        }
+    }
+
+    g_free(cache_path);
+
+out:
+    if (bench_store_current)
+        ret = bench_store_ref(bench_store_current);
+    g_mutex_unlock(&bench_store_mutex);
+
+    g_free(src_path);
+    return ret;
+}
+
+static void bench_store_release(void)
+{
+    g_mutex_lock(&bench_store_mutex);
+    bench_store_unref(bench_store_current);
+    bench_store_current = NULL;
+    g_mutex_unlock(&bench_store_mutex);
+}
+
+/* queries */
+
+static const bench_store_section *
+bench_store_find_section(const bench_store *store, const gchar *benchmark)
+{
+    guint lo = 0, hi = store->hdr->n_sections;
+
+    while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(bench_store_str(store, store->sections[mid].name),
+                         benchmark);
+
+        if (cmp == 0)
+            return &store->sections[mid];
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return NULL;
+}
+
+/* index of the first record with a result >= value */
+static guint bench_store_rank(const bench_store *store,
+                              const bench_store_section *section,
+                              double value)
+{
+    const bench_store_record *recs = bench_store_records(store, section);
+    guint lo = 0, hi = section->n_records;
+
+    while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+
+        if (recs[mid].result < value)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/* index of the first record with a result > value */
+static guint bench_store_rank_upper(const bench_store *store,
+                                    const bench_store_section *section,
+                                    double value)
+{
+    const bench_store_record *recs = bench_store_records(store, section);
+    guint lo = 0, hi = section->n_records;
+
+    while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+
+        if (recs[mid].result <= value)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+static bench_result *bench_store_result_new(const bench_store *store,
+                                            const bench_store_section *section,
+                                            guint index)
+{
+    const bench_store_record *rec = &bench_store_records(store, section)[index];
+    bench_result *b;
+
+    b = g_new0(bench_result, 1);
+    b->name = g_strdup(bench_store_str(store, section->name));
+    b->legacy = rec->legacy;
+
+    b->bvalue = (bench_value){
+        .result = rec->result,
+        .elapsed_time = rec->elapsed_time,
+        .threads_used = rec->threads_used,
+        .revision = rec->revision,
+    };
+    g_strlcpy(b->bvalue.extra, bench_store_str(store, rec->extra),
+              sizeof(b->bvalue.extra));
+    g_strlcpy(b->bvalue.user_note, bench_store_str(store, rec->user_note),
+              sizeof(b->bvalue.user_note));
+
+    b->machine = bench_machine_new();
+    *b->machine = (bench_machine){
+        .board = g_strdup(bench_store_str(store, rec->board)),
+        .memory_kiB = rec->memory_kiB,
+        .cpu_name = g_strdup(bench_store_str(store, rec->cpu_name)),
+        .cpu_desc = g_strdup(bench_store_str(store, rec->cpu_desc)),
+        .cpu_config = g_strdup(bench_store_str(store, rec->cpu_config)),
+        .ogl_renderer = g_strdup(bench_store_str(store, rec->ogl_renderer)),
+        .gpu_desc = g_strdup(bench_store_str(store, rec->gpu_desc)),
+        .processors = rec->processors,
+        .cores = rec->cores,
+        .threads = rec->threads,
+        .nodes = rec->nodes,
+        .mid = g_strdup(bench_store_str(store, rec->mid)),
+        .ptr_bits = rec->ptr_bits,
+        .is_su_data = rec->is_su_data,
+        .memory_phys_MiB = rec->memory_phys_MiB,
+        .ram_types = g_strdup(bench_store_str(store, rec->ram_types)),
+        .machine_data_version = rec->machine_data_version,
+        .machine_type = g_strdup(bench_store_str(store, rec->machine_type)),
+    };
+
+    return b;
+}
+
+/* filtered views */
+
+typedef struct {
+    gchar *vendor; /* matched against the CPU name and description */
+    gint cores;    /* 0 = any */
+    gchar *memory; /* matched against the RAM types */
+} bench_store_filter;
+
+/* Parses "vendor=AMD,cores=8,memory=DDR4"; returns FALSE if there is
+ * nothing to filter on. */
+static gboolean bench_store_filter_parse(bench_store_filter *f, const gchar *str)
+{
+    gchar **conds;
+    gint i;
+
+    memset(f, 0, sizeof(*f));
+    if (!str || !*str)
+        return FALSE;
+
+    conds = g_strsplit(str, ",", -1);
+    for (i = 0; conds[i]; i++) {
+        gchar *eq = strchr(conds[i], '=');
+        gchar *value;
+
+        if (!eq) {
+            bench_msg("ignoring benchmark filter ``%s''", conds[i]);
+            continue;
+        }
+        *eq = 0;
+        value = g_strstrip(eq + 1);
+        g_strstrip(conds[i]);
+
+        if (g_str_equal(conds[i], "vendor")) {
+            g_free(f->vendor);
+            f->vendor = g_utf8_casefold(value, -1);
+        } else if (g_str_equal(conds[i], "cores")) {
+            f->cores = atoi(value);
+        } else if (g_str_equal(conds[i], "memory")) {
+            g_free(f->memory);
+            f->memory = g_utf8_casefold(value, -1);
+        } else {
+            bench_msg("unknown benchmark filter ``%s''", conds[i]);
+        }
+    }
+    g_strfreev(conds);
+
+    return f->vendor || f->cores > 0 || f->memory;
+}
+
+static void bench_store_filter_clear(bench_store_filter *f)
+{
+    g_free(f->vendor);
+    g_free(f->memory);
+    memset(f, 0, sizeof(*f));
+}
+
+static gboolean bench_store_str_contains(const bench_store *store,
+                                         guint32 offset,
+                                         const gchar *needle)
+{
+    gchar *hay = g_utf8_casefold(bench_store_str(store, offset), -1);
+    gboolean ret = strstr(hay, needle) != NULL;
+
+    g_free(hay);
+    return ret;
+}
+
+static gboolean bench_store_filter_match(const bench_store *store,
+                                         const bench_store_filter *f,
+                                         const bench_store_record *rec)
+{
+    if (f->cores > 0 && rec->cores != f->cores)
+        return FALSE;
+    if (f->memory && !bench_store_str_contains(store, rec->ram_types, f->memory))
+        return FALSE;
+    if (f->vendor && !bench_store_str_contains(store, rec->cpu_name, f->vendor) &&
+        !bench_store_str_contains(store, rec->cpu_desc, f->vendor))
+        return FALSE;
+    return TRUE;
+}
+
+/* A section, or the subset of it passing a filter, still in ascending
+ * order; only the record indices are kept, so views are cheap even for
+ * sections with tens of thousands of results. */
+typedef struct {
+    const bench_store *store;
+    const bench_store_section *section;
+    guint32 *index; /* NULL if not filtered */
+    guint len;
+} bench_store_view;
+
+static void bench_store_view_init(bench_store_view *view,
+                                  const bench_store *store,
+                                  const bench_store_section *section,
+                                  const bench_store_filter *filter)
+{
+    const bench_store_record *recs;
+    guint i;
+
+    view->store = store;
+    view->section = section;
+    view->index = NULL;
+    view->len = section ? section->n_records : 0;
+
+    if (!section || !filter)
+        return;
+
+    recs = bench_store_records(store, section);
+    view->index = g_new(guint32, section->n_records + 1);
+    view->len = 0;
+    for (i = 0; i < section->n_records; i++) {
+        if (bench_store_filter_match(store, filter, &recs[i]))
+            view->index[view->len++] = i;
+    }
+}
+
+static void bench_store_view_clear(bench_store_view *view)
+{
+    g_free(view->index);
+    view->index = NULL;
+    view->len = 0;
+}
+
+/* position in the view -> record index in the section */
+static guint bench_store_view_record(const bench_store_view *view, guint pos)
+{
+    return view->index ? view->index[pos] : pos;
+}
+
+/* position of the first record with a result >= value */
+static guint bench_store_view_rank(const bench_store_view *view, double value)
+{
+    const bench_store_record *recs;
+    guint lo = 0, hi = view->len;
+
+    if (!view->index)
+        return view->section ? bench_store_rank(view->store, view->section, value)
+                             : 0;
+
+    recs = bench_store_records(view->store, view->section);
+    while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+
+        if (recs[view->index[mid]].result < value)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
@@ -16,233 +16,239 @@
  *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
-/* These are parts of modules/benchmark.c where specific benchmarks are defined. */
-
-#define BENCH_CALLBACK(CN, BN, BID, R) \
-gchar *CN() { \
-    if (R)    \
-        return benchmark_include_results_reverse(bench_results[BID], BN); \
-    else      \
-        return benchmark_include_results(bench_results[BID], BN); \
+/* These are parts of modules/benchmark.c where the benchmark registry lives. */
+
+typedef struct {
+    const bench_kernel *kernel;
+    bench_value result;
+} bench_slot;
+
+static bench_slot bench_slots[BENCH_MAX_KERNELS];
+static gint bench_n_slots = 0;
+static gboolean bench_registry_ready = FALSE;
+static GSList *bench_plugins = NULL;
+
+/* the kernels, the composite score and the terminator */
+static ModuleEntry entries[BENCH_MAX_KERNELS + 2];
+
+static gchar *callback_bench_score(void);
+
+/* order here is the order they show in the shell */
+static const bench_kernel *builtin_kernels[] = {
+    &bench_kernel_bfish_single,
+    &bench_kernel_bfish_threads,
+    &bench_kernel_bfish_cores,
+    &bench_kernel_zlib,
+    &bench_kernel_cryptohash,
+    &bench_kernel_fib,
+    &bench_kernel_nqueens,
+    &bench_kernel_fft,
+    &bench_kernel_raytrace,
+    &bench_kernel_sbcpu_single,
+    &bench_kernel_sbcpu_all,
+    &bench_kernel_sbcpu_quad,
+    &bench_kernel_memory_single,
+    &bench_kernel_memory_dual,
+    &bench_kernel_memory_quad,
+    &bench_kernel_membw,
+#if !GTK_CHECK_VERSION(3, 0, 0)
+    &bench_kernel_gui,
+#endif
+    NULL
+};
+
+static gchar *bench_slot_callback(gint n)
+{
+    const bench_slot *s = &bench_slots[n];
+
+    if (s->kernel->higher_is_better)
+        return benchmark_include_results_reverse(s->result, s->kernel->name);
+    return benchmark_include_results(s->result, s->kernel->name);
 }
 
-#define BENCH_SCAN_SIMPLE(SN, BF, BID) \
-void SN(gboolean reload) { \
+/* ModuleEntry callbacks don't get any context, so every slot gets
+ * its own pair of them. */
+#define BENCH_SLOT(N) \
+static gchar *callback_bench_##N(void) { return bench_slot_callback(N); } \
+static void scan_bench_##N(gboolean reload) { \
     SCAN_START(); \
-    do_benchmark(BF, BID); \
+    do_benchmark(N); \
     SCAN_END(); \
 }
 
-#define BENCH_SIMPLE(BID, BN, BF, R) \
-    BENCH_CALLBACK(callback_##BF, BN, BID, R); \
-    BENCH_SCAN_SIMPLE(scan_##BF, BF, BID);
-
-// ID, NAME, FUNCTION, R (0 = lower is better, 1 = higher is better)
-BENCH_SIMPLE(BENCHMARK_FIB, "CPU Fibonacci", benchmark_fib, 0);
-BENCH_SIMPLE(BENCHMARK_NQUEENS, "CPU N-Queens", benchmark_nqueens, 0);
-BENCH_SIMPLE(BENCHMARK_FFT, "FPU FFT", benchmark_fft, 0);
-BENCH_SIMPLE(BENCHMARK_RAYTRACE, "FPU Raytracing", benchmark_raytrace, 0);
-BENCH_SIMPLE(BENCHMARK_BLOWFISH_SINGLE, "CPU Blowfish (Single-thread)", benchmark_bfish_single, 1);
-BENCH_SIMPLE(BENCHMARK_BLOWFISH_THREADS, "CPU Blowfish (Multi-thread)", benchmark_bfish_threads, 1);
-BENCH_SIMPLE(BENCHMARK_BLOWFISH_CORES, "CPU Blowfish (Multi-core)", benchmark_bfish_cores, 1);
-BENCH_SIMPLE(BENCHMARK_ZLIB, "CPU Zlib", benchmark_zlib, 1);
-BENCH_SIMPLE(BENCHMARK_CRYPTOHASH, "CPU CryptoHash", benchmark_cryptohash, 1);
-BENCH_SIMPLE(BENCHMARK_SBCPU_SINGLE, "SysBench CPU (Single-thread)", benchmark_sbcpu_single, 1);
-BENCH_SIMPLE(BENCHMARK_SBCPU_ALL, "SysBench CPU (Multi-thread)", benchmark_sbcpu_all, 1);
-BENCH_SIMPLE(BENCHMARK_SBCPU_QUAD, "SysBench CPU (Four threads)", benchmark_sbcpu_quad, 1);
-BENCH_SIMPLE(BENCHMARK_MEMORY_SINGLE, "SysBench Memory (Single-thread)", benchmark_memory_single, 1);
-BENCH_SIMPLE(BENCHMARK_MEMORY_DUAL, "SysBench Memory (Two threads)", benchmark_memory_dual, 1);
-BENCH_SIMPLE(BENCHMARK_MEMORY_QUAD, "SysBench Memory", benchmark_memory_quad, 1);
-
-#if !GTK_CHECK_VERSION(3,0,0)
-BENCH_CALLBACK(callback_gui, "GPU Drawing", BENCHMARK_GUI, 1);
-void scan_gui(gboolean reload)
+#define BENCH_SLOT_FUNCS(N) { callback_bench_##N, scan_bench_##N }
+
+BENCH_SLOT(0)  BENCH_SLOT(1)  BENCH_SLOT(2)  BENCH_SLOT(3)
+BENCH_SLOT(4)  BENCH_SLOT(5)  BENCH_SLOT(6)  BENCH_SLOT(7)
+BENCH_SLOT(8)  BENCH_SLOT(9)  BENCH_SLOT(10) BENCH_SLOT(11)
+BENCH_SLOT(12) BENCH_SLOT(13) BENCH_SLOT(14) BENCH_SLOT(15)
+BENCH_SLOT(16) BENCH_SLOT(17) BENCH_SLOT(18) BENCH_SLOT(19)
+BENCH_SLOT(20) BENCH_SLOT(21) BENCH_SLOT(22) BENCH_SLOT(23)
+BENCH_SLOT(24) BENCH_SLOT(25) BENCH_SLOT(26) BENCH_SLOT(27)
+BENCH_SLOT(28) BENCH_SLOT(29) BENCH_SLOT(30) BENCH_SLOT(31)
+
+static const struct {
+    gpointer callback, scan_callback;
+} bench_slot_funcs[BENCH_MAX_KERNELS] = {
+    BENCH_SLOT_FUNCS(0),  BENCH_SLOT_FUNCS(1),  BENCH_SLOT_FUNCS(2),
+    BENCH_SLOT_FUNCS(3),  BENCH_SLOT_FUNCS(4),  BENCH_SLOT_FUNCS(5),
+    BENCH_SLOT_FUNCS(6),  BENCH_SLOT_FUNCS(7),  BENCH_SLOT_FUNCS(8),
+    BENCH_SLOT_FUNCS(9),  BENCH_SLOT_FUNCS(10), BENCH_SLOT_FUNCS(11),
+    BENCH_SLOT_FUNCS(12), BENCH_SLOT_FUNCS(13), BENCH_SLOT_FUNCS(14),
+    BENCH_SLOT_FUNCS(15), BENCH_SLOT_FUNCS(16), BENCH_SLOT_FUNCS(17),
+    BENCH_SLOT_FUNCS(18), BENCH_SLOT_FUNCS(19), BENCH_SLOT_FUNCS(20),
+    BENCH_SLOT_FUNCS(21), BENCH_SLOT_FUNCS(22), BENCH_SLOT_FUNCS(23),
+    BENCH_SLOT_FUNCS(24), BENCH_SLOT_FUNCS(25), BENCH_SLOT_FUNCS(26),
+    BENCH_SLOT_FUNCS(27), BENCH_SLOT_FUNCS(28), BENCH_SLOT_FUNCS(29),
+    BENCH_SLOT_FUNCS(30), BENCH_SLOT_FUNCS(31),
+};
+
+static gint bench_find_slot(const gchar *name)
+{
+    gint i;
+
+    for (i = 0; i < bench_n_slots; i++) {
+        if (g_str_equal(bench_slots[i].kernel->name, name))
+            return i;
+    }
+
+    return -1;
+}
+
+static gboolean bench_register_kernel(const bench_kernel *k)
 {
-    SCAN_START();
+    gint n;
 
-    bench_value er = EMPTY_BENCH_VALUE;
+    if (!k || !k->name)
+        return FALSE;
 
-    if (params.run_benchmark) {
-        int argc = 0;
+    if (!k->run && !k->work) {
+        bench_msg("kernel ``%s'' has nothing to run; ignoring", k->name);
+        return FALSE;
+    }
 
-        ui_init(&argc, NULL);
+    if (bench_find_slot(k->name) >= 0) {
+        bench_msg("kernel ``%s'' is already registered; ignoring", k->name);
+        return FALSE;
     }
 
-    if (params.gui_running || params.run_benchmark) {
-        do_benchmark(benchmark_gui, BENCHMARK_GUI);
-    } else {
-        bench_results[BENCHMARK_GUI] = er;
+    if (bench_n_slots >= BENCH_MAX_KERNELS) {
+        bench_msg("too many kernels; ignoring ``%s''", k->name);
+        return FALSE;
     }
-    SCAN_END();
+
+    n = bench_n_slots++;
+    bench_slots[n].kernel = k;
+    bench_slots[n].result = (bench_value)EMPTY_BENCH_VALUE;
+
+    entries[n].name = (gchar *)k->name;
+    entries[n].icon = (gchar *)(k->icon ? k->icon : "benchmark.png");
+    entries[n].callback = bench_slot_funcs[n].callback;
+    entries[n].scan_callback = bench_slot_funcs[n].scan_callback;
+    /* running a benchmark shows a dialog */
+    entries[n].flags = k->flags | MODULE_FLAG_SYNC_SCAN;
+
+    DEBUG("registered benchmark kernel ``%s'' in slot %d", k->name, n);
+
+    return TRUE;
 }
-#endif
 
-static ModuleEntry entries[] = {
-    [BENCHMARK_BLOWFISH_SINGLE] =
-        {
-            N_("CPU Blowfish (Single-thread)"),
-            "blowfish.png",
-            callback_benchmark_bfish_single,
-            scan_benchmark_bfish_single,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_BLOWFISH_THREADS] =
-        {
-            N_("CPU Blowfish (Multi-thread)"),
-            "blowfish.png",
-            callback_benchmark_bfish_threads,
-            scan_benchmark_bfish_threads,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_BLOWFISH_CORES] =
-        {
-            N_("CPU Blowfish (Multi-core)"),
-            "blowfish.png",
-            callback_benchmark_bfish_cores,
-            scan_benchmark_bfish_cores,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_ZLIB] =
-        {
-            N_("CPU Zlib"),
-            "file-roller.png",
-            callback_benchmark_zlib,
-            scan_benchmark_zlib,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_CRYPTOHASH] =
-        {
-            N_("CPU CryptoHash"),
-            "cryptohash.png",
-            callback_benchmark_cryptohash,
-            scan_benchmark_cryptohash,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_FIB] =
-        {
-            N_("CPU Fibonacci"),
-            "nautilus.png",
-            callback_benchmark_fib,
-            scan_benchmark_fib,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_NQUEENS] =
-        {
-            N_("CPU N-Queens"),
-            "nqueens.png",
-            callback_benchmark_nqueens,
-            scan_benchmark_nqueens,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_FFT] =
-        {
-            N_("FPU FFT"),
-            "fft.png",
-            callback_benchmark_fft,
-            scan_benchmark_fft,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_RAYTRACE] =
-        {
-            N_("FPU Raytracing"),
-            "raytrace.png",
-            callback_benchmark_raytrace,
-            scan_benchmark_raytrace,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_SBCPU_SINGLE] =
-        {
-            N_("SysBench CPU (Single-thread)"),
-            "processor.png",
-            callback_benchmark_sbcpu_single,
-            scan_benchmark_sbcpu_single,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_SBCPU_ALL] =
-        {
-            N_("SysBench CPU (Multi-thread)"),
-            "processor.png",
-            callback_benchmark_sbcpu_all,
-            scan_benchmark_sbcpu_all,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_SBCPU_QUAD] =
-        {
-            N_("SysBench CPU (Four threads)"),
-            "processor.png",
-            callback_benchmark_sbcpu_quad,
-            scan_benchmark_sbcpu_quad,
-            MODULE_FLAG_HIDE,
-        },
-    [BENCHMARK_MEMORY_SINGLE] =
-        {
-            N_("SysBench Memory (Single-thread)"),
-            "memory.png",
-            callback_benchmark_memory_single,
-            scan_benchmark_memory_single,
-            MODULE_FLAG_NONE,
-        },
-    [BENCHMARK_MEMORY_DUAL] =
-        {
-            N_("SysBench Memory (Two threads)"),
-            "memory.png",
-            callback_benchmark_memory_dual,
-            scan_benchmark_memory_dual,
-            MODULE_FLAG_HIDE,
-        },
-    [BENCHMARK_MEMORY_QUAD] =
-        {
-            N_("SysBench Memory"),
-            "memory.png",
-            callback_benchmark_memory_quad,
-            scan_benchmark_memory_quad,
-            MODULE_FLAG_NONE,
-        },
-#if !GTK_CHECK_VERSION(3, 0, 0)
-    [BENCHMARK_GUI] =
-        {
-            N_("GPU Drawing"),
-            "module.png",
-            callback_gui,
-            scan_gui,
-            MODULE_FLAG_NO_REMOTE | MODULE_FLAG_HIDE,
-        },
-#else
-    [BENCHMARK_GUI] = {"#"},
-#endif
-    {NULL}};
+static void bench_load_plugin(const gchar *path)
+{
+    const bench_kernel **(*get_kernels)(void);
+    const bench_kernel **k;
+    GModule *plugin;
+    gint added = 0;
+
+    plugin = g_module_open(path, G_MODULE_BIND_LAZY);
+    if (!plugin) {
+        DEBUG("cannot load benchmark plugin ``%s'': %s", path, g_module_error());
+        return;
+    }
 
-const gchar *hi_note_func(gint entry)
+    if (!g_module_symbol(plugin, "hi_benchmark_get_kernels",
+                         (gpointer)&get_kernels)) {
+        DEBUG("``%s'' is not a benchmark plugin", path);
+        g_module_close(plugin);
+        return;
+    }
+
+    for (k = get_kernels(); k && *k; k++) {
+        if (bench_register_kernel(*k))
+            added++;
+    }
+
+    if (added)
+        bench_plugins = g_slist_prepend(bench_plugins, plugin);
+    else
+        g_module_close(plugin);
+}
+
+static void bench_load_plugins(void)
 {
-    switch (entry) {
-    case BENCHMARK_SBCPU_SINGLE:
-    case BENCHMARK_SBCPU_QUAD:
-    case BENCHMARK_SBCPU_ALL:
-        return _("Alexey Kopytov's <i><b>sysbench</b></i> is required.\n"
-                 "Results in events/second. Higher is better.");
-
-    case BENCHMARK_MEMORY_SINGLE:
-    case BENCHMARK_MEMORY_DUAL:
-    case BENCHMARK_MEMORY_QUAD:
-        return _("Alexey Kopytov's <i><b>sysbench</b></i> is required.\n"
-                 "Results in MiB/second. Higher is better.");
-
-    case BENCHMARK_CRYPTOHASH:
-        return _("Results in MiB/second. Higher is better.");
-
-    case BENCHMARK_BLOWFISH_SINGLE:
-    case BENCHMARK_BLOWFISH_THREADS:
-    case BENCHMARK_BLOWFISH_CORES:
-    case BENCHMARK_ZLIB:
-    case BENCHMARK_GUI:
-        return _("Results in HIMarks. Higher is better.");
-
-    case BENCHMARK_FFT:
-    case BENCHMARK_RAYTRACE:
-    case BENCHMARK_FIB:
-    case BENCHMARK_NQUEENS:
-        return _("Results in seconds. Lower is better.");
+    GDir *dir;
+    GSList *files = NULL, *l;
+    const gchar *name;
+    gchar *path;
+
+    path = g_build_filename(params.path_lib, "benchmarks", NULL);
+    dir = g_dir_open(path, 0, NULL);
+    if (dir) {
+        while ((name = g_dir_read_name(dir))) {
+            if (g_str_has_suffix(name, "." G_MODULE_SUFFIX))
+                files = g_slist_prepend(files, g_build_filename(path, name, NULL));
+        }
+        g_dir_close(dir);
     }
+    g_free(path);
+
+    /* stable order, no matter what readdir() says */
+    files = g_slist_sort(files, (GCompareFunc)g_strcmp0);
+    for (l = files; l; l = l->next)
+        bench_load_plugin(l->data);
+    g_slist_free_full(files, g_free);
+}
+
+/* the entries are read when the module is loaded, long before
+ * hi_module_init() runs, so this is called from both */
+static void bench_registry_init(void)
+{
+    const bench_kernel **k;
+
+    if (bench_registry_ready)
+        return;
+    bench_registry_ready = TRUE;
+
+    for (k = builtin_kernels; *k; k++)
+        bench_register_kernel(*k);
+
+    if (params.path_lib)
+        bench_load_plugins();
+
+    entries[bench_n_slots].name = N_("Composite Score");
+    entries[bench_n_slots].icon = "benchmark.png";
+    entries[bench_n_slots].callback = callback_bench_score;
+}
+
+static void bench_registry_deinit(void)
+{
+    g_slist_free_full(bench_plugins, (GDestroyNotify)g_module_close);
+    bench_plugins = NULL;
+    bench_n_slots = 0;
+    bench_registry_ready = FALSE;
+    memset(entries, 0, sizeof(entries));
+}
+
+const gchar *hi_note_func(gint entry)
+{
+    if (entry == bench_n_slots)
+        return _("Geometric mean of the results normalized to the reference "
+                 "machine; higher is better.");
+    if (entry < 0 || entry >= bench_n_slots)
+        return NULL;
+
+    if (bench_slots[entry].kernel->note)
+        return _(bench_slots[entry].kernel->note);
 
     return NULL;
 }
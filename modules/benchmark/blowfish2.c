@@ -50,14 +50,11 @@ static gpointer bfish_exec(const void *in_data, gint thread_number)
     return NULL;
 }
 
-void benchmark_bfish_do(int threads, int entry, const char *status)
+static bench_value benchmark_bfish_do(int threads)
 {
     bench_value r = EMPTY_BENCH_VALUE;
     gchar *test_data = get_test_data(BENCH_DATA_SIZE);
-    if (!test_data) return;
-
-    shell_view_set_enabled(FALSE);
-    shell_status_update(status);
+    if (!test_data) return r;
 
     gchar *k = md5_digest_str(BLOW_KEY, strlen(BLOW_KEY));
     if (!SEQ(k, BLOW_KEY_MD5))
@@ -75,9 +72,44 @@ void benchmark_bfish_do(int threads, int entry, const char *status)
     g_free(k);
     g_free(d);
 
-    bench_results[entry] = r;
+    return r;
 }
 
-void benchmark_bfish_threads(void) { benchmark_bfish_do(0, BENCHMARK_BLOWFISH_THREADS, "Performing Blowfish benchmark (multi-thread)..."); }
-void benchmark_bfish_single(void) { benchmark_bfish_do(1, BENCHMARK_BLOWFISH_SINGLE, "Performing Blowfish benchmark (single-thread)..."); }
-void benchmark_bfish_cores(void) { benchmark_bfish_do(-1, BENCHMARK_BLOWFISH_CORES, "Performing Blowfish benchmark (multi-core)..."); }
+static bench_value benchmark_bfish_threads(void) { return benchmark_bfish_do(0); }
+static bench_value benchmark_bfish_single(void) { return benchmark_bfish_do(1); }
+static bench_value benchmark_bfish_cores(void) { return benchmark_bfish_do(-1); }
+
+#define BFISH_NOTE N_("Results in HIMarks. Higher is better.")
+
+const bench_kernel bench_kernel_bfish_single = {
+    .name = N_("CPU Blowfish (Single-thread)"),
+    .icon = "blowfish.png",
+    .note = BFISH_NOTE,
+    .status = "Performing Blowfish benchmark (single-thread)...",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .revision = BENCH_REVISION,
+    .run = benchmark_bfish_single,
+};
+
+const bench_kernel bench_kernel_bfish_threads = {
+    .name = N_("CPU Blowfish (Multi-thread)"),
+    .icon = "blowfish.png",
+    .note = BFISH_NOTE,
+    .status = "Performing Blowfish benchmark (multi-thread)...",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .revision = BENCH_REVISION,
+    .run = benchmark_bfish_threads,
+};
+
+const bench_kernel bench_kernel_bfish_cores = {
+    .name = N_("CPU Blowfish (Multi-core)"),
+    .icon = "blowfish.png",
+    .note = BFISH_NOTE,
+    .status = "Performing Blowfish benchmark (multi-core)...",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .revision = BENCH_REVISION,
+    .run = benchmark_bfish_cores,
+};
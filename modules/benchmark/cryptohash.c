@@ -64,15 +64,12 @@ static gpointer cryptohash_for(unsigned int start, unsigned int end, void *data,
     return NULL;
 }
 
-void
+static bench_value
 benchmark_cryptohash(void)
 {
     bench_value r = EMPTY_BENCH_VALUE;
     gchar *test_data = get_test_data(BENCH_DATA_SIZE);
-    if (!test_data) return;
-
-    shell_view_set_enabled(FALSE);
-    shell_status_update("Running CryptoHash benchmark...");
+    if (!test_data) return r;
 
     gchar *d = md5_digest_str(test_data, BENCH_DATA_SIZE);
     if (!SEQ(d, BENCH_DATA_MD5))
@@ -86,5 +83,16 @@ benchmark_cryptohash(void)
     g_free(d);
 
     r.result = CALC_MBs(r.elapsed_time);
-    bench_results[BENCHMARK_CRYPTOHASH] = r;
+    return r;
 }
+
+const bench_kernel bench_kernel_cryptohash = {
+    .name = N_("CPU CryptoHash"),
+    .icon = "cryptohash.png",
+    .note = N_("Results in MiB/second. Higher is better."),
+    .status = "Running CryptoHash benchmark...",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .revision = BENCH_REVISION,
+    .run = benchmark_cryptohash,
+};
@@ -19,15 +19,31 @@
 #include "benchmark.h"
 #include "guibench.h"
 
-void
+static bench_value
 benchmark_gui(void)
 {
     bench_value r = EMPTY_BENCH_VALUE;
 
-    shell_view_set_enabled(FALSE);
-    shell_status_update("Running drawing benchmark...");
+    if (params.run_benchmark) {
+        int argc = 0;
+
+        ui_init(&argc, NULL);
+    }
+
+    if (!params.gui_running && !params.run_benchmark)
+        return r;
 
     r.result = guibench(); //TODO: explain in code comments
 
-    bench_results[BENCHMARK_GUI] = r;
+    return r;
 }
+
+const bench_kernel bench_kernel_gui = {
+    .name = N_("GPU Drawing"),
+    .icon = "module.png",
+    .note = N_("Results in HIMarks. Higher is better."),
+    .status = "Running drawing benchmark...",
+    .flags = MODULE_FLAG_NO_REMOTE | MODULE_FLAG_HIDE,
+    .higher_is_better = TRUE,
+    .run = benchmark_gui,
+};
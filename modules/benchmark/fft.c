@@ -37,34 +37,43 @@ static gpointer fft_for(unsigned int start, unsigned int end, void *data, gint t
     return NULL;
 }
 
-void
-benchmark_fft(void)
+/* Pre-allocate all benchmarks */
+static gpointer fft_setup(void)
 {
-    bench_value r = EMPTY_BENCH_VALUE;
-
-    int n_cores, i;
-    gchar *temp;
     FFTBench **benches;
+    int i;
 
-    shell_view_set_enabled(FALSE);
-    shell_status_update("Running FFT benchmark...");
-
-    /* Pre-allocate all benchmarks */
     benches = g_new0(FFTBench *, FFT_MAXT);
     for (i = 0; i < FFT_MAXT; i++) {
         benches[i] = fft_bench_new();
     }
 
-    /* Run the benchmark */
-    r = benchmark_parallel_for(FFT_MAXT, 0, FFT_MAXT, fft_for, benches);
+    return benches;
+}
+
+static void fft_teardown(gpointer data)
+{
+    FFTBench **benches = (FFTBench **)data;
+    int i;
 
-    /* Free up the memory */
     for (i = 0; i < FFT_MAXT; i++) {
         fft_bench_free(benches[i]);
     }
     g_free(benches);
-
-    r.result = r.elapsed_time;
-    r.revision = BENCH_REVISION;
-    bench_results[BENCHMARK_FFT] = r;
 }
+
+const bench_kernel bench_kernel_fft = {
+    .name = N_("FPU FFT"),
+    .icon = "fft.png",
+    .note = N_("Results in seconds. Lower is better."),
+    .status = "Running FFT benchmark...",
+    .higher_is_better = FALSE,
+    .category = BENCH_CATEGORY_FP,
+    .revision = BENCH_REVISION,
+    .drive = BENCH_DRIVE_PARALLEL_FOR,
+    .threads = FFT_MAXT,
+    .amount = FFT_MAXT,
+    .setup = fft_setup,
+    .teardown = fft_teardown,
+    .work = fft_for,
+};
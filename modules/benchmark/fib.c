@@ -31,15 +31,12 @@ gulong fib(gulong n)
     return fib(n - 1) + fib(n - 2);
 }
 
-void
+static bench_value
 benchmark_fib(void)
 {
     GTimer *timer = g_timer_new();
     bench_value r = EMPTY_BENCH_VALUE;
 
-    shell_view_set_enabled(FALSE);
-    shell_status_update("Calculating the 42nd Fibonacci number...");
-
     g_timer_reset(timer);
     g_timer_start(timer);
 
@@ -55,5 +52,16 @@ benchmark_fib(void)
     r.revision = BENCH_REVISION;
     snprintf(r.extra, 255, "a:%d", ANSWER);
 
-    bench_results[BENCHMARK_FIB] = r;
+    return r;
 }
+
+const bench_kernel bench_kernel_fib = {
+    .name = N_("CPU Fibonacci"),
+    .icon = "nautilus.png",
+    .note = N_("Results in seconds. Lower is better."),
+    .status = "Calculating the 42nd Fibonacci number...",
+    .higher_is_better = FALSE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .revision = BENCH_REVISION,
+    .run = benchmark_fib,
+};
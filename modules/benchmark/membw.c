@@ -0,0 +1,127 @@
+/*
+ *    HardInfo - Displays System Information
+ *    Copyright (C) 2003-2020 L. A. F. Pereira <l@tia.mat.br>
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, version 2.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Memory bandwidth: every thread copies its own slice of a buffer much
+ * larger than the caches, STREAM "copy" style, so what is measured is the
+ * DRAM. The result is compared with the theoretical peak of the installed
+ * DIMMs (see dmi_memory.c). */
+
+#include "hardinfo.h"
+#include "benchmark.h"
+#include "cpu_util.h"
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 0
+#define CRUNCH_TIME 5
+#define MEMBW_SIZE (128 * 1024 * 1024) /* each of source and destination */
+
+typedef struct {
+    gchar *src, *dst;
+    gsize slice;
+} membw_data;
+
+static gpointer membw_copy(membw_data *d, gint thread_number)
+{
+    gsize off = d->slice * thread_number;
+
+    memcpy(d->dst + off, d->src + off, d->slice);
+    return NULL;
+}
+
+static bench_value benchmark_membw(void)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    membw_data d;
+    cpu_limits lim;
+    gchar *peak_desc, *warnings = NULL;
+    double peak = 0;
+    int channels = 0;
+
+    cpu_limits_get(&lim);
+
+    /* page aligned, so threads don't share pages */
+    d.slice = (MEMBW_SIZE / lim.effective) & ~(gsize)4095;
+    if (!d.slice)
+        return r;
+    d.src = g_try_malloc(MEMBW_SIZE);
+    d.dst = g_try_malloc(MEMBW_SIZE);
+    if (!d.src || !d.dst) {
+        bench_msg("could not allocate %d MiB", 2 * MEMBW_SIZE / 1024 / 1024);
+        g_free(d.src);
+        g_free(d.dst);
+        return r;
+    }
+    /* fault everything in before the clock starts */
+    memset(d.src, 0x5a, MEMBW_SIZE);
+    memset(d.dst, 0, MEMBW_SIZE);
+
+    r = benchmark_crunch_for(CRUNCH_TIME, lim.effective, membw_copy, &d);
+
+    /* a copy reads and writes every byte */
+    if (r.elapsed_time > 0)
+        r.result = r.result * d.slice * 2 / r.elapsed_time / 1000000;
+    r.revision = BENCH_REVISION;
+    snprintf(r.extra, 255, "%0.1fs, b:%dMiB", (double)CRUNCH_TIME,
+             MEMBW_SIZE / 1024 / 1024);
+
+    g_free(d.src);
+    g_free(d.dst);
+
+    /* from the devices module; see get_memory_peak_bandwidth() */
+    peak_desc = module_call_method("devices::getMemoryPeakBandwidth");
+    if (peak_desc) {
+        gchar *nl = strchr(peak_desc, '\n');
+
+        if (sscanf(peak_desc, "%lf %d", &peak, &channels) != 2)
+            peak = 0;
+        if (nl && nl[1])
+            warnings = g_strdup(nl + 1);
+        g_free(peak_desc);
+    }
+    if (peak > 0 && r.result > 0) {
+        gchar *more = g_strdup_printf(", peak:%.0fMB/s, ch:%d, eff:%.1f%%",
+                                      peak, channels, 100.0 * r.result / peak);
+        g_strlcat(r.extra, more, sizeof(r.extra));
+        g_free(more);
+    }
+    if (warnings) {
+        gchar **lines = g_strsplit(warnings, "\n", -1);
+        int i;
+
+        for (i = 0; lines[i]; i++)
+            bench_msg("%s", lines[i]);
+        g_strfreev(lines);
+        g_strlcat(r.extra, ", see Memory Devices", sizeof(r.extra));
+        g_free(warnings);
+    }
+
+    return r;
+}
+
+const bench_kernel bench_kernel_membw = {
+    .name = N_("Memory Bandwidth"),
+    .icon = "memory.png",
+    .note = N_("Results in MB/second. Higher is better.\n"
+               "The efficiency against the theoretical peak of the installed "
+               "memory is in the details of this machine's result."),
+    .status = "Copying memory...",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_MEMORY,
+    .revision = BENCH_REVISION,
+    .run = benchmark_membw,
+};
@@ -50,20 +50,19 @@ static gpointer nqueens_for(unsigned int start, unsigned int end, void *data, gi
     return NULL;
 }
 
-void
-benchmark_nqueens(void)
-{
-    bench_value r = EMPTY_BENCH_VALUE;
-
-    shell_view_set_enabled(FALSE);
-    shell_status_update("Running N-Queens benchmark...");
-
-    r = benchmark_parallel_for(0, 0, 10, nqueens_for, NULL);
-    r.result = r.elapsed_time;
-    r.revision = BENCH_REVISION;
-    snprintf(r.extra, 255, "q:%d", QUEENS);
-
-    bench_results[BENCHMARK_NQUEENS] = r;
-}
+const bench_kernel bench_kernel_nqueens = {
+    .name = N_("CPU N-Queens"),
+    .icon = "nqueens.png",
+    .note = N_("Results in seconds. Lower is better."),
+    .status = "Running N-Queens benchmark...",
+    .higher_is_better = FALSE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .revision = BENCH_REVISION,
+    .params = "q:" G_STRINGIFY(QUEENS),
+    .drive = BENCH_DRIVE_PARALLEL_FOR,
+    .threads = 0,
+    .amount = 10,
+    .work = nqueens_for,
+};
 
 
@@ -36,19 +36,18 @@ parallel_raytrace(unsigned int start, unsigned int end, gpointer data, gint thre
     return NULL;
 }
 
-void
-benchmark_raytrace(void)
-{
-    bench_value r = EMPTY_BENCH_VALUE;
-
-    shell_view_set_enabled(FALSE);
-    shell_status_update("Performing John Walker's FBENCH...");
-
-    r = benchmark_parallel_for(0, 0, STEPS, parallel_raytrace, NULL);
-    r.result = r.elapsed_time;
-    r.revision = BENCH_REVISION;
-    snprintf(r.extra, 255, "r:%d", STEPS);
-
-    bench_results[BENCHMARK_RAYTRACE] = r;
-}
+const bench_kernel bench_kernel_raytrace = {
+    .name = N_("FPU Raytracing"),
+    .icon = "raytrace.png",
+    .note = N_("Results in seconds. Lower is better."),
+    .status = "Performing John Walker's FBENCH...",
+    .higher_is_better = FALSE,
+    .category = BENCH_CATEGORY_FP,
+    .revision = BENCH_REVISION,
+    .params = "r:" G_STRINGIFY(STEPS),
+    .drive = BENCH_DRIVE_PARALLEL_FOR,
+    .threads = 0,
+    .amount = STEPS,
+    .work = parallel_raytrace,
+};
 
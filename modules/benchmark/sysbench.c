@@ -19,6 +19,7 @@
 
 #include "hardinfo.h"
 #include "benchmark.h"
+#include "cpu_util.h"
 
 #define STATMSG "Performing Alexey Kopytov's sysbench memory benchmark"
 
@@ -174,7 +175,7 @@ sysbench_failed:
     return 0;
 }
 
-void benchmark_memory_run(int threads, int result_index) {
+static bench_value benchmark_memory_run(int threads) {
     struct sysbench_ctx ctx = {
         .test = "memory",
         .threads = threads,
@@ -201,20 +202,15 @@ void benchmark_memory_run(int threads, int result_index) {
            " --memory-access-mode=seq";
     }
 
-    shell_view_set_enabled(FALSE);
-    char msg[128] = "";
-    snprintf(msg, 128, "%s (threads: %d)", STATMSG, threads);
-    shell_status_update(msg);
-
     sysbench_run(&ctx, sbv);
-    bench_results[result_index] = ctx.r;
+    return ctx.r;
 }
 
-void benchmark_memory_single(void) { benchmark_memory_run(1, BENCHMARK_MEMORY_SINGLE); }
-void benchmark_memory_dual(void) { benchmark_memory_run(2, BENCHMARK_MEMORY_DUAL); }
-void benchmark_memory_quad(void) {  benchmark_memory_run(4, BENCHMARK_MEMORY_QUAD); }
+static bench_value benchmark_memory_single(void) { return benchmark_memory_run(1); }
+static bench_value benchmark_memory_dual(void) { return benchmark_memory_run(2); }
+static bench_value benchmark_memory_quad(void) { return benchmark_memory_run(4); }
 
-void benchmark_sbcpu_single(void) {
+static bench_value benchmark_sbcpu_single(void) {
     struct sysbench_ctx ctx = {
         .test = "cpu",
         .threads = 1,
@@ -222,33 +218,27 @@ void benchmark_sbcpu_single(void) {
            "--cpu-max-prime=10000",
         .r = EMPTY_BENCH_VALUE};
 
-    shell_view_set_enabled(FALSE);
-    shell_status_update(STATMSG " (single thread)...");
-
     sysbench_run(&ctx, 0);
-    bench_results[BENCHMARK_SBCPU_SINGLE] = ctx.r;
+    return ctx.r;
 }
 
-void benchmark_sbcpu_all(void) {
-    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
+static bench_value benchmark_sbcpu_all(void) {
+    cpu_limits lim;
 
-    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
+    cpu_limits_get(&lim);
 
     struct sysbench_ctx ctx = {
         .test = "cpu",
-        .threads = cpu_threads,
+        .threads = lim.effective,
         .parms_test =
            "--cpu-max-prime=10000",
         .r = EMPTY_BENCH_VALUE};
 
-    shell_view_set_enabled(FALSE);
-    shell_status_update(STATMSG " (Multi-thread)...");
-
     sysbench_run(&ctx, 0);
-    bench_results[BENCHMARK_SBCPU_ALL] = ctx.r;
+    return ctx.r;
 }
 
-void benchmark_sbcpu_quad(void) {
+static bench_value benchmark_sbcpu_quad(void) {
     struct sysbench_ctx ctx = {
         .test = "cpu",
         .threads = 4,
@@ -256,9 +246,73 @@ void benchmark_sbcpu_quad(void) {
            "--cpu-max-prime=10000",
         .r = EMPTY_BENCH_VALUE};
 
-    shell_view_set_enabled(FALSE);
-    shell_status_update(STATMSG " (Four thread)...");
-
     sysbench_run(&ctx, 0);
-    bench_results[BENCHMARK_SBCPU_QUAD] = ctx.r;
+    return ctx.r;
 }
+
+#define SBCPU_NOTE N_("Alexey Kopytov's <i><b>sysbench</b></i> is required.\n" \
+                      "Results in events/second. Higher is better.")
+#define SBMEM_NOTE N_("Alexey Kopytov's <i><b>sysbench</b></i> is required.\n" \
+                      "Results in MiB/second. Higher is better.")
+
+const bench_kernel bench_kernel_sbcpu_single = {
+    .name = N_("SysBench CPU (Single-thread)"),
+    .icon = "processor.png",
+    .note = SBCPU_NOTE,
+    .status = STATMSG " (single thread)...",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .run = benchmark_sbcpu_single,
+};
+
+const bench_kernel bench_kernel_sbcpu_all = {
+    .name = N_("SysBench CPU (Multi-thread)"),
+    .icon = "processor.png",
+    .note = SBCPU_NOTE,
+    .status = STATMSG " (Multi-thread)...",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .run = benchmark_sbcpu_all,
+};
+
+const bench_kernel bench_kernel_sbcpu_quad = {
+    .name = N_("SysBench CPU (Four threads)"),
+    .icon = "processor.png",
+    .note = SBCPU_NOTE,
+    .status = STATMSG " (Four thread)...",
+    .flags = MODULE_FLAG_HIDE,
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .run = benchmark_sbcpu_quad,
+};
+
+const bench_kernel bench_kernel_memory_single = {
+    .name = N_("SysBench Memory (Single-thread)"),
+    .icon = "memory.png",
+    .note = SBMEM_NOTE,
+    .status = STATMSG " (threads: 1)",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_MEMORY,
+    .run = benchmark_memory_single,
+};
+
+const bench_kernel bench_kernel_memory_dual = {
+    .name = N_("SysBench Memory (Two threads)"),
+    .icon = "memory.png",
+    .note = SBMEM_NOTE,
+    .status = STATMSG " (threads: 2)",
+    .flags = MODULE_FLAG_HIDE,
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_MEMORY,
+    .run = benchmark_memory_dual,
+};
+
+const bench_kernel bench_kernel_memory_quad = {
+    .name = N_("SysBench Memory"),
+    .icon = "memory.png",
+    .note = SBMEM_NOTE,
+    .status = STATMSG " (threads: 4)",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_MEMORY,
+    .run = benchmark_memory_quad,
+};
@@ -62,16 +62,13 @@ static gpointer zlib_for(void *in_data, gint thread_number) {
     return NULL;
 }
 
-void
+static bench_value
 benchmark_zlib(void)
 {
     bench_value r = EMPTY_BENCH_VALUE;
     gchar *test_data = get_test_data(BENCH_DATA_SIZE);
     if (!test_data)
-        return;
-
-    shell_view_set_enabled(FALSE);
-    shell_status_update("Running Zlib benchmark...");
+        return r;
 
     gchar *d = md5_digest_str(test_data, BENCH_DATA_SIZE);
     if (!SEQ(d, BENCH_DATA_MD5))
@@ -81,8 +78,20 @@ benchmark_zlib(void)
     r.result /= 100;
     r.revision = BENCH_REVISION;
     snprintf(r.extra, 255, "zlib %s (built against: %s), d:%s, e:%d", zlib_version, ZLIB_VERSION, d, zlib_errors);
-    bench_results[BENCHMARK_ZLIB] = r;
 
     g_free(test_data);
     g_free(d);
+
+    return r;
 }
+
+const bench_kernel bench_kernel_zlib = {
+    .name = N_("CPU Zlib"),
+    .icon = "file-roller.png",
+    .note = N_("Results in HIMarks. Higher is better."),
+    .status = "Running Zlib benchmark...",
+    .higher_is_better = TRUE,
+    .category = BENCH_CATEGORY_INTEGER,
+    .revision = BENCH_REVISION,
+    .run = benchmark_zlib,
+};
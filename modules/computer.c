@@ -41,18 +41,18 @@
 #define THISORUNK(t) ( (t) ? t : _("(Unknown)") )
 
 /* Callbacks */
-gchar *callback_summary(void);
-gchar *callback_os(void);
-gchar *callback_security(void);
-gchar *callback_modules(void);
-gchar *callback_boots(void);
-gchar *callback_locales(void);
+struct Info *callback_summary(void);
+struct Info *callback_os(void);
+struct Info *callback_security(void);
+struct Info *callback_modules(void);
+struct Info *callback_boots(void);
+struct Info *callback_locales(void);
 gchar *callback_memory_usage();
-gchar *callback_fs(void);
-gchar *callback_display(void);
+struct Info *callback_fs(void);
+struct Info *callback_display(void);
 gchar *callback_network(void);
-gchar *callback_users(void);
-gchar *callback_groups(void);
+struct Info *callback_users(void);
+struct Info *callback_groups(void);
 gchar *callback_env_var(void);
 #if GLIB_CHECK_VERSION(2,14,0)
 gchar *callback_dev(void);
@@ -93,23 +93,23 @@ enum {
 };
 
 static ModuleEntry entries[] = {
-    [ENTRY_SUMMARY] = {N_("Summary"), "summary.png", callback_summary, scan_summary, MODULE_FLAG_NONE},
-    [ENTRY_OS] = {N_("Operating System"), "os.png", callback_os, scan_os, MODULE_FLAG_NONE},
-    [ENTRY_SECURITY] = {N_("Security"), "security.png", callback_security, scan_security, MODULE_FLAG_NONE},
-    [ENTRY_KMOD] = {N_("Kernel Modules"), "module.png", callback_modules, scan_modules, MODULE_FLAG_NONE},
-    [ENTRY_BOOTS] = {N_("Boots"), "boot.png", callback_boots, scan_boots, MODULE_FLAG_NONE},
-    [ENTRY_LANGUAGES] = {N_("Languages"), "language.png", callback_locales, scan_locales, MODULE_FLAG_NONE},
+    [ENTRY_SUMMARY] = {N_("Summary"), "summary.png", NULL, scan_summary, MODULE_FLAG_NONE, callback_summary},
+    [ENTRY_OS] = {N_("Operating System"), "os.png", NULL, scan_os, MODULE_FLAG_NONE, callback_os},
+    [ENTRY_SECURITY] = {N_("Security"), "security.png", NULL, scan_security, MODULE_FLAG_NONE, callback_security},
+    [ENTRY_KMOD] = {N_("Kernel Modules"), "module.png", NULL, scan_modules, MODULE_FLAG_NONE, callback_modules},
+    [ENTRY_BOOTS] = {N_("Boots"), "boot.png", NULL, scan_boots, MODULE_FLAG_SNAPSHOT, callback_boots},
+    [ENTRY_LANGUAGES] = {N_("Languages"), "language.png", NULL, scan_locales, MODULE_FLAG_SNAPSHOT, callback_locales},
     [ENTRY_MEMORY_USAGE] = {N_("Memory Usage"), "memory.png", callback_memory_usage, scan_memory_usage, MODULE_FLAG_NONE},
-    [ENTRY_FS] = {N_("Filesystems"), "dev_removable.png", callback_fs, scan_fs, MODULE_FLAG_NONE},
-    [ENTRY_DISPLAY] = {N_("Display"), "monitor.png", callback_display, scan_display, MODULE_FLAG_NONE},
+    [ENTRY_FS] = {N_("Filesystems"), "dev_removable.png", NULL, scan_fs, MODULE_FLAG_NONE, callback_fs},
+    [ENTRY_DISPLAY] = {N_("Display"), "monitor.png", NULL, scan_display, MODULE_FLAG_NONE, callback_display},
     [ENTRY_ENV] = {N_("Environment Variables"), "environment.png", callback_env_var, scan_env_var, MODULE_FLAG_NONE},
 #if GLIB_CHECK_VERSION(2,14,0)
-    [ENTRY_DEVEL] = {N_("Development"), "devel.png", callback_dev, scan_dev, MODULE_FLAG_NONE},
+    [ENTRY_DEVEL] = {N_("Development"), "devel.png", callback_dev, scan_dev, MODULE_FLAG_SNAPSHOT},
 #else
     [ENTRY_DEVEL] = {N_("Development"), "devel.png", callback_dev, scan_dev, MODULE_FLAG_HIDE},
 #endif /* GLIB_CHECK_VERSION(2,14,0) */
-    [ENTRY_USERS] = {N_("Users"), "users.png", callback_users, scan_users, MODULE_FLAG_NONE},
-    [ENTRY_GROUPS] = {N_("Groups"), "users.png", callback_groups, scan_groups, MODULE_FLAG_NONE},
+    [ENTRY_USERS] = {N_("Users"), "users.png", NULL, scan_users, MODULE_FLAG_NONE, callback_users},
+    [ENTRY_GROUPS] = {N_("Groups"), "users.png", NULL, scan_groups, MODULE_FLAG_NONE, callback_groups},
     {NULL},
 };
 
@@ -122,7 +122,7 @@ gchar *hi_more_info(gchar * entry)
     gchar *info = moreinfo_lookup_with_prefix("COMP", entry);
 
     if (info)
-        return g_strdup(info);
+        return info;
 
     return g_strdup_printf("[%s]", entry);
 }
@@ -160,13 +160,25 @@ gchar *hi_get_field(gchar * field)
             info = moreinfo_lookup_with_prefix("DEV", label);
 
         if (info)
-            tmp = g_strdup(info);
+            tmp = info;
         else
             tmp = g_strdup_printf("Unknown field: [tag: %s] label: %s", tag ? tag : "(none)", label ? label : "(empty)");
     }
     return tmp;
 }
 
+/* the fields updated together by the shell; Memory Usage reads
+ * /proc/meminfo again, once, instead of returning what the last scan saw */
+void hi_get_fields(gint entry, gchar **fields, gchar **values)
+{
+    gint i;
+
+    if (entry == ENTRY_MEMORY_USAGE)
+        scan_memory_usage(TRUE);
+    for (i = 0; fields[i]; i++)
+        values[i] = hi_get_field(fields[i]);
+}
+
 void scan_summary(gboolean reload)
 {
     SCAN_START();
@@ -255,6 +267,7 @@ void scan_dev(gboolean reload)
     SCAN_START();
 
     int i;
+    GString *langs;
     struct {
        gchar *compiler_name;
        gchar *version_command;
@@ -301,9 +314,7 @@ void scan_dev(gboolean reload)
        { N_("Powershell"), "pwsh --version", "\\d+\\.\\d+\\.\\d+", TRUE },
     };
 
-    g_free(dev_list);
-
-    dev_list = g_strdup("");
+    langs = g_string_new(NULL);
 
     for (i = 0; i < G_N_ELEMENTS(detect_lang); i++) {
        gchar *version = NULL;
@@ -314,7 +325,7 @@ void scan_dev(gboolean reload)
        gboolean found;
 
        if (!detect_lang[i].regex) {
-            dev_list = h_strdup_cprintf("[%s]\n", dev_list, _(detect_lang[i].compiler_name));
+            g_string_append_printf(langs, "[%s]\n", _(detect_lang[i].compiler_name));
             continue;
        }
 
@@ -341,7 +352,7 @@ void scan_dev(gboolean reload)
        if (version == NULL)
            version = strdup(_("Not found"));
 
-       dev_list = h_strdup_cprintf("%s=%s\n", dev_list, detect_lang[i].compiler_name, version);
+       g_string_append_printf(langs, "%s=%s\n", detect_lang[i].compiler_name, version);
        g_free(version);
 
        temp = g_strdup_printf(_("Detecting version: %s"),
@@ -350,6 +361,9 @@ void scan_dev(gboolean reload)
        g_free(temp);
     }
 
+    g_free(dev_list);
+    dev_list = g_string_free(langs, FALSE);
+
     SCAN_END();
 }
 
@@ -538,7 +552,7 @@ gchar *computer_get_virtualization(void)
     return detect_machine_type();
 }
 
-gchar *callback_summary(void)
+struct Info *callback_summary(void)
 {
     struct Info *info = info_new();
 
@@ -573,10 +587,10 @@ gchar *callback_summary(void)
     info_add_computed_group_wo_extra(info, NULL,  /* getStorageDevices provides group headers */
         idle_free(module_call_method("devices::getStorageDevices")));
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_os(void)
+struct Info *callback_os(void)
 {
     struct Info *info = info_new();
     gchar *distro_icon;
@@ -623,10 +637,10 @@ gchar *callback_os(void)
                    info_field_update(_("Load Average"), 10000),
                    info_field_last());
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_security(void)
+struct Info *callback_security(void)
 {
     struct Info *info = info_new();
 
@@ -682,10 +696,10 @@ gchar *callback_security(void)
         g_dir_close(dir);
     }
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_modules(void)
+struct Info *callback_modules(void)
 {
     struct Info *info = info_new();
 
@@ -696,10 +710,10 @@ gchar *callback_modules(void)
     info_set_column_headers_visible(info, TRUE);
     info_set_view_type(info, SHELL_VIEW_DUAL);
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_boots(void)
+struct Info *callback_boots(void)
 {
     struct Info *info = info_new();
 
@@ -709,10 +723,10 @@ gchar *callback_boots(void)
     info_set_column_title(info, "Value", _("Kernel Version"));
     info_set_column_headers_visible(info, TRUE);
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_locales(void)
+struct Info *callback_locales(void)
 {
     struct Info *info = info_new();
 
@@ -723,10 +737,10 @@ gchar *callback_locales(void)
     info_set_view_type(info, SHELL_VIEW_DUAL);
     info_set_column_headers_visible(info, TRUE);
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_fs(void)
+struct Info *callback_fs(void)
 {
     struct Info *info = info_new();
 
@@ -740,13 +754,13 @@ gchar *callback_fs(void)
     info_set_zebra_visible(info, TRUE);
     info_set_normalize_percentage(info, FALSE);
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_display(void)
+struct Info *callback_display(void)
 {
     int n = 0;
-    gchar *screens_str = strdup(""), *outputs_str = strdup("");
+    GString *screens = g_string_new(NULL), *outputs = g_string_new(NULL);
     xinfo *xi = computer->display->xi;
     xrr_info *xrr = xi->xrr;
     glx_info *glx = xi->glx;
@@ -774,10 +788,11 @@ gchar *callback_display(void)
 
     for (n = 0; n < xrr->screen_count; n++) {
         gchar *dims = g_strdup_printf(_(/* resolution WxH unit */ "%dx%d pixels"), xrr->screens[n].px_width, xrr->screens[n].px_height);
-        screens_str = h_strdup_cprintf("Screen %d=%s\n", screens_str, xrr->screens[n].number, dims);
+        g_string_append_printf(screens, "Screen %d=%s\n", xrr->screens[n].number, dims);
         g_free(dims);
     }
-    info_add_computed_group(info, _("Screens"), screens_str);
+    info_add_computed_group(info, _("Screens"), screens->str);
+    g_string_free(screens, TRUE);
 
     for (n = 0; n < xrr->output_count; n++) {
         gchar *connection = NULL;
@@ -799,12 +814,13 @@ gchar *callback_display(void)
                     xrr->outputs[n].px_width, xrr->outputs[n].px_height,
                     xrr->outputs[n].px_offset_x, xrr->outputs[n].px_offset_y);
 
-        outputs_str = h_strdup_cprintf("%s=%s; %s\n", outputs_str,
+        g_string_append_printf(outputs, "%s=%s; %s\n",
             xrr->outputs[n].name, connection, dims);
 
         g_free(dims);
     }
-    info_add_computed_group(info, _("Outputs (XRandR)"), outputs_str);
+    info_add_computed_group(info, _("Outputs (XRandR)"), outputs->str);
+    g_string_free(outputs, TRUE);
 
     info_add_group(info, _("OpenGL (GLX)"),
         info_field(_("Vendor"), THISORUNK(glx->ogl_vendor), .value_has_vendor = TRUE ),
@@ -820,10 +836,10 @@ gchar *callback_display(void)
         info_field(_("GLX Version"), THISORUNK(glx->glx_version) ),
         info_field_last());
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_users(void)
+struct Info *callback_users(void)
 {
     struct Info *info = info_new();
 
@@ -831,10 +847,10 @@ gchar *callback_users(void)
     info_set_view_type(info, SHELL_VIEW_DUAL);
     info_set_reload_interval(info, 10000);
 
-    return info_flatten(info);
+    return info;
 }
 
-gchar *callback_groups(void)
+struct Info *callback_groups(void)
 {
     struct Info *info = info_new();
 
@@ -845,7 +861,7 @@ gchar *callback_groups(void)
     info_set_column_headers_visible(info, TRUE);
     info_set_reload_interval(info, 10000);
 
-    return info_flatten(info);
+    return info;
 }
 
 gchar *get_os_kernel(void)
@@ -918,18 +934,16 @@ gchar *get_audio_cards(void)
 gchar *get_memory_total(void)
 {
     scan_memory_usage(FALSE);
-    return moreinfo_lookup ("DEV:MemTotal");
+    return (gchar*)idle_free(moreinfo_lookup("DEV:MemTotal"));
 }
 
 gchar *memory_devices_get_system_memory_str(); /* in dmi_memory.c */
 gchar *memory_devices_get_system_memory_types_str();
-/* Note 1: moreinfo_lookup() results should not be freed because
- *         they are pointers into a GHash.
- *         module_call_method() g_strdup()s it's return value. */
+/* Note 1: module_call_method() g_strdup()s it's return value. */
 const gchar *get_memory_desc(void) // [1] const (as to say "don't free")
 {
     scan_memory_usage(FALSE);
-    gchar *avail = g_strdup(moreinfo_lookup("DEV:MemTotal")); // [1] g_strdup()
+    gchar *avail = moreinfo_lookup("DEV:MemTotal");
     double k = avail ? (double)strtol(avail, NULL, 10) : 0;
     if (k) {
         g_free(avail);
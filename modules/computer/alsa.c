@@ -23,19 +23,20 @@ gchar *
 computer_get_alsacards(Computer * computer)
 {
     GSList *p;
-    gchar *tmp = g_strdup_printf("[%s]\n", _("Audio Devices"));
+    GString *tmp = g_string_new(NULL);
     gint n = 0;
 
+    g_string_append_printf(tmp, "[%s]\n", _("Audio Devices"));
     if (computer->alsa) {
         for (p = computer->alsa->cards; p; p = p->next) {
             AlsaCard *ac = (AlsaCard *) p->data;
 
-            tmp = h_strdup_cprintf("%s#%d=%s\n", tmp,
+            g_string_append_printf(tmp, "%s#%d=%s\n",
                         _("Audio Adapter"), ++n, ac->friendly_name);
         }
     }
 
-    return tmp;
+    return g_string_free(tmp, FALSE);
 }
 
 AlsaInfo *
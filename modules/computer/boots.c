@@ -27,14 +27,15 @@ scan_boots_real(void)
     gchar **tmp;
     gboolean spawned;
     gchar *out, *err, *p, *s, *next_nl;
+    GString *boots;
 
     scan_os(FALSE);
 
-    if (!computer->os->boots)
-      computer->os->boots = strdup("");
-    else
+    if (computer->os->boots)
       return;
 
+    boots = g_string_new(NULL);
+
     spawned = hardinfo_spawn_command_line_sync("last",
             &out, &err, NULL, NULL);
     if (spawned && out != NULL) {
@@ -52,9 +53,7 @@ scan_boots_real(void)
                   }
                 }
                 tmp = g_strsplit(p, " ", 0);
-                computer->os->boots =
-                  h_strdup_cprintf("\n%s %s %s %s=%s",
-                    computer->os->boots,
+                g_string_append_printf(boots, "\n%s %s %s %s=%s",
                     tmp[4], tmp[5], tmp[6], tmp[7], tmp[3]);
                 g_strfreev(tmp);
             }
@@ -63,4 +62,6 @@ scan_boots_real(void)
       g_free(out);
       g_free(err);
     }
+
+    computer->os->boots = g_string_free(boots, FALSE);
 }
@@ -25,17 +25,19 @@ void scan_env_var(gboolean reload)
     SCAN_START();
 
     gchar **envlist;
+    GString *env = g_string_new(NULL);
     gint i;
 
-    g_free(_env);
-
-    _env = g_strdup_printf("[%s]\n", _("Environment Variables") );
+    g_string_append_printf(env, "[%s]\n", _("Environment Variables") );
     for (i = 0, envlist = g_listenv(); envlist[i]; i++) {
-      _env = h_strdup_cprintf("%s=%s\n", _env,
+      g_string_append_printf(env, "%s=%s\n",
                               envlist[i], g_getenv(envlist[i]));
     }
     g_strfreev(envlist);
 
+    g_free(_env);
+    _env = g_string_free(env, FALSE);
+
     SCAN_END();
 }
 
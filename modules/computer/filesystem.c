@@ -34,14 +34,18 @@ scan_filesystems(void)
     gchar buf[1024];
     struct statfs sfs;
     int count = 0;
+    GString *fs;
 
-    g_free(fs_list);
-    fs_list = g_strdup("");
     moreinfo_del_with_prefix("COMP:FS");
 
     mtab = fopen("/etc/mtab", "r");
-    if (!mtab)
+    if (!mtab) {
+        g_free(fs_list);
+        fs_list = g_strdup("");
         return;
+    }
+
+    fs = g_string_new(NULL);
 
     while (fgets(buf, 1024, mtab)) {
         gfloat size, used, avail;
@@ -92,8 +96,7 @@ scan_filesystems(void)
                 moreinfo_add_with_prefix("COMP", key, strhash);
                 g_free(key);
 
-                fs_list = h_strdup_cprintf("$FS%d$%s%s=%.2f %% (%s of %s)|%s\n",
-                                          fs_list,
+                g_string_append_printf(fs, "$FS%d$%s%s=%.2f %% (%s of %s)|%s\n",
                                           count, tmp[0], rw ? "" : "🔒",
                                           use_ratio, stravail, strsize, tmp[1]);
 
@@ -105,4 +108,7 @@ scan_filesystems(void)
     }
 
     fclose(mtab);
+
+    g_free(fs_list);
+    fs_list = g_string_free(fs, FALSE);
 }
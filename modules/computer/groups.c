@@ -27,19 +27,22 @@ void
 scan_groups_do(void)
 {
     struct group *group_;
+    GString *groups_str;
 
     setgrent();
     group_ = getgrent();
     if (!group_)
         return;
 
-    g_free(groups);
-    groups = g_strdup("");
+    groups_str = g_string_new(NULL);
 
     while (group_) {
-        groups = h_strdup_cprintf("%s=%d\n", groups, group_->gr_name, group_->gr_gid);
+        g_string_append_printf(groups_str, "%s=%d\n", group_->gr_name, group_->gr_gid);
         group_ = getgrent();
     }
     
     endgrent();
+
+    g_free(groups);
+    groups = g_string_free(groups_str, FALSE);
 }
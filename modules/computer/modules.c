@@ -241,7 +241,7 @@ void scan_modules_do(void) {
     FILE *lsmod;
     gchar buffer[1024];
     gchar *lsmod_path;
-    gchar *module_icons;
+    GString *mods, *icons;
     const gchar *icon;
 
     if (!_module_hash_table) { _module_hash_table = g_hash_table_new(g_str_hash, g_str_equal); }
@@ -250,7 +250,6 @@ void scan_modules_do(void) {
 
     kernel_modules_dir = NULL;
     module_list = NULL;
-    module_icons = NULL;
     moreinfo_del_with_prefix("COMP:MOD");
 
     lsmod_path = find_program("lsmod");
@@ -261,6 +260,9 @@ void scan_modules_do(void) {
         return;
     }
 
+    mods = g_string_new(NULL);
+    icons = g_string_new(NULL);
+
     (void)fgets(buffer, 1024, lsmod); /* Discards the first line */
 
     while (fgets(buffer, 1024, lsmod)) {
@@ -321,10 +323,10 @@ void scan_modules_do(void) {
         }
 
         /* append this module to the list of modules */
-        module_list = h_strdup_cprintf("$%s$%s=%s\n", module_list, hashkey, modname,
+        g_string_append_printf(mods, "$%s$%s=%s\n", hashkey, modname,
                                        description ? description : "");
         icon = get_module_icon(modname, filename);
-        module_icons = h_strdup_cprintf("Icon$%s$%s=%s.png\n", module_icons, hashkey,
+        g_string_append_printf(icons, "Icon$%s$%s=%s.png\n", hashkey,
                                         modname, icon ? icon: "module");
 
         STRIFNULL(filename, _("(Not available)"));
@@ -393,8 +395,11 @@ void scan_modules_do(void) {
     g_free(lsmod_path);
     g_free(kernel_modules_dir);
 
-    if (module_list != NULL && module_icons != NULL) {
-        module_list = h_strdup_cprintf("[$ShellParam$]\n%s", module_list, module_icons);
+    if (mods->len) {
+        g_string_append_printf(mods, "[$ShellParam$]\n%s", icons->str);
+        module_list = g_string_free(mods, FALSE);
+    } else {
+        g_string_free(mods, TRUE);
     }
-    g_free(module_icons);
+    g_string_free(icons, TRUE);
 }
@@ -26,6 +26,7 @@ void
 scan_users_do(void)
 {
     struct passwd *passwd_;
+    GString *users_str;
     passwd_ = getpwent();
     if (!passwd_)
         return;
@@ -35,7 +36,7 @@ scan_users_do(void)
         moreinfo_del_with_prefix("COMP:USER");
     }
 
-    users = g_strdup("");
+    users_str = g_string_new(NULL);
 
     while (passwd_) {
         gchar *key = g_strdup_printf("USER%s", passwd_->pw_name);
@@ -52,10 +53,12 @@ scan_users_do(void)
         moreinfo_add_with_prefix("COMP", key, val);
 
         strend(passwd_->pw_gecos, ',');
-        users = h_strdup_cprintf("$%s$%s=%s\n", users, key, passwd_->pw_name, passwd_->pw_gecos);
+        g_string_append_printf(users_str, "$%s$%s=%s\n", key, passwd_->pw_name, passwd_->pw_gecos);
         passwd_ = getpwent();
         g_free(key);
     }
 
     endpwent();
+
+    users = g_string_free(users_str, FALSE);
 }
@@ -100,20 +100,20 @@ static ModuleEntry entries[] = {
     [ENTRY_PROCESSOR] = {N_("Processor"), "processor.png", callback_processors, scan_processors, MODULE_FLAG_NONE},
     [ENTRY_GPU] = {N_("Graphics Processors"), "devices.png", callback_gpu, scan_gpu, MODULE_FLAG_NONE},
     [ENTRY_MONITORS] = {N_("Monitors"), "monitor.png", callback_monitors, scan_monitors, MODULE_FLAG_NONE},
-    [ENTRY_PCI] = {N_("PCI Devices"), "devices.png", callback_pci, scan_pci, MODULE_FLAG_NONE},
+    [ENTRY_PCI] = {N_("PCI Devices"), "devices.png", callback_pci, scan_pci, MODULE_FLAG_SNAPSHOT},
     [ENTRY_USB] = {N_("USB Devices"), "usb.png", callback_usb, scan_usb, MODULE_FLAG_NONE},
-    [ENTRY_FW] = {N_("Firmware"), "processor.png", callback_firmware, scan_firmware, MODULE_FLAG_NONE},
+    [ENTRY_FW] = {N_("Firmware"), "processor.png", callback_firmware, scan_firmware, MODULE_FLAG_SNAPSHOT},
     [ENTRY_PRINTERS] = {N_("Printers"), "printer.png", callback_printers, scan_printers, MODULE_FLAG_NONE},
     [ENTRY_BATTERY] = {N_("Battery"), "battery.png", callback_battery, scan_battery, MODULE_FLAG_NONE},
     [ENTRY_SENSORS] = {N_("Sensors"), "therm.png", callback_sensors, scan_sensors, MODULE_FLAG_NONE},
     [ENTRY_INPUT] = {N_("Input Devices"), "inputdevices.png", callback_input, scan_input, MODULE_FLAG_NONE},
     [ENTRY_STORAGE] = {N_("Storage"), "hdd.png", callback_storage, scan_storage, MODULE_FLAG_NONE},
-    [ENTRY_DMI] = {N_("System DMI"), "computer.png", callback_dmi, scan_dmi, MODULE_FLAG_NONE},
-    [ENTRY_DMI_MEM] = {N_("Memory Devices"), "memory.png", callback_dmi_mem, scan_dmi_mem, MODULE_FLAG_NONE},
+    [ENTRY_DMI] = {N_("System DMI"), "computer.png", callback_dmi, scan_dmi, MODULE_FLAG_SNAPSHOT},
+    [ENTRY_DMI_MEM] = {N_("Memory Devices"), "memory.png", callback_dmi_mem, scan_dmi_mem, MODULE_FLAG_SNAPSHOT},
 #if defined(ARCH_x86) || defined(ARCH_x86_64)
     [ENTRY_DTREE] = {N_("Device Tree"), "devices.png", callback_dtree, scan_dtree, MODULE_FLAG_HIDE},
 #else
-    [ENTRY_DTREE] = {N_("Device Tree"), "devices.png", callback_dtree, scan_dtree, MODULE_FLAG_NONE},
+    [ENTRY_DTREE] = {N_("Device Tree"), "devices.png", callback_dtree, scan_dtree, MODULE_FLAG_SNAPSHOT},
 #endif	/* x86 or x86_64 */
     [ENTRY_RESOURCES] = {N_("Resources"), "resources.png", callback_device_resources, scan_device_resources, MODULE_FLAG_NONE},
     { NULL }
@@ -131,6 +131,7 @@ gchar *battery_list = NULL;
 /* in dmi_memory.c */
 gchar *memory_devices_get_info();
 gboolean memory_devices_hinote(const char **msg);
+double memory_devices_get_peak_bandwidth_MBs(int *channels, gchar **warnings);
 gchar *memory_devices_info = NULL;
 
 /* in firmware.c */
@@ -196,7 +197,7 @@ gchar *processor_describe_default(GSList * processors)
 
 gchar *processor_name_default(GSList * processors)
 {
-    gchar *ret = g_strdup("");
+    GString *ret = g_string_new(NULL);
     GSList *tmp, *l;
     Processor *p;
     gchar *cur_str = NULL;
@@ -212,7 +213,7 @@ gchar *processor_name_default(GSList * processors)
             cur_count = 1;
         } else {
             if(g_strcmp0(cur_str, p->model_name)) {
-                ret = h_strdup_cprintf("%s%s", ret, strlen(ret) ? "; " : "", cur_str);
+                g_string_append_printf(ret, "%s%s", ret->len ? "; " : "", cur_str);
                 cur_str = p->model_name;
                 cur_count = 1;
             } else {
@@ -220,15 +221,15 @@ gchar *processor_name_default(GSList * processors)
             }
         }
     }
-    ret = h_strdup_cprintf("%s%s", ret, strlen(ret) ? "; " : "", cur_str);
+    g_string_append_printf(ret, "%s%s", ret->len ? "; " : "", cur_str);
     g_slist_free(tmp);
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 /* TODO: prefix counts are threads when they should be cores. */
 gchar *processor_describe_by_counting_names(GSList * processors)
 {
-    gchar *ret = g_strdup("");
+    GString *ret = g_string_new(NULL);
     GSList *tmp, *l;
     Processor *p;
     gchar *cur_str = NULL;
@@ -244,7 +245,7 @@ gchar *processor_describe_by_counting_names(GSList * processors)
             cur_count = 1;
         } else {
             if(g_strcmp0(cur_str, p->model_name)) {
-                ret = h_strdup_cprintf("%s%dx %s", ret, strlen(ret) ? " + " : "", cur_count, cur_str);
+                g_string_append_printf(ret, "%s%dx %s", ret->len ? " + " : "", cur_count, cur_str);
                 cur_str = p->model_name;
                 cur_count = 1;
             } else {
@@ -252,9 +253,9 @@ gchar *processor_describe_by_counting_names(GSList * processors)
             }
         }
     }
-    ret = h_strdup_cprintf("%s%dx %s", ret, strlen(ret) ? " + " : "", cur_count, cur_str);
+    g_string_append_printf(ret, "%s%dx %s", ret->len ? " + " : "", cur_count, cur_str);
     g_slist_free(tmp);
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 gchar *get_processor_name(void)
@@ -292,7 +293,8 @@ gchar *get_storage_devices_simple(void)
     int i, fi;
     struct InfoGroup *group;
     struct InfoField *field;
-    gchar *storage_devs = NULL, *tmp;
+    GString *storage_devs = g_string_new(NULL);
+    gchar *tmp;
     const gchar *dev_label, *model_wo_tags;
 
     GRegex *regex;
@@ -310,13 +312,13 @@ gchar *get_storage_devices_simple(void)
                 continue;
 
             tmp = g_regex_replace(regex, field->value, -1, 0, "", 0, NULL); // remove html tags
-            storage_devs = h_strdup_cprintf("%s\n", storage_devs, g_strchug(tmp));
+            g_string_append_printf(storage_devs, "%s\n", g_strchug(tmp));
             g_free(tmp);
         }
     }
     g_free(info);
 
-    return storage_devs;
+    return g_string_free(storage_devs, FALSE);
 }
 
 gchar *get_storage_devices(void)
@@ -352,7 +354,7 @@ gchar *get_processor_count(void)
  * TODO: prefix counts are threads when they should be cores. */
 gchar *processor_frequency_desc(GSList * processors)
 {
-    gchar *ret = g_strdup("");
+    GString *ret = g_string_new(NULL);
     GSList *tmp, *l;
     Processor *p;
     float cur_val = -1;
@@ -368,7 +370,7 @@ gchar *processor_frequency_desc(GSList * processors)
             cur_count = 1;
         } else {
             if(cur_val != p->cpu_mhz) {
-                ret = h_strdup_cprintf("%s%dx %.2f %s", ret, strlen(ret) ? " + " : "", cur_count, cur_val, _("MHz") );
+                g_string_append_printf(ret, "%s%dx %.2f %s", ret->len ? " + " : "", cur_count, cur_val, _("MHz") );
                 cur_val = p->cpu_mhz;
                 cur_count = 1;
             } else {
@@ -376,9 +378,9 @@ gchar *processor_frequency_desc(GSList * processors)
             }
         }
     }
-    ret = h_strdup_cprintf("%s%dx %.2f %s", ret, strlen(ret) ? " + " : "", cur_count, cur_val, _("MHz"));
+    g_string_append_printf(ret, "%s%dx %.2f %s", ret->len ? " + " : "", cur_count, cur_val, _("MHz"));
     g_slist_free(tmp);
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 gchar *get_processor_frequency_desc(void)
@@ -408,6 +410,19 @@ gchar *get_processor_max_frequency(void)
     }
 }
 
+/* "<peak MB/s> <channels>", then any warnings, one per line */
+gchar *get_memory_peak_bandwidth(void)
+{
+    gchar *warnings = NULL, *ret;
+    int channels = 0;
+    double peak = memory_devices_get_peak_bandwidth_MBs(&channels, &warnings);
+
+    ret = g_strdup_printf("%.0f %d%s%s", peak, channels,
+                          warnings ? "\n" : "", warnings ? warnings : "");
+    g_free(warnings);
+    return ret;
+}
+
 gchar *get_motherboard(void)
 {
     gchar *board_name, *board_vendor, *board_version;
@@ -566,6 +581,7 @@ const ShellModuleMethod *hi_exported_methods(void)
         {"getInputDevices", get_input_devices},
         {"getMotherboard", get_motherboard},
         {"getGPUList", get_gpu_summary},
+        {"getMemoryPeakBandwidth", get_memory_peak_bandwidth},
         {NULL},
     };
 
@@ -577,7 +593,7 @@ gchar *hi_more_info(gchar * entry)
     gchar *info = moreinfo_lookup_with_prefix("DEV", entry);
 
     if (info)
-	return g_strdup(info);
+	return info;
 
     return g_strdup("?");
 }
@@ -586,11 +602,23 @@ gchar *hi_get_field(gchar * field)
 {
     gchar *info = moreinfo_lookup_with_prefix("DEV", field);
     if (info)
-        return g_strdup(info);
+        return info;
 
     return g_strdup(field);
 }
 
+/* the fields updated together by the shell; the sensors are read again,
+ * once, instead of returning what the last scan saw */
+void hi_get_fields(gint entry, gchar **fields, gchar **values)
+{
+    gint i;
+
+    if (entry == ENTRY_SENSORS)
+        scan_sensors(TRUE);
+    for (i = 0; fields[i]; i++)
+        values[i] = hi_get_field(fields[i]);
+}
+
 void scan_dmi(gboolean reload)
 {
     SCAN_START();
@@ -679,7 +707,9 @@ void scan_storage(gboolean reload)
 {
     SCAN_START();
     g_free(storage_list);
+    g_free(storage_icons);
     storage_list = g_strdup("");
+    storage_icons = g_strdup("");
     storage_no_nvme = FALSE;
     if (!__scan_udisks2_devices()) {
         storage_no_nvme = TRUE;
@@ -194,7 +194,7 @@ processor_scan(void)
 gchar *processor_get_capabilities_from_flags(gchar * strflags)
 {
     gchar **flags, **old;
-    gchar *tmp = NULL;
+    GString *tmp = g_string_new(NULL);
     gint j = 0;
 
     flags = g_strsplit(strflags, " ", 0);
@@ -204,17 +204,17 @@ gchar *processor_get_capabilities_from_flags(gchar * strflags)
         const gchar *meaning = arm_flag_meaning( flags[j] );
 
         if (meaning) {
-            tmp = h_strdup_cprintf("%s=%s\n", tmp, flags[j], meaning);
+            g_string_append_printf(tmp, "%s=%s\n", flags[j], meaning);
         } else {
-            tmp = h_strdup_cprintf("%s=\n", tmp, flags[j]);
+            g_string_append_printf(tmp, "%s=\n", flags[j]);
         }
         j++;
     }
-    if (tmp == NULL || g_strcmp0(tmp, "") == 0)
-        tmp = g_strdup_printf("%s=%s\n", "empty", _("Empty List"));
+    if (tmp->len == 0)
+        g_string_append_printf(tmp, "%s=%s\n", "empty", _("Empty List"));
 
     g_strfreev(old);
-    return tmp;
+    return g_string_free(tmp, FALSE);
 }
 
 #define khzint_to_mhzdouble(k) (((double)k)/1000)
@@ -237,13 +237,15 @@ static gint cmp_cpufreq_data_ignore_affected(cpufreq_data *a, cpufreq_data *b) {
 
 gchar *clocks_summary(GSList * processors)
 {
-    gchar *ret = g_strdup_printf("[%s]\n", _("Clocks"));
+    GString *ret = g_string_new(NULL);
     GSList *all_clocks = NULL, *uniq_clocks = NULL;
     GSList *tmp, *l;
     Processor *p;
     cpufreq_data *c, *cur = NULL;
     gint cur_count = 0, i = 0;
 
+    g_string_append_printf(ret, "[%s]\n", _("Clocks"));
+
     /* create list of all clock references */
     for (l = processors; l; l = l->next) {
         p = (Processor*)l->data;
@@ -253,9 +255,9 @@ gchar *clocks_summary(GSList * processors)
     }
 
     if (g_slist_length(all_clocks) == 0) {
-        ret = h_strdup_cprintf("%s=\n", ret, _("(Not Available)") );
+        g_string_append_printf(ret, "%s=\n", _("(Not Available)") );
         g_slist_free(all_clocks);
-        return ret;
+        return g_string_free(ret, FALSE);
     }
 
     /* ignore duplicate references */
@@ -283,8 +285,7 @@ gchar *clocks_summary(GSList * processors)
             cur_count = 1;
         } else {
             if (cmp_cpufreq_data_ignore_affected(cur, c) != 0) {
-                ret = h_strdup_cprintf(_("%.2f-%.2f %s=%dx\n"),
-                                ret,
+                g_string_append_printf(ret, _("%.2f-%.2f %s=%dx\n"),
                                 khzint_to_mhzdouble(cur->cpukhz_min),
                                 khzint_to_mhzdouble(cur->cpukhz_max),
                                 _("MHz"),
@@ -296,8 +297,7 @@ gchar *clocks_summary(GSList * processors)
             }
         }
     }
-    ret = h_strdup_cprintf(_("%.2f-%.2f %s=%dx\n"),
-                    ret,
+    g_string_append_printf(ret, _("%.2f-%.2f %s=%dx\n"),
                     khzint_to_mhzdouble(cur->cpukhz_min),
                     khzint_to_mhzdouble(cur->cpukhz_max),
                     _("MHz"),
@@ -305,7 +305,7 @@ gchar *clocks_summary(GSList * processors)
 
     g_slist_free(all_clocks);
     g_slist_free(uniq_clocks);
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 gchar *
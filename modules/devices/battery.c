@@ -52,7 +52,7 @@ const struct {
 
 
 static void
-__scan_battery_apcupsd(void)
+__scan_battery_apcupsd(GString *list)
 {
     GHashTable  *ups_data;
     FILE	*apcaccess;
@@ -79,12 +79,12 @@ __scan_battery_apcupsd(void)
         for (i = 0; i < G_N_ELEMENTS(ups_fields); i++) {
           if (!ups_fields[i].name) {
             /* there's no name: make a group with the key as its name */
-            battery_list = h_strdup_cprintf("[%s]\n", battery_list, ups_fields[i].key);
+            g_string_append_printf(list, "[%s]\n", ups_fields[i].key);
           } else {
             /* there's a name: adds a line */
             const gchar *name = g_hash_table_lookup(ups_data, ups_fields[i].key);
-            battery_list = h_strdup_cprintf("%s=%s\n", battery_list,
-                                            ups_fields[i].name, name);
+            g_string_append_printf(list, "%s=%s\n",
+                                   ups_fields[i].name, name);
           }
         }
 
@@ -98,7 +98,7 @@ __scan_battery_apcupsd(void)
 }
 
 static void
-__scan_battery_acpi(void)
+__scan_battery_acpi(GString *list)
 {
     gchar *acpi_path;
 
@@ -175,14 +175,13 @@ __scan_battery_acpi(void)
             else
                charge_rate = 0;
 
-            battery_list = h_strdup_cprintf(_("\n[Battery: %s]\n"
+            g_string_append_printf(list, _("\n[Battery: %s]\n"
                                            "State=%s (load: %s)\n"
                                            "Capacity=%s / %s (%.2f%%)\n"
                                            "Battery Technology=%s (%s)\n"
 					   "Manufacturer=%s\n"
                                            "Model Number=%s\n"
                                            "Serial Number=%s\n"),
-                                           battery_list,
                                            entry,
                                            state, rate,
                                            remaining, capacity, charge_rate * 100.0,
@@ -235,7 +234,7 @@ read_contents(const gchar *base, const gchar *key)
 }
 
 static void
-__scan_battery_sysfs_add_battery(const gchar *name)
+__scan_battery_sysfs_add_battery(GString *list, const gchar *name)
 {
     gchar *path = g_strdup_printf("/sys/class/power_supply/%s", name);
     gchar *status, *capacity, *capacity_level, *technology, *manufacturer,
@@ -252,14 +251,13 @@ __scan_battery_sysfs_add_battery(const gchar *name)
     model_name = read_contents(path, "model_name");
     serial_number = read_contents(path, "serial_number");
 
-    battery_list = h_strdup_cprintf(_("\n[Battery: %s]\n"
+    g_string_append_printf(list, _("\n[Battery: %s]\n"
         "State=%s\n"
         "Capacity=%s / %s\n"
         "Battery Technology=%s\n"
         "Manufacturer=%s\n"
         "Model Number=%s\n"
         "Serial Number=%s\n"),
-        battery_list,
         name,
         status,
         capacity, capacity_level,
@@ -278,7 +276,7 @@ __scan_battery_sysfs_add_battery(const gchar *name)
 }
 
 static void
-__scan_battery_sysfs(void)
+__scan_battery_sysfs(GString *list)
 {
     GDir *dir;
     const gchar *entry;
@@ -289,14 +287,14 @@ __scan_battery_sysfs(void)
 
     while ((entry = g_dir_read_name(dir))) {
         if (g_str_has_prefix(entry, "BAT"))
-            __scan_battery_sysfs_add_battery(entry);
+            __scan_battery_sysfs_add_battery(list, entry);
     }
 
     g_dir_close(dir);
 }
 
 static void
-__scan_battery_apm(void)
+__scan_battery_apm(GString *list)
 {
     FILE                *procapm;
     static char         *sremaining = NULL, *stotal = NULL;
@@ -340,24 +338,22 @@ __scan_battery_apm(void)
     }
 
     if (stotal && sremaining) {
-        battery_list = h_strdup_cprintf(_("\n[Battery (APM)]\n"
+        g_string_append_printf(list, _("\n[Battery (APM)]\n"
                                        "Charge=%d%%\n"
                                        "Remaining Charge=%s of %s\n"
                                        "Using=%s\n"
                                        "APM driver version=%s\n"
                                        "APM BIOS version=%s\n"),
-                                       battery_list,
                                        percentage,
                                        sremaining, stotal,
                                        ac_status[ac_bat],
                                        apm_drv_ver, apm_bios_ver);
     } else {
-        battery_list = h_strdup_cprintf(_("\n[Battery (APM)]\n"
+        g_string_append_printf(list, _("\n[Battery (APM)]\n"
                                        "Charge=%d%%\n"
                                        "Using=%s\n"
                                        "APM driver version=%s\n"
                                        "APM BIOS version=%s\n"),
-                                       battery_list,
                                        percentage,
                                        ac_status[ac_bat],
                                        apm_drv_ver, apm_bios_ver);
@@ -368,18 +364,17 @@ __scan_battery_apm(void)
 void
 scan_battery_do(void)
 {
-    g_free(battery_list);
-    battery_list = g_strdup("");
+    GString *list = g_string_new(NULL);
 
-    __scan_battery_sysfs();
-    __scan_battery_acpi();
-    __scan_battery_apm();
-    __scan_battery_apcupsd();
-    
-    if (*battery_list == '\0') {
-        g_free(battery_list);
-        
-        battery_list = g_strdup(_("[No batteries]\n"
+    __scan_battery_sysfs(list);
+    __scan_battery_acpi(list);
+    __scan_battery_apm(list);
+    __scan_battery_apcupsd(list);
+
+    if (list->len == 0)
+        g_string_append(list, _("[No batteries]\n"
                                 "No batteries found on this system=\n"));
-    }
+
+    g_free(battery_list);
+    battery_list = g_string_free(list, FALSE);
 }
@@ -33,6 +33,9 @@
 gchar *dtree_info = NULL;
 const char *dtree_mem_str = NULL; /* used by memory devices when nothing else is available */
 
+/* built up by mi_add() while scanning */
+static GString *dtree_str = NULL;
+
 /* These should really go into CMakeLists.txt */
 #if defined(__arm__)
 #include "devicetree/rpi_data.c"
@@ -224,7 +227,7 @@ static void mi_add(const char *key, const char *value, int report_details) {
     ckey = hardinfo_clean_label(key, 0);
     rkey = g_strdup_printf("%s:%s", "DTREE", ckey);
 
-    dtree_info = h_strdup_cprintf("$%s%s$%s=\n", dtree_info,
+    g_string_append_printf(dtree_str, "$%s%s$%s=\n",
         (report_details) ? "!" : "", rkey, ckey);
     moreinfo_add_with_prefix("DEV", rkey, g_strdup(value));
 
@@ -291,7 +294,7 @@ void __scan_dtree()
     gchar *maps = dtr_maps_info(dt);
     gchar *messages = NULL;
 
-    dtree_info = g_strdup("[Device Tree]\n");
+    dtree_str = g_string_new("[Device Tree]\n");
     mi_add("Summary", summary, 1);
     mi_add("Maps", maps, 0);
 
@@ -300,6 +303,10 @@ void __scan_dtree()
     messages = msg_section(dt, 0);
     mi_add("Messages", messages, 0);
 
+    g_free(dtree_info);
+    dtree_info = g_string_free(dtree_str, FALSE);
+    dtree_str = NULL;
+
     g_free(summary);
     g_free(maps);
     g_free(messages);
@@ -75,6 +75,7 @@ gboolean dmi_get_info(void)
     gint i;
     gchar *value;
     const gchar *vendor;
+    GString *str = g_string_new(NULL);
 
     if (dmi_info) {
         g_free(dmi_info);
@@ -86,7 +87,7 @@ gboolean dmi_get_info(void)
 
         if (info->group) {
             group = info->name;
-            dmi_info = h_strdup_cprintf("[%s]\n", dmi_info, _(info->name));
+            g_string_append_printf(str, "[%s]\n", _(info->name));
         } else if (group && info->id_str) {
             int state = 3;
 
@@ -111,26 +112,25 @@ gboolean dmi_get_info(void)
 
             switch (state) {
             case 0: /* no value, root */
-                dmi_info = h_strdup_cprintf("%s=%s\n", dmi_info, _(info->name),
-                                            _("(Not available)"));
+                g_string_append_printf(str, "%s=%s\n", _(info->name),
+                                       _("(Not available)"));
                 break;
             case 1: /* no value, no root */
-                dmi_info = h_strdup_cprintf("%s=%s\n", dmi_info, _(info->name),
-                                            _("(Not available; Perhaps try "
-                                              "running HardInfo as root.)"));
+                g_string_append_printf(str, "%s=%s\n", _(info->name),
+                                       _("(Not available; Perhaps try "
+                                         "running HardInfo as root.)"));
                 break;
             case 2: /* ignored value */
                 if (params.markup_ok)
-                    dmi_info = h_strdup_cprintf("%s=<s>%s</s>\n", dmi_info,
-                                                _(info->name), value);
+                    g_string_append_printf(str, "%s=<s>%s</s>\n",
+                                           _(info->name), value);
                 else
-                    dmi_info = h_strdup_cprintf("%s=[X]\"%s\"\n", dmi_info,
-                                                _(info->name), value);
+                    g_string_append_printf(str, "%s=[X]\"%s\"\n",
+                                           _(info->name), value);
                 break;
             case 3: /* good value */
             {
-                dmi_info =
-                    h_strdup_cprintf("%s%s=%s\n", dmi_info,
+                g_string_append_printf(str, "%s%s=%s\n",
                         info->maybe_vendor ? "$^$" : "",
                         _(info->name), value);
                 add_to_moreinfo(group, info->name, value);
@@ -141,10 +141,10 @@ gboolean dmi_get_info(void)
         }
     }
 
-    if (!dmi_succeeded) {
-        g_free(dmi_info);
-        dmi_info = NULL;
-    }
+    if (dmi_succeeded)
+        dmi_info = g_string_free(str, FALSE);
+    else
+        g_string_free(str, TRUE);
 
     return dmi_succeeded;
 }
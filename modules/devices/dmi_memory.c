@@ -155,12 +155,14 @@ typedef struct dmi_mem_socket {
     gchar *form_factor;
     gchar *speed_str;
     gchar *configured_clock_str;
+    int speed_mts, configured_mts; /* 0 if unknown */
     gchar *voltage_min_str;
     gchar *voltage_max_str;
     gchar *voltage_conf_str;
     gchar *partno;
     gchar *data_width;
     gchar *total_width;
+    int data_width_bits;
     gchar *mfgr;
     gboolean has_jedec_mfg_id;
     int mfgr_bank, mfgr_index;
@@ -265,6 +267,12 @@ dmi_mem_socket *dmi_mem_socket_new(dmi_handle h) {
         s->configured_clock_str = dmidecode_match("Configured Clock Speed", &dtm, &h);
         if (!s->configured_clock_str)
             s->configured_clock_str = dmidecode_match("Configured Memory Speed", &dtm, &h);
+        /* "3200 MT/s", or "3200 MHz" from older dmidecode, which is
+         * also the transfer rate */
+        if (s->speed_str)
+            s->speed_mts = strtol(s->speed_str, NULL, 10);
+        if (s->configured_clock_str)
+            s->configured_mts = strtol(s->configured_clock_str, NULL, 10);
 
         s->voltage_min_str = dmidecode_match("Minimum Voltage", &dtm, &h);
         s->voltage_max_str = dmidecode_match("Maximum Voltage", &dtm, &h);
@@ -282,6 +290,8 @@ dmi_mem_socket *dmi_mem_socket_new(dmi_handle h) {
 
         s->data_width = dmidecode_match("Data Width", &dtm, &h);
         s->total_width = dmidecode_match("Total Width", &dtm, &h);
+        if (s->data_width)
+            s->data_width_bits = strtol(s->data_width, NULL, 10);
 
         s->rank = dmidecode_match("Rank", &dtm, &h);
 
@@ -603,6 +613,168 @@ void dmi_mem_free(dmi_mem* s) {
     }
 }
 
+/* the character after word and any ' ', '_' or '-' */
+static char locator_after(const gchar *str, const gchar *word) {
+    const gchar *p = strstr(str, word);
+    if (!p)
+        return 0;
+    p += strlen(word);
+    while (*p == ' ' || *p == '_' || *p == '-')
+        p++;
+    return *p;
+}
+
+/* Best guess at the memory channel of a socket, from locators like
+ * "P0 CHANNEL A", "Controller0-ChannelB-DIMM1", "CPU1_DIMM_C2" or
+ * "DIMM_A1"; NULL if there is no telling. */
+static gchar *dmi_mem_socket_channel(dmi_mem_socket *s) {
+    gchar *tmp, *both, *p;
+    char cpu = 0, ctrl = 0, chan = 0;
+    gchar *ret = NULL;
+
+    tmp = g_strdup_printf("%s %s",
+        s->bank_locator ? s->bank_locator : "", s->locator ? s->locator : "");
+    both = g_ascii_strup(tmp, -1);
+    g_free(tmp);
+
+    cpu = locator_after(both, "CPU");
+    if (!g_ascii_isdigit(cpu))
+        cpu = locator_after(both, "NODE");
+    if (!g_ascii_isdigit(cpu) && both[0] == 'P' && g_ascii_isdigit(both[1]))
+        cpu = both[1];
+    if (!g_ascii_isdigit(cpu))
+        cpu = '0';
+    ctrl = locator_after(both, "CONTROLLER");
+    if (!g_ascii_isdigit(ctrl))
+        ctrl = '0';
+
+    chan = locator_after(both, "CHANNEL");
+    if (!g_ascii_isalnum(chan)) {
+        chan = 0;
+        if ((p = strstr(both, "DIMM"))) {
+            p += 4;
+            while (*p == ' ' || *p == '_' || *p == '-')
+                p++;
+            if (g_ascii_isalpha(p[0]) && g_ascii_isdigit(p[1]))
+                chan = p[0];
+        }
+    }
+
+    if (chan)
+        ret = g_strdup_printf("%c.%c.%c", cpu, ctrl, chan);
+    g_free(both);
+    return ret;
+}
+
+typedef struct {
+    int dimms;
+    dmi_mem_size size_MiB;
+    int mts;   /* slowest DIMM in the channel */
+    int width; /* bits */
+} dmi_mem_channel;
+
+typedef struct {
+    double peak_MBs;   /* 0 if unknown */
+    int channels;      /* populated */
+    int channels_empty;
+    gboolean guessed;  /* some DIMMs assumed to be alone in a channel */
+    gchar *warnings;   /* one per line, NULL if none */
+} dmi_mem_bandwidth;
+
+/* Theoretical peak: sum over populated channels of transfer rate x bus
+ * width; the DIMMs in a channel share its bus. */
+static void dmi_mem_bandwidth_calc(dmi_mem *m, dmi_mem_bandwidth *bw) {
+    GHashTable *channels;
+    GHashTableIter iter;
+    dmi_mem_channel *c, *first = NULL;
+    gboolean unbalanced = FALSE;
+    GSList *l;
+
+    memset(bw, 0, sizeof(*bw));
+    channels = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+
+    for(l = m->sockets; l; l = l->next) {
+        dmi_mem_socket *s = (dmi_mem_socket*)l->data;
+        dmi_mem_array *a = dmi_mem_find_array(m, s->array_handle);
+        gchar *key;
+        int mts;
+
+        if (s->is_not_ram || (a && !a->is_main_memory))
+            continue;
+
+        key = dmi_mem_socket_channel(s);
+        if (!key) {
+            if (!s->populated)
+                continue;
+            key = g_strdup_printf("#%"PRIx32, s->handle);
+            bw->guessed = TRUE;
+        }
+        c = g_hash_table_lookup(channels, key);
+        if (!c) {
+            c = g_new0(dmi_mem_channel, 1);
+            g_hash_table_insert(channels, key, c);
+        } else {
+            g_free(key);
+        }
+
+        if (!s->populated)
+            continue;
+
+        mts = s->configured_mts ? s->configured_mts : s->speed_mts;
+        if (mts && (!c->mts || mts < c->mts))
+            c->mts = mts;
+        c->width = MAX(c->width, s->data_width_bits ? s->data_width_bits : 64);
+        c->size_MiB += s->size_MiB;
+        c->dimms++;
+
+        if (s->configured_mts && s->speed_mts
+            && s->configured_mts < s->speed_mts)
+            bw->warnings = appfnl(bw->warnings,
+                _("%s runs at %d MT/s, but is rated for %d MT/s"),
+                s->short_locator, s->configured_mts, s->speed_mts);
+    }
+
+    g_hash_table_iter_init(&iter, channels);
+    while (g_hash_table_iter_next(&iter, NULL, (gpointer*)&c)) {
+        if (!c->dimms) {
+            bw->channels_empty++;
+            continue;
+        }
+        bw->channels++;
+        bw->peak_MBs += (double)c->mts * c->width / 8;
+        if (!first)
+            first = c;
+        else if (c->dimms != first->dimms || c->size_MiB != first->size_MiB)
+            unbalanced = TRUE;
+    }
+    g_hash_table_destroy(channels);
+
+    if (bw->channels && bw->channels_empty)
+        bw->warnings = appfnl(bw->warnings,
+            _("%d of %d memory channels are empty"),
+            bw->channels_empty, bw->channels + bw->channels_empty);
+    if (unbalanced)
+        bw->warnings = appfnl(bw->warnings, "%s",
+            _("Memory channels are populated unevenly"));
+}
+
+/* for the benchmark module; warnings is one per line, or NULL */
+double memory_devices_get_peak_bandwidth_MBs(int *channels, gchar **warnings) {
+    dmi_mem_bandwidth bw;
+    dmi_mem *mem = dmi_mem_new();
+
+    dmi_mem_bandwidth_calc(mem, &bw);
+    dmi_mem_free(mem);
+
+    if (channels)
+        *channels = bw.channels;
+    if (warnings)
+        *warnings = bw.warnings;
+    else
+        g_free(bw.warnings);
+    return bw.peak_MBs;
+}
+
 gchar *make_spd_section(spd_data *spd) {
     gchar *ret = NULL;
     if (spd) {
@@ -691,12 +863,14 @@ static gchar *tag_make_safe_inplace(gchar *tag) {
 }
 
 gchar *memory_devices_get_info() {
-    gchar *icons = g_strdup("");
-    gchar *ret = g_strdup_printf("[%s]\n", _("Memory Device List"));
+    GString *icons = g_string_new(NULL);
+    GString *ret = g_string_new(NULL);
     GSList *l = NULL;
     sketchy_info = FALSE;
     gchar tag_prefix[] = "DEV";
 
+    g_string_append_printf(ret, "[%s]\n", _("Memory Device List"));
+
     dmi_mem *mem = dmi_mem_new();
 
     /* Arrays */
@@ -715,7 +889,9 @@ gchar *memory_devices_get_info() {
 
         if (a->size_MiB_max < a->size_MiB_present) {
             sketchy_info = TRUE;
-            size_str = h_strdup_cprintf(" %s", size_str, problem_marker());
+            gchar *marked = g_strdup_printf("%s %s", size_str, problem_marker());
+            g_free(size_str);
+            size_str = marked;
         }
 
         if (a->size_MiB_rom > 1024 && (a->size_MiB_rom % 1024 == 0))
@@ -751,11 +927,10 @@ gchar *memory_devices_get_info() {
                         _("ROM Size"), rom_size_str
                         );
         moreinfo_add_with_prefix(tag_prefix, tag, details); /* moreinfo now owns *details */
-        ret = h_strdup_cprintf("$!%s$%s=%s|%s\n",
-                ret,
+        g_string_append_printf(ret, "$!%s$%s=%s|%s\n",
                 tag, a->locator, UNKIFNULL2(types_str), size_str
                 );
-        icons = h_strdup_cprintf("Icon$%s$=%s\n", icons, tag, array_icon);
+        g_string_append_printf(icons, "Icon$%s$=%s\n", tag, array_icon);
         g_free(tag);
         g_free(size_str);
         g_free(rom_size_str);
@@ -818,13 +993,12 @@ gchar *memory_devices_get_info() {
             g_free(spd);
             moreinfo_add_with_prefix(tag_prefix, tag, details); /* moreinfo now owns *details */
             gchar *mfgr = s->mfgr ? vendor_match_tag(s->mfgr,  params.fmt_opts) : NULL;
-            ret = h_strdup_cprintf("$!%s$%s=%s|%s|%s\n",
-                    ret,
+            g_string_append_printf(ret, "$!%s$%s=%s|%s|%s\n",
                     tag,
                     mem->unique_short_locators ? s->short_locator : s->full_locator,
                     UNKIFNULL2(s->partno), size_str, UNKIFNULL2(mfgr)
                     );
-            icons = h_strdup_cprintf("Icon$%s$=%s\n", icons, tag, mem_icon);
+            g_string_append_printf(icons, "Icon$%s$=%s\n", tag, mem_icon);
             g_free(size_str);
             g_free(mfgr);
         } else {
@@ -840,13 +1014,12 @@ gchar *memory_devices_get_info() {
                             _("Size"), _("(Empty)")
                             );
             moreinfo_add_with_prefix(tag_prefix, tag, details); /* moreinfo now owns *details */
-            ret = h_strdup_cprintf("$%s$%s=|%s\n",
-                    ret,
+            g_string_append_printf(ret, "$%s$%s=|%s\n",
                     tag,
                     mem->unique_short_locators ? s->short_locator : s->full_locator,
                     _("(Empty)")
                     );
-            icons = h_strdup_cprintf("Icon$%s$=%s\n", icons, tag, empty_icon);
+            g_string_append_printf(icons, "Icon$%s$=%s\n", tag, empty_icon);
         }
         g_free(tag);
     }
@@ -881,11 +1054,10 @@ gchar *memory_devices_get_info() {
                         _("Types Present"), mem->spd_ram_types, UNKIFNULL2(types_str)
                         );
         moreinfo_add_with_prefix(tag_prefix, tag, details); /* moreinfo now owns *details */
-        ret = h_strdup_cprintf("$!%s$%s=%s|%s\n",
-                ret,
+        g_string_append_printf(ret, "$!%s$%s=%s|%s\n",
                 tag, key, UNKIFNULL2(types_str), size_str
                 );
-        icons = h_strdup_cprintf("Icon$%s$=%s\n", icons, tag, array_icon);
+        g_string_append_printf(icons, "Icon$%s$=%s\n", tag, array_icon);
         g_free(key);
         g_free(tag);
         g_free(size_str);
@@ -914,28 +1086,48 @@ gchar *memory_devices_get_info() {
 
         moreinfo_add_with_prefix(tag_prefix, tag, details); /* moreinfo now owns *details */
         const gchar *mfgr = s->vendor_str ? vendor_get_shortest_name(s->vendor_str) : NULL;
-        ret = h_strdup_cprintf("$!%s$%s%s=%s|%s|%s\n",
-                ret,
+        g_string_append_printf(ret, "$!%s$%s%s=%s|%s|%s\n",
                 tag, key, problem_marker(), UNKIFEMPTY2(s->partno), size_str, UNKIFNULL2(mfgr)
                 );
-        icons = h_strdup_cprintf("Icon$%s$=%s\n", icons, tag, mem_icon);
+        g_string_append_printf(icons, "Icon$%s$=%s\n", tag, mem_icon);
         g_free(vendor_str);
         g_free(size_str);
         g_free(key);
         g_free(tag);
     }
 
+    /* Bandwidth */
+    dmi_mem_bandwidth bw;
+    dmi_mem_bandwidth_calc(mem, &bw);
+    if (bw.peak_MBs > 0 || bw.warnings) {
+        g_string_append_printf(ret, "[%s]\n", _("Memory Bandwidth"));
+        if (bw.peak_MBs > 0) {
+            g_string_append_printf(ret, "%s=%.1f %s\n"
+                    "%s=%d%s\n",
+                    _("Theoretical Peak"), bw.peak_MBs / 1000, _("GB/s"),
+                    _("Channels"), bw.channels,
+                    bw.guessed ? _(" (assuming one DIMM per channel)") : "");
+        }
+        if (bw.warnings) {
+            gchar **lines = g_strsplit(bw.warnings, "\n", -1);
+            int i;
+            for(i = 0; lines[i]; i++)
+                g_string_append_printf(ret, "%s %d=%s%s\n", _("Warning"), i + 1, problem_marker(), lines[i]);
+            g_strfreev(lines);
+        }
+    }
+    g_free(bw.warnings);
+
     no_handles = FALSE;
     if(mem->empty) {
         no_handles = TRUE;
-        g_free(ret);
-        ret = g_strdup_printf("[%s]\n%s=%s\n" "[$ShellParam$]\nViewType=0\n",
+        g_string_printf(ret, "[%s]\n%s=%s\n" "[$ShellParam$]\nViewType=0\n",
                 _("Memory Device List"), _("Result"),
                 (getuid() == 0)
                 ? _("(Not available)")
                 : _("(Not available; Perhaps try running HardInfo as root.)") );
     } else {
-        ret = h_strdup_cprintf(
+        g_string_append_printf(ret,
             "[$ShellParam$]\nViewType=1\n"
             "ColumnTitle$TextValue=%s\n" /* Locator */
             "ColumnTitle$Extra1=%s\n"  /* Size */
@@ -943,18 +1135,17 @@ gchar *memory_devices_get_info() {
             "ColumnTitle$Value=%s\n"     /* Part */
             "ShowColumnHeaders=true\n"
             "%s",
-            ret,
             _("Locator"),
             _("Size"),
             _("Vendor"),
             _("Part"),
-            icons
+            icons->str
             );
     }
 
-    g_free(icons);
+    g_string_free(icons, TRUE);
     dmi_mem_free(mem);
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 gchar *memory_devices_get_system_memory_types_str() {
@@ -22,7 +22,7 @@
 
 static gchar *__cache_get_info_as_string(Processor *processor)
 {
-    gchar *result = g_strdup("");
+    GString *result;
     GSList *cache_list;
     ProcessorCache *cache;
 
@@ -30,11 +30,12 @@ static gchar *__cache_get_info_as_string(Processor *processor)
         return g_strdup(_("Cache information not available=\n"));
     }
 
+    result = g_string_new(NULL);
+
     for (cache_list = processor->cache; cache_list; cache_list = cache_list->next) {
         cache = (ProcessorCache *)cache_list->data;
 
-        result = h_strdup_cprintf(_("Level %d (%s)=%d-way set-associative, %d sets, %dKB size\n"),
-                                  result,
+        g_string_append_printf(result, _("Level %d (%s)=%d-way set-associative, %d sets, %dKB size\n"),
                                   cache->level,
                                   C_("cache-type", cache->type),
                                   cache->ways_of_associativity,
@@ -42,7 +43,7 @@ static gchar *__cache_get_info_as_string(Processor *processor)
                                   cache->size);
     }
 
-    return result;
+    return g_string_free(result, FALSE);
 }
 
 /* This is not used directly, but creates translatable strings for
@@ -154,13 +155,15 @@ static gint cmp_cache_ignore_id(ProcessorCache *a, ProcessorCache *b) {
 
 gchar *caches_summary(GSList * processors)
 {
-    gchar *ret = g_strdup_printf("[%s]\n", _("Caches"));
+    GString *ret = g_string_new(NULL);
     GSList *all_cache = NULL, *uniq_cache = NULL;
     GSList *tmp, *l;
     Processor *p;
     ProcessorCache *c, *cur = NULL;
     gint cur_count = 0, i = 0;
 
+    g_string_append_printf(ret, "[%s]\n", _("Caches"));
+
     /* create list of all cache references */
     for (l = processors; l; l = l->next) {
         p = (Processor*)l->data;
@@ -175,9 +178,9 @@ gchar *caches_summary(GSList * processors)
     }
 
     if (g_slist_length(all_cache) == 0) {
-        ret = h_strdup_cprintf("%s=\n", ret, _("(Not Available)") );
+        g_string_append_printf(ret, "%s=\n", _("(Not Available)") );
         g_slist_free(all_cache);
-        return ret;
+        return g_string_free(ret, FALSE);
     }
 
     /* ignore duplicate references */
@@ -205,8 +208,7 @@ gchar *caches_summary(GSList * processors)
             cur_count = 1;
         } else {
             if (cmp_cache_ignore_id(cur, c) != 0) {
-                ret = h_strdup_cprintf(_("Level %d (%s)#%d=%dx %dKB (%dKB), %d-way set-associative, %d sets\n"),
-                                      ret,
+                g_string_append_printf(ret, _("Level %d (%s)#%d=%dx %dKB (%dKB), %d-way set-associative, %d sets\n"),
                                       cur->level,
                                       C_("cache-type", cur->type),
                                       cur->phy_sock,
@@ -222,8 +224,7 @@ gchar *caches_summary(GSList * processors)
             }
         }
     }
-    ret = h_strdup_cprintf(_("Level %d (%s)#%d=%dx %dKB (%dKB), %d-way set-associative, %d sets\n"),
-                          ret,
+    g_string_append_printf(ret, _("Level %d (%s)#%d=%dx %dKB (%dKB), %d-way set-associative, %d sets\n"),
                           cur->level,
                           C_("cache-type", cur->type),
                           cur->phy_sock,
@@ -235,7 +236,7 @@ gchar *caches_summary(GSList * processors)
 
     g_slist_free(all_cache);
     g_slist_free(uniq_cache);
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 static gchar *processor_get_full_name(const gchar *model_name)
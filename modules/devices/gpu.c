@@ -29,13 +29,16 @@ void scan_gpu_do(void);
 gchar *gpu_list = NULL;
 gchar *gpu_summary = NULL;
 
+/* built up while scanning */
+static GString *gpu_list_str, *gpu_summary_str;
+
 void gpu_summary_add(const char *gpu_name) {
-    if (strlen(gpu_summary) == 0) {
+    if (gpu_summary_str->len == 0) {
         /* first one */
-        gpu_summary = h_strdup_cprintf("%s", gpu_summary, gpu_name);
+        g_string_append(gpu_summary_str, gpu_name);
     } else {
         /* additional */
-        gpu_summary = h_strdup_cprintf(" + %s", gpu_summary, gpu_name);
+        g_string_append_printf(gpu_summary_str, " + %s", gpu_name);
     }
 }
 
@@ -76,7 +79,7 @@ static void _gpu_pci_dev(gpud* gpu) {
     key = g_strdup_printf("GPU%s", gpu->id);
 
     gpu_summary_add((gpu->nice_name) ? gpu->nice_name : name);
-    gpu_list = h_strdup_cprintf("$!%s$%s=%s\n", gpu_list, key, gpu->id, name);
+    g_string_append_printf(gpu_list_str, "$!%s$%s=%s\n", key, gpu->id, name);
 
     gchar *vendor_device_str;
     if (p->vendor_id == p->sub_vendor_id && p->device_id == p->sub_device_id) {
@@ -224,7 +227,7 @@ int _dt_soc_gpu(gpud *gpu) {
         opp_str = strdup("");
 
     gpu_summary_add((gpu->nice_name) ? gpu->nice_name : name);
-    gpu_list = h_strdup_cprintf("$!%s$%s=%s\n", gpu_list, key, key, name);
+    g_string_append_printf(gpu_list_str, "$!%s$%s=%s\n", key, key, name);
     gchar *str = g_strdup_printf("[%s]\n"
              /* Location */  "%s=%s\n"
              /* Vendor */  "$^$%s=%s\n"
@@ -257,14 +260,11 @@ int _dt_soc_gpu(gpud *gpu) {
 }
 
 void scan_gpu_do(void) {
-    if (gpu_summary)
-        g_free(gpu_summary);
-    if (gpu_list) {
+    if (gpu_list)
         moreinfo_del_with_prefix("DEV:GPU");
-        g_free(gpu_list);
-    }
-    gpu_summary = strdup("");
-    gpu_list = g_strdup_printf("[%s]\n", _("GPUs"));
+    gpu_summary_str = g_string_new(NULL);
+    gpu_list_str = g_string_new(NULL);
+    g_string_append_printf(gpu_list_str, "[%s]\n", _("GPUs"));
 
     gpud *gpus = gpu_get_device_list();
     gpud *curr = gpus;
@@ -285,9 +285,14 @@ void scan_gpu_do(void) {
     gpud_list_free(gpus);
 
     if (c)
-        gpu_list = g_strconcat(gpu_list, "[$ShellParam$]\n", "ViewType=1\n", NULL);
+        g_string_append(gpu_list_str, "[$ShellParam$]\nViewType=1\n");
     else  {
         /* NO GPU? */
-        gpu_list = g_strconcat(gpu_list, _("No GPU devices found"), "=\n", NULL);
+        g_string_append_printf(gpu_list_str, "%s=\n", _("No GPU devices found"));
     }
+
+    g_free(gpu_summary);
+    g_free(gpu_list);
+    gpu_summary = g_string_free(gpu_summary_str, FALSE);
+    gpu_list = g_string_free(gpu_list_str, FALSE);
 }
@@ -60,19 +60,17 @@ __scan_input_devices(void)
     gchar *vendor_str = NULL, *product_str = NULL, *vendor_tags = NULL;
     gint bus = 0, vendor = 0, product = 0, version = 0;
     const gchar *bus_str = NULL;
+    GString *list, *icons;
     int d = 0, n = 0;
 
     dev = fopen("/proc/bus/input/devices", "r");
     if (!dev)
     return;
 
-    if (input_list) {
+    if (input_list)
         moreinfo_del_with_prefix("DEV:INP");
-        g_free(input_list);
-        g_free(input_icons);
-    }
-    input_list = g_strdup("");
-    input_icons = g_strdup("");
+    list = g_string_new(NULL);
+    icons = g_string_new(NULL);
 
     while (fgets(buffer, sizeof(buffer), dev)) {
         tmp = buffer;
@@ -120,16 +118,16 @@ __scan_input_devices(void)
             vendor_tags = vendor_list_ribbon(vl, params.fmt_opts);
 
             tmp = g_strdup_printf("INP%d", ++n);
-            input_list = h_strdup_cprintf("$%s$%s=%s|%s\n",
-                         input_list,
+            g_string_append_printf(list, "$%s$%s=%s|%s\n",
                          tmp, name, EMPTYIFNULL(vendor_tags),
                          EMPTYIFNULL(input_devices[d].name));
-            input_icons = h_strdup_cprintf("Icon$%s$%s=%s\n",
-                          input_icons,
+            g_string_append_printf(icons, "Icon$%s$%s=%s\n",
                           tmp, name,
                           input_devices[d].icon);
 
-            gchar *strhash = g_strdup_printf("[%s]\n"
+            GString *strhash = g_string_new(NULL);
+
+            g_string_append_printf(strhash, "[%s]\n"
                     /* Name */   "$^$%s=%s\n"
                     /* Type */   "%s=%s\n"
                     /* Bus */    "%s=[0x%x] %s\n"
@@ -145,14 +143,14 @@ __scan_input_devices(void)
                             _("Version"), version );
 
             if (phys && phys[1] != 0) {
-                 strhash = h_strdup_cprintf("%s=%s\n", strhash, _("Connected to"), phys);
+                 g_string_append_printf(strhash, "%s=%s\n", _("Connected to"), phys);
             }
 
             if (phys && strstr(phys, "ir")) {
-                strhash = h_strdup_cprintf("%s=%s\n", strhash, _("InfraRed port"), _("Yes") );
+                g_string_append_printf(strhash, "%s=%s\n", _("InfraRed port"), _("Yes") );
             }
 
-            moreinfo_add_with_prefix("DEV", tmp, strhash);
+            moreinfo_add_with_prefix("DEV", tmp, g_string_free(strhash, FALSE));
             g_free(tmp);
             g_free(phys);
             g_free(name);
@@ -167,4 +165,9 @@ __scan_input_devices(void)
     }
 
     fclose(dev);
+
+    g_free(input_list);
+    g_free(input_icons);
+    input_list = g_string_free(list, FALSE);
+    input_icons = g_string_free(icons, FALSE);
 }
@@ -47,7 +47,7 @@ void find_edid_ids_file() {
         else
             g_free(file_search_order[n]);
     }
-    auto_free(edid_ids_file);
+    auto_free_on_exit(edid_ids_file);
 }
 
 void find_ieee_oui_ids_file() {
@@ -64,7 +64,7 @@ void find_ieee_oui_ids_file() {
         else
             g_free(file_search_order[n]);
     }
-    auto_free(ieee_oui_ids_file);
+    auto_free_on_exit(ieee_oui_ids_file);
 }
 
 typedef struct {
@@ -443,10 +443,12 @@ static gchar *make_edid_section(monitor *m) {
 }
 
 gchar *monitors_get_info() {
-    gchar *icons = g_strdup("");
-    gchar *ret = g_strdup_printf("[%s]\n", _("Monitors"));
+    GString *icons = g_string_new(NULL);
+    GString *ret = g_string_new(NULL);
     gchar tag_prefix[] = "DEV";
 
+    g_string_append_printf(ret, "[%s]\n", _("Monitors"));
+
     gchar **edid_files = get_output_lines("find /sys/devices -name edid");
     //gchar **edid_files = get_output_lines("find /home/pburt/github/verbose-spork/junk/testing/.testing/edid2/ -name edid.*");
     int i, found = 0;
@@ -474,9 +476,9 @@ gchar *monitors_get_info() {
                                 edid_section ? edid_section : ""
                                 );
             moreinfo_add_with_prefix(tag_prefix, tag, details); /* moreinfo now owns *details */
-            ret = h_strdup_cprintf("$!%s$%s=%s\n",
-                                    ret, tag, m->drm_connection, desc);
-            icons = h_strdup_cprintf("Icon$%s$=%s\n", icons, tag, monitor_icon);
+            g_string_append_printf(ret, "$!%s$%s=%s\n",
+                                   tag, m->drm_connection, desc);
+            g_string_append_printf(icons, "Icon$%s$=%s\n", tag, monitor_icon);
             g_free(desc);
             g_free(edid_section);
             found++;
@@ -488,24 +490,23 @@ gchar *monitors_get_info() {
     no_monitors = FALSE;
     if(!found) {
         no_monitors = TRUE;
-        g_free(ret);
-        ret = g_strdup_printf("[%s]\n%s=%s\n" "[$ShellParam$]\nViewType=0\n",
+        g_string_printf(ret, "[%s]\n%s=%s\n" "[$ShellParam$]\nViewType=0\n",
                 _("Monitors"), _("Result"), _("(Empty)") );
     } else {
-        ret = h_strdup_cprintf(
+        g_string_append_printf(ret,
             "[$ShellParam$]\nViewType=1\n"
             "ColumnTitle$TextValue=%s\n" /* DRM connection */
             "ColumnTitle$Value=%s\n"     /* Name */
             "ShowColumnHeaders=true\n"
             "%s",
-            ret,
             _("Connection"),
             _("Name"),
-            icons
+            icons->str
             );
     }
 
-    return ret;
+    g_string_free(icons, TRUE);
+    return g_string_free(ret, FALSE);
 }
 
 gboolean monitors_hinote(const char **msg) {
@@ -59,7 +59,7 @@ static const gchar *find_icon_for_class(uint32_t class)
     return "devices.png";
 }
 
-static gchar *_pci_dev(const pcid *p, gchar *icons) {
+static void _pci_dev(const pcid *p, GString *list, GString *icons) {
     gchar *str;
     const gchar *class, *vendor, *svendor, *product, *sproduct, *lproduct;
     gchar *name, *key;
@@ -90,8 +90,8 @@ static gchar *_pci_dev(const pcid *p, gchar *icons) {
 
     key = g_strdup_printf("PCI%04x:%02x:%02x.%01x", p->domain, p->bus, p->device, p->function);
 
-    pci_list = h_strdup_cprintf("$%s$%04x:%02x:%02x.%01x=%s\n", pci_list, key, p->domain, p->bus, p->device, p->function, name);
-    icons = h_strdup_cprintf("Icon$%s$%04x:%02x:%02x.%01x=%s\n", icons, key, p->domain, p->bus, p->device, p->function, find_icon_for_class(p->class));
+    g_string_append_printf(list, "$%s$%04x:%02x:%02x.%01x=%s\n", key, p->domain, p->bus, p->device, p->function, name);
+    g_string_append_printf(icons, "Icon$%s$%04x:%02x:%02x.%01x=%s\n", key, p->domain, p->bus, p->device, p->function, find_icon_for_class(p->class));
 
     gchar *vendor_device_str;
     if (device_is_sdevice) {
@@ -162,19 +162,17 @@ static gchar *_pci_dev(const pcid *p, gchar *icons) {
     g_free(vendor_device_str);
     g_free(name);
     g_free(key);
-
-    return icons;
 }
 
 void scan_pci_do(void) {
 
-    if (pci_list) {
+    if (pci_list)
         moreinfo_del_with_prefix("DEV:PCI");
-        g_free(pci_list);
-    }
-    pci_list = g_strdup_printf("[%s]\n", _("PCI Devices"));
 
-    gchar *pci_icons = g_strdup("");
+    GString *devs = g_string_new(NULL);
+    GString *pci_icons = g_string_new(NULL);
+
+    g_string_append_printf(devs, "[%s]\n", _("PCI Devices"));
 
     pcid_list list = pci_get_device_list(0,0);
     list = g_slist_sort(list, pcid_cmp_by_addy);
@@ -183,18 +181,21 @@ void scan_pci_do(void) {
     int c = 0;
     while(l) {
         pcid *curr = (pcid*)l->data;
-        pci_icons = _pci_dev(curr, pci_icons);
+        _pci_dev(curr, devs, pci_icons);
         c++;
         l=l->next;
     }
     pcid_list_free(list);
 
     if (c) {
-        pci_list = g_strconcat(pci_list, "[$ShellParam$]\n", "ViewType=1\n", pci_icons, NULL);
+        g_string_append(devs, "[$ShellParam$]\nViewType=1\n");
+        g_string_append_len(devs, pci_icons->str, pci_icons->len);
     } else  {
         /* NO PCI? */
-        pci_list = g_strconcat(pci_list, _("No PCI devices found"), "=\n", NULL);
+        g_string_append_printf(devs, "%s=\n", _("No PCI devices found"));
     }
 
-    g_free(pci_icons);
+    g_string_free(pci_icons, TRUE);
+    g_free(pci_list);
+    pci_list = g_string_free(devs, FALSE);
 }
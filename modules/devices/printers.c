@@ -75,26 +75,26 @@ gchar *__cups_callback_ptype(gchar *strvalue)
 {
   if (strvalue) {
     unsigned value = atoi(strvalue);
-    gchar *output = g_strdup("\n");
+    GString *output = g_string_new("\n");
 
     if (value & 0x0004)
-      output = h_strdup_cprintf(_("\342\232\254 Can do black and white printing=\n"), output);
+      g_string_append(output, _("\342\232\254 Can do black and white printing=\n"));
     if (value & 0x0008)
-      output = h_strdup_cprintf(_("\342\232\254 Can do color printing=\n"), output);
+      g_string_append(output, _("\342\232\254 Can do color printing=\n"));
     if (value & 0x0010)
-      output = h_strdup_cprintf(_("\342\232\254 Can do duplexing=\n"), output);
+      g_string_append(output, _("\342\232\254 Can do duplexing=\n"));
     if (value & 0x0020)
-      output = h_strdup_cprintf(_("\342\232\254 Can do staple output=\n"), output);
+      g_string_append(output, _("\342\232\254 Can do staple output=\n"));
     if (value & 0x0040)
-      output = h_strdup_cprintf(_("\342\232\254 Can do copies=\n"), output);
+      g_string_append(output, _("\342\232\254 Can do copies=\n"));
     if (value & 0x0080)
-      output = h_strdup_cprintf(_("\342\232\254 Can collate copies=\n"), output);
+      g_string_append(output, _("\342\232\254 Can collate copies=\n"));
     if (value & 0x80000)
-      output = h_strdup_cprintf(_("\342\232\254 Printer is rejecting jobs=\n"), output);
+      g_string_append(output, _("\342\232\254 Printer is rejecting jobs=\n"));
     if (value & 0x1000000)
-      output = h_strdup_cprintf(_("\342\232\254 Printer was automatically discovered and added=\n"), output);
+      g_string_append(output, _("\342\232\254 Printer was automatically discovered and added=\n"));
 
-    return output;
+    return g_string_free(output, FALSE);
   } else {
     return g_strdup(_("Unknown"));
   }
@@ -179,7 +179,8 @@ scan_printers_do(void)
 {
     int num_dests, i, j;
     CUPSDest *dests;
-    gchar *prn_id, *prn_moreinfo;
+    gchar *prn_id;
+    GString *list, *icons, *prn_moreinfo;
 
     g_free(printer_list);
     g_free(printer_icons);
@@ -198,8 +199,8 @@ scan_printers_do(void)
 
     num_dests = cups_dests_get(&dests);
     if (num_dests > 0) {
-	printer_list = g_strdup_printf(_("[Printers (CUPS)]\n"));
-        printer_icons = g_strdup("");
+	list = g_string_new(_("[Printers (CUPS)]\n"));
+        icons = g_string_new(NULL);
 	for (i = 0; i < num_dests; i++) {
 	    GHashTable *options;
 
@@ -213,22 +214,19 @@ scan_printers_do(void)
 
             prn_id = g_strdup_printf("PRN%d", i);
 
-	    printer_list = h_strdup_cprintf("\n$%s$%s=%s\n",
-					    printer_list,
+	    g_string_append_printf(list, "\n$%s$%s=%s\n",
 					    prn_id,
 					    dests[i].name,
 					    dests[i].is_default ? ((params.markup_ok) ? "<i>Default</i>" : "(Default)") : "");
-            printer_icons = h_strdup_cprintf("\nIcon$%s$%s=printer.png",
-                                             printer_icons,
+            g_string_append_printf(icons, "\nIcon$%s$%s=printer.png",
                                              prn_id,
                                              dests[i].name);
 
-            prn_moreinfo = g_strdup("");
+            prn_moreinfo = g_string_new(NULL);
             for (j = 0; j < G_N_ELEMENTS(cups_fields); j++) {
               if (!cups_fields[j].name) {
-                prn_moreinfo = h_strdup_cprintf("[%s]\n",
-                                                prn_moreinfo,
-                                                cups_fields[j].key);
+                g_string_append_printf(prn_moreinfo, "[%s]\n",
+                                       cups_fields[j].key);
               } else {
                 gchar *temp;
 
@@ -245,23 +243,27 @@ scan_printers_do(void)
                   }
                 }
 
-                prn_moreinfo = h_strdup_cprintf("%s%s=%s\n",
-                                                prn_moreinfo,
-                                                cups_fields[j].maybe_vendor ? "$^$" : "",
-                                                cups_fields[j].name,
-                                                temp);
+                g_string_append_printf(prn_moreinfo, "%s%s=%s\n",
+                                       cups_fields[j].maybe_vendor ? "$^$" : "",
+                                       cups_fields[j].name,
+                                       temp);
 
                 g_free(temp);
               }
             }
 
-            moreinfo_add_with_prefix("DEV", prn_id, prn_moreinfo);
+            moreinfo_add_with_prefix("DEV", prn_id,
+                                     g_string_free(prn_moreinfo, FALSE));
             g_free(prn_id);
             g_hash_table_destroy(options);
 	}
 
 	cups_dests_free(num_dests, dests);
+
+	printer_list = g_string_free(list, FALSE);
+	printer_icons = g_string_free(icons, FALSE);
     } else {
+	printer_icons = g_strdup("");
 	printer_list = g_strdup(_("[Printers]\n"
 	                        "No printers found=\n"));
     }
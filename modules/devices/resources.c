@@ -74,6 +74,7 @@ void scan_device_resources(gboolean reload)
     gchar buffer[256];
     gint i;
     gint zero_to_zero_addr = 0;
+    GString *str;
 
     struct {
       gchar *file;
@@ -84,12 +85,11 @@ void scan_device_resources(gboolean reload)
       { "/proc/dma", "[DMA]\n" }
     };
 
-    g_free(_resources);
-    _resources = g_strdup("");
+    str = g_string_new(NULL);
 
     for (i = 0; i < G_N_ELEMENTS(resources); i++) {
       if ((io = fopen(resources[i].file, "r"))) {
-        _resources = h_strconcat(_resources, resources[i].description, NULL);
+        g_string_append(str, resources[i].description);
 
         while (fgets(buffer, 256, io)) {
           gchar **temp = g_strsplit(buffer, ":", 2);
@@ -99,11 +99,11 @@ void scan_device_resources(gboolean reload)
             zero_to_zero_addr++;
 
           if (params.markup_ok)
-            _resources = h_strdup_cprintf("<tt>%s</tt>=%s\n", _resources,
-                                          temp[0], name);
+            g_string_append_printf(str, "<tt>%s</tt>=%s\n",
+                                   temp[0], name);
           else
-            _resources = h_strdup_cprintf(">%s=%s\n", _resources,
-                                          temp[0], name);
+            g_string_append_printf(str, ">%s=%s\n",
+                                   temp[0], name);
 
           g_strfreev(temp);
           g_free(name);
@@ -113,6 +113,8 @@ void scan_device_resources(gboolean reload)
       }
     }
 
+    g_free(_resources);
+    _resources = g_string_free(str, FALSE);
     _require_root = zero_to_zero_addr > 16;
 
     SCAN_END();
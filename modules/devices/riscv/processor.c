@@ -127,7 +127,7 @@ processor_scan(void)
 gchar *processor_get_capabilities_from_flags(gchar * strflags)
 {
     gchar **flags, **old;
-    gchar *tmp = NULL;
+    GString *tmp = g_string_new(NULL);
     gint j = 0;
 
     flags = g_strsplit(strflags, " ", 0);
@@ -137,17 +137,17 @@ gchar *processor_get_capabilities_from_flags(gchar * strflags)
         const gchar *meaning = riscv_ext_meaning( flags[j] );
 
         if (meaning) {
-            tmp = h_strdup_cprintf("%s=%s\n", tmp, flags[j], meaning);
+            g_string_append_printf(tmp, "%s=%s\n", flags[j], meaning);
         } else {
-            tmp = h_strdup_cprintf("%s=\n", tmp, flags[j]);
+            g_string_append_printf(tmp, "%s=\n", flags[j]);
         }
         j++;
     }
-    if (tmp == NULL || g_strcmp0(tmp, "") == 0)
-        tmp = g_strdup_printf("%s=%s\n", "empty", _("Empty List"));
+    if (tmp->len == 0)
+        g_string_append_printf(tmp, "%s=%s\n", "empty", _("Empty List"));
 
     g_strfreev(old);
-    return tmp;
+    return g_string_free(tmp, FALSE);
 }
 
 gchar *processor_name(GSList * processors) {
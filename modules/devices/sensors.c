@@ -36,6 +36,9 @@ gboolean hwmon_first_run = TRUE;
 
 static gchar *last_group = NULL;
 
+/* built up by add_sensor() while scanning */
+static GString *sensors_str, *sensor_icons_str, *lginterval_str;
+
 static void read_sensor_labels(gchar *devname) {
     FILE *conf;
     gchar buf[256], *line, *p;
@@ -147,32 +150,32 @@ static void add_sensor(const char *type,
     if (SENSORS_GROUP_BY_TYPE) {
         // group by type
         if (g_strcmp0(last_group, type) != 0) {
-            sensors = h_strdup_cprintf("[%s]\n", sensors, type);
+            g_string_append_printf(sensors_str, "[%s]\n", type);
             g_free(last_group);
             last_group = g_strdup(type);
         }
-        sensors = h_strdup_cprintf("$%s$%s=%.2f%s|%s\n", sensors,
+        g_string_append_printf(sensors_str, "$%s$%s=%.2f%s|%s\n",
             key, sensor, value, unit, parent);
     }
     else {
         // group by device source / driver
         if (g_strcmp0(last_group, parent) != 0) {
-            sensors = h_strdup_cprintf("[%s]\n", sensors, parent);
+            g_string_append_printf(sensors_str, "[%s]\n", parent);
             g_free(last_group);
             last_group = g_strdup(parent);
         }
-        sensors = h_strdup_cprintf("$%s$%s=%.2f%s|%s\n", sensors,
+        g_string_append_printf(sensors_str, "$%s$%s=%.2f%s|%s\n",
             key, sensor, value, unit, type);
     }
 
     if (icon != NULL) {
-        sensor_icons = h_strdup_cprintf("Icon$%s$%s=%s.png\n", sensor_icons,
+        g_string_append_printf(sensor_icons_str, "Icon$%s$%s=%s.png\n",
             key, sensor, icon);
     }
 
     moreinfo_add_with_prefix("DEV", key, g_strdup_printf("%.2f%s", value, unit));
 
-    lginterval = h_strdup_cprintf("UpdateInterval$%s=1000\n", lginterval, key);
+    g_string_append_printf(lginterval_str, "UpdateInterval$%s=1000\n", key);
 }
 
 static gchar *get_sensor_label_from_conf(gchar *key) {
@@ -728,15 +731,11 @@ static int read_sensors_libsensors(void)
 #endif
 
 void scan_sensors_do(void) {
-    g_free(sensors);
-    g_free(sensor_icons);
     g_free(last_group);
     last_group = NULL;
-    sensors = g_strdup("");
-    sensor_icons = g_strdup("");
-
-    g_free(lginterval);
-    lginterval = g_strdup("");
+    sensors_str = g_string_new(NULL);
+    sensor_icons_str = g_string_new(NULL);
+    lginterval_str = g_string_new(NULL);
 
     if (read_sensors_libsensors() == 0) {
         read_sensors_hwmon();
@@ -748,6 +747,13 @@ void scan_sensors_do(void) {
     read_sensors_windfarm();
     read_sensors_hddtemp();
     read_sensors_udisks2();
+
+    g_free(sensors);
+    g_free(sensor_icons);
+    g_free(lginterval);
+    sensors = g_string_free(sensors_str, FALSE);
+    sensor_icons = g_string_free(sensor_icons_str, FALSE);
+    lginterval = g_string_free(lginterval_str, FALSE);
 }
 
 void sensor_init(void) {
@@ -518,7 +518,7 @@ static void decode_ddr2_module_detail(unsigned char *bytes, char *type_detail) {
 static gchar *decode_ddr2_sdram_extra(unsigned char *bytes) {
     float trcd, trp, tras, ctime, tcl;
     const char* voltage;
-    gchar *out;
+    GString *out;
     int i;
 
     switch(bytes[8]){
@@ -545,21 +545,21 @@ static gchar *decode_ddr2_sdram_extra(unsigned char *bytes) {
     }
 
     /* expected to continue an [SPD] section */
-    out = g_strdup_printf("%s=%s\n"
-                          "[%s]\n",
-                          _("Voltage"), voltage,
-                          _("JEDEC Timings"));
+    out = g_string_new(NULL);
+    g_string_append_printf(out, "%s=%s\n"
+                                "[%s]\n",
+                           _("Voltage"), voltage,
+                           _("JEDEC Timings"));
 
     for (i = 0; i <= 2; i++) {
         if (!decode_ddr2_module_ctime_for_casx(i, bytes, &ctime, &tcl))
             break;
         decode_ddr2_module_timings(ctime, bytes,  &trcd, &trp, &tras);
-        out = h_strdup_cprintf("DDR2-%d=%.0f-%.0f-%.0f-%.0f\n",
-                            out,
+        g_string_append_printf(out, "DDR2-%d=%.0f-%.0f-%.0f-%.0f\n",
                            (int)(2 * (1000 / ctime)), tcl, trcd, trp, tras);
     }
 
-    return out;
+    return g_string_free(out, FALSE);
 }
 
 static void decode_ddr3_module_speed(unsigned char *bytes, float *ddr_clock, int *pc3_speed) {
@@ -762,9 +762,9 @@ static void decode_module_part_number(unsigned char *bytes, char *part_number) {
     }
 }
 
-static char *print_spd_timings(int speed, float cas, float trcd, float trp, float tras,
-                               float ctime) {
-    return g_strdup_printf("DDR4-%d=%.0f-%.0f-%.0f-%.0f\n", speed, cas, ceil(trcd / ctime - 0.025),
+static void print_spd_timings(GString *out, int speed, float cas, float trcd, float trp,
+                              float tras, float ctime) {
+    g_string_append_printf(out, "DDR4-%d=%.0f-%.0f-%.0f-%.0f\n", speed, cas, ceil(trcd / ctime - 0.025),
                            ceil(trp / ctime - 0.025), ceil(tras / ctime - 0.025));
 }
 
@@ -812,6 +812,7 @@ static void decode_ddr4_module_spd_timings(unsigned char *bytes, float speed, ch
     unsigned char cas_support[] = {bytes[20], bytes[21], bytes[22], bytes[23] & 0x1f};
     float possible_ctimes[] = {15 / 24.0, 15 / 22.0, 15 / 20.0, 15 / 18.0,
                                15 / 16.0, 15 / 14.0, 15 / 12.0};
+    GString *timings = g_string_new(NULL);
 
     base_cas = bytes[23] & 0x80 ? 23 : 7;
 
@@ -823,7 +824,7 @@ static void decode_ddr4_module_spd_timings(unsigned char *bytes, float speed, ch
     trp = ddr4_mtb_ftb_calc(bytes[26], bytes[121]);
     tras = (((bytes[27] & 0x0f) << 8) + bytes[28]) * 0.125;
 
-    *str = print_spd_timings((int)speed, ceil(taa / ctime - 0.025), trcd, trp, tras, ctime);
+    print_spd_timings(timings, (int)speed, ceil(taa / ctime - 0.025), trcd, trp, tras, ctime);
 
     for (ci = 0; ci < 7; ci++) {
         best_cas = 0;
@@ -839,11 +840,12 @@ static void decode_ddr4_module_spd_timings(unsigned char *bytes, float speed, ch
         }
 
         if (best_cas > 0 && pctime <= ctime_max && pctime >= ctime) {
-            *str = h_strdup_cprintf(
-                "%s\n", *str,
-                print_spd_timings((int)(2000.0 / pctime), best_cas, trcd, trp, tras, pctime));
+            print_spd_timings(timings, (int)(2000.0 / pctime), best_cas, trcd, trp, tras, pctime);
+            g_string_append_c(timings, '\n');
         }
     }
+
+    *str = g_string_free(timings, FALSE);
 }
 
 static void decode_ddr4_module_size(unsigned char *bytes, dmi_mem_size *size) {
@@ -920,6 +922,7 @@ static void detect_ddr4_xmp(unsigned char *bytes, int spd_size, int *majv, int *
 static void decode_ddr4_xmp(unsigned char *bytes, int spd_size, char **str) {
     float ctime;
     float ddrclk, taa, trcd, trp, tras;
+    GString *xmp;
 
     if (spd_size < 405)
         return;
@@ -931,16 +934,18 @@ static void decode_ddr4_xmp(unsigned char *bytes, int spd_size, char **str) {
     trp  = ddr4_mtb_ftb_calc(bytes[403], bytes[428]);
     tras = (((bytes[404] & 0x0f) << 8) + bytes[405]) * 0.125;
 
-    *str = g_strdup_printf("[%s]\n"
+    xmp = g_string_new(NULL);
+    g_string_append_printf(xmp, "[%s]\n"
                "%s=DDR4 %d MHz\n"
                "%s=%d.%d V\n"
-               "[%s]\n"
-               "%s",
+               "[%s]\n",
                _("XMP Profile"),
                _("Speed"), (int) ddrclk,
                _("Voltage"), bytes[393] >> 7, bytes[393] & 0x7f,
-               _("XMP Timings"),
-               print_spd_timings((int) ddrclk, ceil(taa/ctime - 0.025), trcd, trp, tras, ctime));
+               _("XMP Timings"));
+    print_spd_timings(xmp, (int) ddrclk, ceil(taa/ctime - 0.025), trcd, trp, tras, ctime);
+
+    *str = g_string_free(xmp, FALSE);
 }
 
 static void decode_ddr4_module_detail(unsigned char *bytes, char *type_detail) {
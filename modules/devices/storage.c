@@ -84,8 +84,9 @@ gboolean __scan_udisks2_devices(void) {
     udiskd *disk;
     udiskp *part;
     udisksa *attrib;
-    gchar *udisks2_storage_list = NULL, *features = NULL, *moreinfo = NULL;
-    gchar *devid, *size, *tmp = NULL, *media_comp = NULL, *ven_tag = NULL;
+    GString *udisks2_storage_list, *icons, *features, *moreinfo, *tmp;
+    GString *media_comp = NULL;
+    gchar *devid, *size, *ven_tag = NULL;
     const gchar *url, *media_label, *alabel, *icon, *media_curr = NULL;
     int n = 0, i, j, m;
 
@@ -201,7 +202,8 @@ gboolean __scan_udisks2_devices(void) {
     };
 
     moreinfo_del_with_prefix("DEV:UDISKS");
-    udisks2_storage_list = g_strdup(_("\n[UDisks2]\n"));
+    udisks2_storage_list = g_string_new(_("\n[UDisks2]\n"));
+    icons = g_string_new(NULL);
 
     drives = get_udisks2_drives_ext();
     for (node = drives; node != NULL; node = node->next) {
@@ -235,10 +237,10 @@ gboolean __scan_udisks2_devices(void) {
                 }
 
                 if (media_comp == NULL){
-                    media_comp = g_strdup(media_label);
+                    media_comp = g_string_new(media_label);
                 }
                 else{
-                    media_comp = h_strdup_cprintf(", %s", media_comp, media_label);
+                    g_string_append_printf(media_comp, ", %s", media_label);
                 }
             }
         }
@@ -252,160 +254,155 @@ gboolean __scan_udisks2_devices(void) {
         size = size_human_readable((gfloat) disk->size);
         ven_tag = vendor_list_ribbon(ext->vendors, params.fmt_opts);
 
-        udisks2_storage_list = h_strdup_cprintf("$%s$%s=%s|%s %s\n", udisks2_storage_list, devid, disk->block_dev, size, ven_tag ? ven_tag : "", disk->model);
-        storage_icons = h_strdup_cprintf("Icon$%s$%s=%s.png\n", storage_icons, devid, disk->model, icon);
-        features = h_strdup_cprintf("%s", features, disk->removable ? _("Removable"): _("Fixed"));
+        g_string_append_printf(udisks2_storage_list, "$%s$%s=%s|%s %s\n", devid, disk->block_dev, size, ven_tag ? ven_tag : "", disk->model);
+        g_string_append_printf(icons, "Icon$%s$%s=%s.png\n", devid, disk->model, icon);
+        features = g_string_new(disk->removable ? _("Removable"): _("Fixed"));
 
         if (disk->ejectable) {
-            features = h_strdup_cprintf(", %s", features, _("Ejectable"));
+            g_string_append_printf(features, ", %s", _("Ejectable"));
         }
         if (disk->smart_supported) {
-            features = h_strdup_cprintf(", %s", features, _("Self-monitoring (S.M.A.R.T.)"));
+            g_string_append_printf(features, ", %s", _("Self-monitoring (S.M.A.R.T.)"));
         }
         if (disk->pm_supported) {
-            features = h_strdup_cprintf(", %s", features, _("Power Management"));
+            g_string_append_printf(features, ", %s", _("Power Management"));
         }
         if (disk->apm_supported) {
-            features = h_strdup_cprintf(", %s", features, _("Advanced Power Management"));
+            g_string_append_printf(features, ", %s", _("Advanced Power Management"));
         }
         if (disk->aam_supported) {
-            features = h_strdup_cprintf(", %s", features, _("Automatic Acoustic Management"));
+            g_string_append_printf(features, ", %s", _("Automatic Acoustic Management"));
         }
 
-        moreinfo = g_strdup_printf(_("[Drive Information]\n"
-                                   "Model=%s\n"),
-                                   disk->model);
+        moreinfo = g_string_new(NULL);
+        g_string_append_printf(moreinfo, _("[Drive Information]\n"
+                                         "Model=%s\n"),
+                               disk->model);
 
         if (disk->vendor && *disk->vendor) {
-            moreinfo = h_strdup_cprintf("$^$%s=%s\n",
-                                        moreinfo,
-                                        _("Vendor"), disk->vendor);
+            g_string_append_printf(moreinfo, "$^$%s=%s\n",
+                                   _("Vendor"), disk->vendor);
         }
 
-        moreinfo = h_strdup_cprintf(_("Revision=%s\n"
-                                    "Block Device=%s\n"
-                                    "Serial=%s\n"
-                                    "Size=%s\n"
-                                    "Features=%s\n"),
-                                    moreinfo,
-                                    disk->revision,
-                                    disk->block_dev,
-                                    disk->serial,
-                                    size,
-                                    features);
+        g_string_append_printf(moreinfo, _("Revision=%s\n"
+                                         "Block Device=%s\n"
+                                         "Serial=%s\n"
+                                         "Size=%s\n"
+                                         "Features=%s\n"),
+                               disk->revision,
+                               disk->block_dev,
+                               disk->serial,
+                               size,
+                               features->str);
         g_free(size);
         g_free(ven_tag);
 
         if (disk->rotation_rate > 0) {
-            moreinfo = h_strdup_cprintf(_("Rotation Rate=%d RPM\n"), moreinfo, disk->rotation_rate);
+            g_string_append_printf(moreinfo, _("Rotation Rate=%d RPM\n"), disk->rotation_rate);
         }
         if (media_comp || media_curr) {
-            moreinfo = h_strdup_cprintf(_("Media=%s\n"
-                                        "Media compatibility=%s\n"),
-                                        moreinfo,
-                                        media_curr ? media_curr : _("(None)"),
-                                        media_comp ? media_comp : _("(Unknown)"));
+            g_string_append_printf(moreinfo, _("Media=%s\n"
+                                             "Media compatibility=%s\n"),
+                                   media_curr ? media_curr : _("(None)"),
+                                   media_comp ? media_comp->str : _("(Unknown)"));
         }
         if (disk->connection_bus && strlen(disk->connection_bus) > 0) {
-            moreinfo = h_strdup_cprintf(_("Connection bus=%s\n"), moreinfo, disk->connection_bus);
+            g_string_append_printf(moreinfo, _("Connection bus=%s\n"), disk->connection_bus);
         }
 
-        tmp = NULL;
         if (disk->wwid) {
+            tmp = g_string_new(NULL);
             m = strlen(disk->wwid);
             if (m > 2 && m % 2 == 0){
                 for (j = 4; j < m; j = j + 2) {
-                    tmp = h_strdup_cprintf("%s%c%c", tmp, j > 4 ? "-": "", disk->wwid[j], disk->wwid[j+1]);
+                    g_string_append_printf(tmp, "%s%c%c", j > 4 ? "-": "", disk->wwid[j], disk->wwid[j+1]);
                 }
             }
-            moreinfo = h_strdup_cprintf("%s=%s\n", moreinfo,
-                                        g_str_has_prefix(disk->wwid, "nna.") ? _("WWN"):
-                                            (g_str_has_prefix(disk->wwid, "eui.") ? _("EUI "): "Unknown ID"),
-                                        tmp);
-            g_free(tmp);
+            g_string_append_printf(moreinfo, "%s=%s\n",
+                                   g_str_has_prefix(disk->wwid, "nna.") ? _("WWN"):
+                                       (g_str_has_prefix(disk->wwid, "eui.") ? _("EUI "): "Unknown ID"),
+                                   tmp->str);
+            g_string_free(tmp, TRUE);
         }
         else{
-            moreinfo = h_strdup_cprintf("%s=%s\n", moreinfo, _("WWN / EUI"), _("(None)"));
+            g_string_append_printf(moreinfo, "%s=%s\n", _("WWN / EUI"), _("(None)"));
         }
 
         if (ext->wwid_oui.oui) {
-            moreinfo = h_strdup_cprintf(_("$^$%s=[%s] %s\n"),
-                                          moreinfo,
-                                         _("IEEE OUI"), ext->wwid_oui.oui,
-                                                        ext->wwid_oui.vendor ?
-                                                        ext->wwid_oui.vendor : _("(Unknown)"));
+            g_string_append_printf(moreinfo, _("$^$%s=[%s] %s\n"),
+                                   _("IEEE OUI"), ext->wwid_oui.oui,
+                                                  ext->wwid_oui.vendor ?
+                                                  ext->wwid_oui.vendor : _("(Unknown)"));
         }
 
         if (ext->nvme_controller) {
             gchar *nvme = nvme_pci_sections(ext->nvme_controller);
             if (nvme)
-                moreinfo = h_strdup_cprintf("%s", moreinfo, nvme);
+                g_string_append(moreinfo, nvme);
             g_free(nvme);
         }
         if (disk->smart_enabled) {
-            moreinfo = h_strdup_cprintf(_("[Self-monitoring (S.M.A.R.T.)]\n"
-                                        "Status=%s\n"
-                                        "Bad Sectors=%" G_GINT64_FORMAT "\n"
-                                        "Power on time=%" G_GUINT64_FORMAT " days %" G_GUINT64_FORMAT " hours\n"
-                                        "Temperature=%d°C\n"),
-                                        moreinfo,
-                                        disk->smart_failing ? _("Failing"): _("OK"),
-                                        disk->smart_bad_sectors,
-                                        disk->smart_poweron/(60*60*24), (disk->smart_poweron/60/60) % 24,
-                                        disk->smart_temperature);
+            g_string_append_printf(moreinfo, _("[Self-monitoring (S.M.A.R.T.)]\n"
+                                             "Status=%s\n"
+                                             "Bad Sectors=%" G_GINT64_FORMAT "\n"
+                                             "Power on time=%" G_GUINT64_FORMAT " days %" G_GUINT64_FORMAT " hours\n"
+                                             "Temperature=%d°C\n"),
+                                   disk->smart_failing ? _("Failing"): _("OK"),
+                                   disk->smart_bad_sectors,
+                                   disk->smart_poweron/(60*60*24), (disk->smart_poweron/60/60) % 24,
+                                   disk->smart_temperature);
 
             if (disk->smart_attributes != NULL) {
-                moreinfo = h_strdup_cprintf(_("[S.M.A.R.T. Attributes]\n"
-                                            "Attribute=<tt>Value      / Normalized / Worst / Threshold</tt>\n"),
-                                            moreinfo);
+                g_string_append(moreinfo, _("[S.M.A.R.T. Attributes]\n"
+                                            "Attribute=<tt>Value      / Normalized / Worst / Threshold</tt>\n"));
 
                 attrib = disk->smart_attributes;
 
                 while (attrib != NULL){
-                    tmp = g_strdup("");
+                    tmp = g_string_new(NULL);
 
                     switch (attrib->interpreted_unit){
                         case UDSK_INTPVAL_SKIP:
-                            tmp = h_strdup_cprintf("-", tmp);
+                            g_string_append(tmp, "-");
                             break;
                         case UDSK_INTPVAL_MILISECONDS:
-                            tmp = h_strdup_cprintf("%" G_GINT64_FORMAT " ms", tmp, attrib->interpreted);
+                            g_string_append_printf(tmp, "%" G_GINT64_FORMAT " ms", attrib->interpreted);
                             break;
                         case UDSK_INTPVAL_HOURS:
-                            tmp = h_strdup_cprintf("%" G_GINT64_FORMAT " h", tmp, attrib->interpreted);
+                            g_string_append_printf(tmp, "%" G_GINT64_FORMAT " h", attrib->interpreted);
                             break;
                         case UDSK_INTPVAL_CELSIUS:
-                            tmp = h_strdup_cprintf("%" G_GINT64_FORMAT "°C", tmp, attrib->interpreted);
+                            g_string_append_printf(tmp, "%" G_GINT64_FORMAT "°C", attrib->interpreted);
                             break;
                         case UDSK_INTPVAL_SECTORS:
-                            tmp = h_strdup_cprintf(ngettext("%" G_GINT64_FORMAT " sector",
-                                                            "%" G_GINT64_FORMAT " sectors", attrib->interpreted),
-                                                   tmp, attrib->interpreted);
+                            g_string_append_printf(tmp, ngettext("%" G_GINT64_FORMAT " sector",
+                                                                 "%" G_GINT64_FORMAT " sectors", attrib->interpreted),
+                                                   attrib->interpreted);
                             break;
                         case UDSK_INTPVAL_DIMENSIONLESS:
                         default:
-                            tmp = h_strdup_cprintf("%" G_GINT64_FORMAT, tmp, attrib->interpreted);
+                            g_string_append_printf(tmp, "%" G_GINT64_FORMAT, attrib->interpreted);
                             break;
                     }
 
                     // pad spaces to next col
-                    j = g_utf8_strlen(tmp, -1);
-                    if (j < 13) tmp = h_strdup_cprintf("%*c", tmp, 13 - j, ' ');
+                    j = g_utf8_strlen(tmp->str, -1);
+                    if (j < 13) g_string_append_printf(tmp, "%*c", 13 - j, ' ');
 
                     if (attrib->value != -1)
-                        tmp = h_strdup_cprintf("%-13d", tmp, attrib->value);
+                        g_string_append_printf(tmp, "%-13d", attrib->value);
                     else
-                        tmp = h_strdup_cprintf("%-13s", tmp, "???");
+                        g_string_append_printf(tmp, "%-13s", "???");
 
                     if (attrib->worst != -1)
-                        tmp = h_strdup_cprintf("%-8d", tmp, attrib->worst);
+                        g_string_append_printf(tmp, "%-8d", attrib->worst);
                     else
-                        tmp = h_strdup_cprintf("%-8s", tmp, "???");
+                        g_string_append_printf(tmp, "%-8s", "???");
 
                     if (attrib->threshold != -1)
-                        tmp = h_strdup_cprintf("%d", tmp, attrib->threshold);
+                        g_string_append_printf(tmp, "%d", attrib->threshold);
                     else
-                        tmp = h_strdup_cprintf("???", tmp);
+                        g_string_append(tmp, "???");
 
 
                     alabel = attrib->identifier;
@@ -416,51 +413,48 @@ gboolean __scan_udisks2_devices(void) {
                         }
                     }
 
-                    moreinfo = h_strdup_cprintf(_("(%d) %s=<tt>%s</tt>\n"),
-                                            moreinfo,
-                                            attrib->id, alabel, tmp);
-                    g_free(tmp);
+                    g_string_append_printf(moreinfo, _("(%d) %s=<tt>%s</tt>\n"),
+                                           attrib->id, alabel, tmp->str);
+                    g_string_free(tmp, TRUE);
                     attrib = attrib->next;
                 }
             }
         }
         if (disk->partition_table || disk->partitions) {
-            moreinfo = h_strdup_cprintf(_("[Partition table]\n"
-                                        "Type=%s\n"),
-                                        moreinfo,
-                                        disk->partition_table ? disk->partition_table : _("(Unknown)"));
+            g_string_append_printf(moreinfo, _("[Partition table]\n"
+                                             "Type=%s\n"),
+                                   disk->partition_table ? disk->partition_table : _("(Unknown)"));
 
             if (disk->partitions != NULL) {
                 part = disk->partitions;
                 while (part != NULL){
 
-                    tmp = size_human_readable((gfloat) part->size);
+                    size = size_human_readable((gfloat) part->size);
+                    tmp = g_string_new(size);
+                    g_free(size);
                     if (part->label) {
-                        tmp = h_strdup_cprintf(" - %s", tmp, part->label);
+                        g_string_append_printf(tmp, " - %s", part->label);
                     }
                     if (part->type && part->version) {
-                        tmp = h_strdup_cprintf(" (%s %s)", tmp, part->type, part->version);
+                        g_string_append_printf(tmp, " (%s %s)", part->type, part->version);
                     }
                     else if (part->type) {
-                        tmp = h_strdup_cprintf(" (%s)", tmp, part->type);
+                        g_string_append_printf(tmp, " (%s)", part->type);
                     }
-                    moreinfo = h_strdup_cprintf(_("Partition %s=%s\n"),
-                                                moreinfo,
-                                                part->block, tmp);
-                    g_free(tmp);
+                    g_string_append_printf(moreinfo, _("Partition %s=%s\n"),
+                                           part->block, tmp->str);
+                    g_string_free(tmp, TRUE);
                     part = part->next;
                 }
             }
         }
 
-        moreinfo_add_with_prefix("DEV", devid, moreinfo);
+        moreinfo_add_with_prefix("DEV", devid, g_string_free(moreinfo, FALSE));
         g_free(devid);
-        g_free(features);
-        g_free(media_comp);
+        g_string_free(features, TRUE);
+        if (media_comp)
+            g_string_free(media_comp, TRUE);
         media_comp = NULL;
-
-        features = NULL;
-        moreinfo = NULL;
         devid = NULL;
 
         u2driveext_free(ext);
@@ -468,13 +462,13 @@ gboolean __scan_udisks2_devices(void) {
     g_slist_free(drives);
 
     if (n) {
-        storage_list = h_strconcat(storage_list, udisks2_storage_list, NULL);
-        g_free(udisks2_storage_list);
-        return TRUE;
+        storage_list = h_strconcat(storage_list, udisks2_storage_list->str, NULL);
+        storage_icons = h_strconcat(storage_icons, icons->str, NULL);
     }
 
-    g_free(udisks2_storage_list);
-    return FALSE;
+    g_string_free(udisks2_storage_list, TRUE);
+    g_string_free(icons, TRUE);
+    return n > 0;
 }
 
 /* SCSI support by Pascal F.Martin <pascalmartin@earthlink.net> */
@@ -488,12 +482,13 @@ void __scan_scsi_devices(void)
     gint scsi_id = 0 ;
     gint scsi_lun = 0;
     gchar *vendor = NULL, *revision = NULL, *model = NULL;
-    gchar *scsi_storage_list;
+    GString *scsi_storage_list, *icons;
 
     /* remove old devices from global device table */
     moreinfo_del_with_prefix("DEV:SCSI");
 
-    scsi_storage_list = g_strdup(_("\n[SCSI Disks]\n"));
+    scsi_storage_list = g_string_new(_("\n[SCSI Disks]\n"));
+    icons = g_string_new(NULL);
 
     int otype = 0;
     if (proc_scsi = fopen("/proc/scsi/scsi", "r")) {
@@ -561,23 +556,23 @@ void __scan_scsi_devices(void)
                 }
 
                 gchar *devid = g_strdup_printf("SCSI%d", n);
-                scsi_storage_list = h_strdup_cprintf("$%s$scsi%d=|%s\n", scsi_storage_list, devid, scsi_controller, model);
-                storage_icons = h_strdup_cprintf("Icon$%s$%s=%s.png\n", storage_icons, devid, model, icon);
-
-                gchar *strhash = g_strdup_printf(_("[Device Information]\n"
-                                                 "Model=%s\n"), model);
-
-                strhash = h_strdup_cprintf("$^$%s=%s\n",
-                                           strhash,
-                                           _("Vendor"), model);
-
-                strhash = h_strdup_cprintf(_("Type=%s\n"
-                                           "Revision=%s\n"
-                                           "[SCSI Controller]\n"
-                                           "Controller=scsi%d\n"
-                                           "Channel=%d\n"
-                                           "ID=%d\n" "LUN=%d\n"),
-                                           strhash,
+                g_string_append_printf(scsi_storage_list, "$%s$scsi%d=|%s\n", devid, scsi_controller, model);
+                g_string_append_printf(icons, "Icon$%s$%s=%s.png\n", devid, model, icon);
+
+                GString *strhash = g_string_new(NULL);
+
+                g_string_append_printf(strhash, _("[Device Information]\n"
+                                                "Model=%s\n"), model);
+
+                g_string_append_printf(strhash, "$^$%s=%s\n",
+                                       _("Vendor"), model);
+
+                g_string_append_printf(strhash, _("Type=%s\n"
+                                                "Revision=%s\n"
+                                                "[SCSI Controller]\n"
+                                                "Controller=scsi%d\n"
+                                                "Channel=%d\n"
+                                                "ID=%d\n" "LUN=%d\n"),
                                            type,
                                            revision,
                                            scsi_controller,
@@ -585,7 +580,7 @@ void __scan_scsi_devices(void)
                                            scsi_id,
                                            scsi_lun);
 
-                moreinfo_add_with_prefix("DEV", devid, strhash);
+                moreinfo_add_with_prefix("DEV", devid, g_string_free(strhash, FALSE));
                 g_free(devid);
 
                 g_free(model);
@@ -602,9 +597,12 @@ void __scan_scsi_devices(void)
     }
 
     if (n) {
-      storage_list = h_strconcat(storage_list, scsi_storage_list, NULL);
-      g_free(scsi_storage_list);
+      storage_list = h_strconcat(storage_list, scsi_storage_list->str, NULL);
+      storage_icons = h_strconcat(storage_icons, icons->str, NULL);
     }
+
+    g_string_free(scsi_storage_list, TRUE);
+    g_string_free(icons, TRUE);
 }
 
 void __scan_ide_devices(void)
@@ -613,12 +611,14 @@ void __scan_ide_devices(void)
     gchar *device, *model, *media, *pgeometry = NULL, *lgeometry = NULL;
     gchar iface;
     gint n = 0, i = 0, cache, nn = 0;
-    gchar *capab = NULL, *speed = NULL, *driver = NULL, *ide_storage_list;
+    gchar *speed = NULL, *driver = NULL;
+    GString *capab = NULL, *ide_storage_list, *icons;
 
     /* remove old devices from global device table */
     moreinfo_del_with_prefix("DEV:IDE");
 
-    ide_storage_list = g_strdup(_("\n[IDE Disks]\n"));
+    ide_storage_list = g_string_new(_("\n[IDE Disks]\n"));
+    icons = g_string_new(NULL);
 
     iface = 'a';
     for (i = 0; i <= 16; i++) {
@@ -669,31 +669,30 @@ void __scan_ide_devices(void)
 		    while (fgets(buf, 128, prcap)
 			   && g_timer_elapsed(timer, NULL) < 0.5) {
 			if (g_str_has_prefix(buf, "  Does")) {
+			    if (!capab)
+				capab = g_string_new(NULL);
+
 			    if (g_str_has_suffix(buf, "media\n")
 				&& !strstr(buf, "speed")) {
 				gchar *media_type = g_strstrip(strstr(buf, "Does "));
 				gchar **ttmp = g_strsplit(media_type, " ", 0);
 
-				capab = h_strdup_cprintf("\nCan %s#%d=%s\n", capab, ttmp[1], ++nn, ttmp[2]);
+				g_string_append_printf(capab, "\nCan %s#%d=%s\n", ttmp[1], ++nn, ttmp[2]);
 
 				g_strfreev(ttmp);
 			    } else if (strstr(buf, "Buffer-Underrun-Free")) {
-				capab =
-				    h_strdup_cprintf
-				    ("\nSupports BurnProof=%s\n", capab, strstr(buf, "Does not") ? "No" : "Yes");
+				g_string_append_printf(capab,
+				    "\nSupports BurnProof=%s\n", strstr(buf, "Does not") ? "No" : "Yes");
 			    } else if (strstr(buf, "multi-session")) {
-				capab =
-				    h_strdup_cprintf
-				    ("\nCan read multi-session CDs=%s\n",
-				     capab, strstr(buf, "Does not") ? "No" : "Yes");
+				g_string_append_printf(capab,
+				    "\nCan read multi-session CDs=%s\n",
+				    strstr(buf, "Does not") ? "No" : "Yes");
 			    } else if (strstr(buf, "audio CDs")) {
-				capab =
-				    h_strdup_cprintf
-				    ("\nCan play audio CDs=%s\n", capab, strstr(buf, "Does not") ? "No" : "Yes");
+				g_string_append_printf(capab,
+				    "\nCan play audio CDs=%s\n", strstr(buf, "Does not") ? "No" : "Yes");
 			    } else if (strstr(buf, "PREVENT/ALLOW")) {
-				capab =
-				    h_strdup_cprintf
-				    ("\nCan lock media=%s\n", capab, strstr(buf, "Does not") ? "No" : "Yes");
+				g_string_append_printf(capab,
+				    "\nCan lock media=%s\n", strstr(buf, "Does not") ? "No" : "Yes");
 			    }
 			} else if ((strstr(buf, "read")
 				    || strstr(buf, "write"))
@@ -759,29 +758,30 @@ void __scan_ide_devices(void)
 
 	    gchar *devid = g_strdup_printf("IDE%d", n);
 
-	    ide_storage_list = h_strdup_cprintf("$%s$hd%c=|%s\n", ide_storage_list, devid, iface, model);
-	    storage_icons =
-		h_strdup_cprintf("Icon$%s$%s=%s.png\n", storage_icons,
-				 devid, model, g_str_equal(media, "cdrom") ? "cdrom" : "hdd");
+	    g_string_append_printf(ide_storage_list, "$%s$hd%c=|%s\n", devid, iface, model);
+	    g_string_append_printf(icons, "Icon$%s$%s=%s.png\n",
+				   devid, model, g_str_equal(media, "cdrom") ? "cdrom" : "hdd");
 
-	    gchar *strhash = g_strdup_printf(_("[Device Information]\n" "Model=%s\n"),
-					     model);
+	    GString *strhash = g_string_new(NULL);
 
-            strhash = h_strdup_cprintf("$^$%s=%s\n",
-                            strhash, _("Vendor"), model);
+	    g_string_append_printf(strhash, _("[Device Information]\n" "Model=%s\n"),
+				   model);
 
-	    strhash = h_strdup_cprintf(_("Device Name=hd%c\n"
-					 "Media=%s\n" "Cache=%dkb\n"), strhash, iface, media, cache);
+            g_string_append_printf(strhash, "$^$%s=%s\n",
+                                   _("Vendor"), model);
+
+	    g_string_append_printf(strhash, _("Device Name=hd%c\n"
+					    "Media=%s\n" "Cache=%dkb\n"), iface, media, cache);
 	    if (driver) {
-		strhash = h_strdup_cprintf("%s\n", strhash, driver);
+		g_string_append_printf(strhash, "%s\n", driver);
 
 		g_free(driver);
 		driver = NULL;
 	    }
 
 	    if (pgeometry && lgeometry) {
-		strhash = h_strdup_cprintf(_("[Geometry]\n"
-					     "Physical=%s\n" "Logical=%s\n"), strhash, pgeometry, lgeometry);
+		g_string_append_printf(strhash, _("[Geometry]\n"
+						"Physical=%s\n" "Logical=%s\n"), pgeometry, lgeometry);
 
 		g_free(pgeometry);
 		pgeometry = NULL;
@@ -790,20 +790,21 @@ void __scan_ide_devices(void)
 	    }
 
 	    if (capab) {
-		strhash = h_strdup_cprintf(_("[Capabilities]\n%s"), strhash, capab);
+		if (capab->len)
+		    g_string_append_printf(strhash, _("[Capabilities]\n%s"), capab->str);
 
-		g_free(capab);
+		g_string_free(capab, TRUE);
 		capab = NULL;
 	    }
 
 	    if (speed) {
-		strhash = h_strdup_cprintf(_("[Speeds]\n%s"), strhash, speed);
+		g_string_append_printf(strhash, _("[Speeds]\n%s"), speed);
 
 		g_free(speed);
 		speed = NULL;
 	    }
 
-	    moreinfo_add_with_prefix("DEV", devid, strhash);
+	    moreinfo_add_with_prefix("DEV", devid, g_string_free(strhash, FALSE));
 	    g_free(devid);
 	    g_free(model);
 	} else {
@@ -814,7 +815,10 @@ void __scan_ide_devices(void)
     }
 
     if (n) {
-	storage_list = h_strconcat(storage_list, ide_storage_list, NULL);
-	g_free(ide_storage_list);
+	storage_list = h_strconcat(storage_list, ide_storage_list->str, NULL);
+	storage_icons = h_strconcat(storage_icons, icons->str, NULL);
     }
+
+    g_string_free(ide_storage_list, TRUE);
+    g_string_free(icons, TRUE);
 }
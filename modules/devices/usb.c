@@ -98,10 +98,10 @@ static const char* get_usbdev_icon(const usbd *u) {
     return icon;
 }
 
-static void _usb_dev(const usbd *u) {
+static void _usb_dev(const usbd *u, GString *list, GString *icons) {
     gchar *name, *key, *label, *str, *speed;
     gchar *product, *vendor, *manufacturer, *device;  /* don't free */
-    gchar *interfaces = strdup("");
+    GString *interfaces = g_string_new(NULL);
     usbi *i;
     const char* icon;
 
@@ -120,18 +120,17 @@ static void _usb_dev(const usbd *u) {
     label = g_strdup_printf("%03d:%03d", u->bus, u->dev);
     icon = get_usbdev_icon(u);
 
-    usb_list = h_strdup_cprintf("$%s$%s=%s\n", usb_list, key, label, name);
-    usb_icons = h_strdup_cprintf("Icon$%s$%s=%s.png\n", usb_icons, key, label, icon ? icon: "usb");
+    g_string_append_printf(list, "$%s$%s=%s\n", key, label, name);
+    g_string_append_printf(icons, "Icon$%s$%s=%s.png\n", key, label, icon ? icon: "usb");
 
     if (u->if_list != NULL) {
         i = u->if_list;
         while (i != NULL){
-            interfaces = h_strdup_cprintf("[%s %d %s]\n"
+            g_string_append_printf(interfaces, "[%s %d %s]\n"
                 /* Class */       "%s=[%d] %s\n"
                 /* Sub-class */   "%s=[%d] %s\n"
                 /* Protocol */    "%s=[%d] %s\n"
                 /* Driver */      "%s=%s\n",
-                    interfaces,
                     _("Interface"), i->if_number, i->if_label? i->if_label: "",
                     _("Class"), i->if_class, UNKIFNULL_AC(i->if_class_str),
                     _("Sub-class"), i->if_subclass, UNKIFNULL_AC(i->if_subclass_str),
@@ -182,7 +181,7 @@ static void _usb_dev(const usbd *u) {
                 _("Connection"),
                 _("Bus"), u->bus,
                 _("Device"), u->dev,
-                interfaces
+                interfaces->str
                 );
 
     moreinfo_add_with_prefix("DEV", key, str); /* str now owned by morinfo */
@@ -191,7 +190,7 @@ static void _usb_dev(const usbd *u) {
     g_free(name);
     g_free(key);
     g_free(label);
-    g_free(interfaces);
+    g_string_free(interfaces, TRUE);
 }
 
 void __scan_usb(void) {
@@ -200,25 +199,27 @@ void __scan_usb(void) {
 
     int c = usbd_list_count(list);
 
-    if (usb_list) {
+    GString *devs = g_string_new(NULL);
+    GString *icons = g_string_new(NULL);
+
+    if (usb_list)
         moreinfo_del_with_prefix("DEV:USB");
-        g_free(usb_list);
-    }
-    if (usb_icons){
-       g_free(usb_icons);
-       usb_icons = NULL;
-    }
-    usb_list = g_strdup_printf("[%s]\n", _("USB Devices"));
+    g_string_append_printf(devs, "[%s]\n", _("USB Devices"));
 
     if (c > 0) {
         while(curr) {
-            _usb_dev(curr);
+            _usb_dev(curr, devs, icons);
             curr=curr->next;
         }
 
         usbd_list_free(list);
     } else {
         /* No USB? */
-        usb_list = g_strconcat(usb_list, _("No USB devices found."), "=\n", NULL);
+        g_string_append_printf(devs, "%s=\n", _("No USB devices found."));
     }
+
+    g_free(usb_list);
+    g_free(usb_icons);
+    usb_list = g_string_free(devs, FALSE);
+    usb_icons = g_string_free(icons, FALSE);
 }
@@ -141,7 +141,7 @@ void get_processor_strfamily(Processor * processor)
 
 static gchar *__cache_get_info_as_string(Processor *processor)
 {
-    gchar *result = g_strdup("");
+    GString *result;
     GSList *cache_list;
     ProcessorCache *cache;
 
@@ -149,11 +149,12 @@ static gchar *__cache_get_info_as_string(Processor *processor)
         return g_strdup(_("Cache information not available=\n"));
     }
 
+    result = g_string_new(NULL);
+
     for (cache_list = processor->cache; cache_list; cache_list = cache_list->next) {
         cache = (ProcessorCache *)cache_list->data;
 
-        result = h_strdup_cprintf(_("Level %d (%s)=%d-way set-associative, %d sets, %dKB size\n"),
-                                  result,
+        g_string_append_printf(result, _("Level %d (%s)=%d-way set-associative, %d sets, %dKB size\n"),
                                   cache->level,
                                   C_("cache-type", cache->type),
                                   cache->ways_of_associativity,
@@ -161,7 +162,7 @@ static gchar *__cache_get_info_as_string(Processor *processor)
                                   cache->size);
     }
 
-    return result;
+    return g_string_free(result, FALSE);
 }
 
 /* This is not used directly, but creates translatable strings for
@@ -265,13 +266,15 @@ static gint cmp_cpufreq_data_ignore_affected(cpufreq_data *a, cpufreq_data *b) {
 
 gchar *clocks_summary(GSList * processors)
 {
-    gchar *ret = g_strdup_printf("[%s]\n", _("Clocks"));
+    GString *ret = g_string_new(NULL);
     GSList *all_clocks = NULL, *uniq_clocks = NULL;
     GSList *tmp, *l;
     Processor *p;
     cpufreq_data *c, *cur = NULL;
     gint cur_count = 0, i = 0;
 
+    g_string_append_printf(ret, "[%s]\n", _("Clocks"));
+
     /* create list of all clock references */
     for (l = processors; l; l = l->next) {
         p = (Processor*)l->data;
@@ -281,9 +284,9 @@ gchar *clocks_summary(GSList * processors)
     }
 
     if (g_slist_length(all_clocks) == 0) {
-        ret = h_strdup_cprintf("%s=\n", ret, _("(Not Available)") );
+        g_string_append_printf(ret, "%s=\n", _("(Not Available)") );
         g_slist_free(all_clocks);
-        return ret;
+        return g_string_free(ret, FALSE);
     }
 
     /* ignore duplicate references */
@@ -311,8 +314,7 @@ gchar *clocks_summary(GSList * processors)
             cur_count = 1;
         } else {
             if (cmp_cpufreq_data_ignore_affected(cur, c) != 0) {
-                ret = h_strdup_cprintf(_("%.2f-%.2f %s=%dx\n"),
-                                ret,
+                g_string_append_printf(ret, _("%.2f-%.2f %s=%dx\n"),
                                 khzint_to_mhzdouble(cur->cpukhz_min),
                                 khzint_to_mhzdouble(cur->cpukhz_max),
                                 _("MHz"),
@@ -324,8 +326,7 @@ gchar *clocks_summary(GSList * processors)
             }
         }
     }
-    ret = h_strdup_cprintf(_("%.2f-%.2f %s=%dx\n"),
-                    ret,
+    g_string_append_printf(ret, _("%.2f-%.2f %s=%dx\n"),
                     khzint_to_mhzdouble(cur->cpukhz_min),
                     khzint_to_mhzdouble(cur->cpukhz_max),
                     _("MHz"),
@@ -333,7 +334,7 @@ gchar *clocks_summary(GSList * processors)
 
     g_slist_free(all_clocks);
     g_slist_free(uniq_clocks);
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 #define cmp_cache_test(f) if (a->f < b->f) return -1; if (a->f > b->f) return 1;
@@ -364,13 +365,15 @@ static gint cmp_cache_ignore_id(ProcessorCache *a, ProcessorCache *b) {
 
 gchar *caches_summary(GSList * processors)
 {
-    gchar *ret = g_strdup_printf("[%s]\n", _("Caches"));
+    GString *ret = g_string_new(NULL);
     GSList *all_cache = NULL, *uniq_cache = NULL;
     GSList *tmp, *l;
     Processor *p;
     ProcessorCache *c, *cur = NULL;
     gint cur_count = 0, i = 0;
 
+    g_string_append_printf(ret, "[%s]\n", _("Caches"));
+
     /* create list of all cache references */
     for (l = processors; l; l = l->next) {
         p = (Processor*)l->data;
@@ -385,9 +388,9 @@ gchar *caches_summary(GSList * processors)
     }
 
     if (g_slist_length(all_cache) == 0) {
-        ret = h_strdup_cprintf("%s=\n", ret, _("(Not Available)") );
+        g_string_append_printf(ret, "%s=\n", _("(Not Available)") );
         g_slist_free(all_cache);
-        return ret;
+        return g_string_free(ret, FALSE);
     }
 
     /* ignore duplicate references */
@@ -415,8 +418,7 @@ gchar *caches_summary(GSList * processors)
             cur_count = 1;
         } else {
             if (cmp_cache_ignore_id(cur, c) != 0) {
-                ret = h_strdup_cprintf(_("Level %d (%s)#%d=%dx %dKB (%dKB), %d-way set-associative, %d sets\n"),
-                                      ret,
+                g_string_append_printf(ret, _("Level %d (%s)#%d=%dx %dKB (%dKB), %d-way set-associative, %d sets\n"),
                                       cur->level,
                                       C_("cache-type", cur->type),
                                       cur->phy_sock,
@@ -432,8 +434,7 @@ gchar *caches_summary(GSList * processors)
             }
         }
     }
-    ret = h_strdup_cprintf(_("Level %d (%s)#%d=%dx %dKB (%dKB), %d-way set-associative, %d sets\n"),
-                          ret,
+    g_string_append_printf(ret, _("Level %d (%s)#%d=%dx %dKB (%dKB), %d-way set-associative, %d sets\n"),
                           cur->level,
                           C_("cache-type", cur->type),
                           cur->phy_sock,
@@ -445,7 +446,7 @@ gchar *caches_summary(GSList * processors)
 
     g_slist_free(all_cache);
     g_slist_free(uniq_cache);
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 #define PROC_SCAN_READ_BUFFER_SIZE 1024
@@ -581,7 +582,7 @@ gchar *processor_get_capabilities_from_flags(gchar *strflags, gchar *lookup_pref
     gchar **flags, **old;
     gchar tmp_flag[64] = "";
     const gchar *meaning;
-    gchar *tmp = NULL;
+    GString *tmp = g_string_new(NULL);
     gint j = 0, i = 0;
 
     flags = g_strsplit(strflags, " ", 0);
@@ -591,7 +592,7 @@ gchar *processor_get_capabilities_from_flags(gchar *strflags, gchar *lookup_pref
         if ( sscanf(flags[j], "[%d]", &i) ) {
             /* Some flags are indexes, like [13], and that looks like
              * a new section to hardinfo shell */
-            tmp = h_strdup_cprintf("(%s%d)=\n", tmp,
+            g_string_append_printf(tmp, "(%s%d)=\n",
                 (lookup_prefix) ? lookup_prefix : "",
                 i );
         } else {
@@ -599,18 +600,18 @@ gchar *processor_get_capabilities_from_flags(gchar *strflags, gchar *lookup_pref
             meaning = x86_flag_meaning(tmp_flag);
 
             if (meaning) {
-                tmp = h_strdup_cprintf("%s=%s\n", tmp, flags[j], meaning);
+                g_string_append_printf(tmp, "%s=%s\n", flags[j], meaning);
             } else {
-                tmp = h_strdup_cprintf("%s=\n", tmp, flags[j]);
+                g_string_append_printf(tmp, "%s=\n", flags[j]);
             }
         }
         j++;
     }
-    if (tmp == NULL || g_strcmp0(tmp, "") == 0)
-        tmp = g_strdup_printf("%s=%s\n", "empty", _("Empty List"));
+    if (tmp->len == 0)
+        g_string_append_printf(tmp, "%s=%s\n", "empty", _("Empty List"));
 
     g_strfreev(old);
-    return tmp;
+    return g_string_free(tmp, FALSE);
 }
 
 gchar *processor_get_detailed_info(Processor * processor)
@@ -683,19 +684,18 @@ gchar *processor_describe(GSList * processors) {
 }
 
 gchar *dmi_socket_info() {
-    gchar *ret;
+    GString *ret = g_string_new(NULL);
     dmi_type dt = 4;
     int i;
     dmi_handle_list *hl = dmidecode_handles(&dt);
 
     if (!hl) {
-        ret = g_strdup_printf("[%s]\n%s=%s\n",
+        g_string_append_printf(ret, "[%s]\n%s=%s\n",
                 _("Socket Information"), _("Result"),
                 (getuid() == 0)
                 ? _("(Not available)")
                 : _("(Not available; Perhaps try running HardInfo as root.)") );
     } else {
-        ret = g_strdup("");
         for(i = 0; i < hl->count; i++) {
             dmi_handle h = hl->handles[i];
             gchar *upgrade = dmidecode_match("Upgrade", &dt, &h);
@@ -704,13 +704,12 @@ gchar *dmi_socket_info() {
             gchar *voltage_str = dmidecode_match("Voltage", &dt, &h);
             gchar *max_speed_str = dmidecode_match("Max Speed", &dt, &h);
 
-            ret = h_strdup_cprintf("[%s (%d) %s]\n"
+            g_string_append_printf(ret, "[%s (%d) %s]\n"
                             "%s=0x%x\n"
                             "%s=%s\n"
                             "%s=%s\n"
                             "%s=%s\n"
                             "%s=%s\n",
-                            ret,
                             _("CPU Socket"), i, socket,
                             _("DMI Handle"), h,
                             _("Type"), upgrade,
@@ -728,7 +727,7 @@ gchar *dmi_socket_info() {
         dmi_handle_list_free(hl);
     }
 
-    return ret;
+    return g_string_free(ret, FALSE);
 }
 
 gchar *processor_meta(GSList * processors) {
@@ -764,12 +763,13 @@ gchar *processor_meta(GSList * processors) {
 gchar *processor_get_info(GSList * processors)
 {
     Processor *processor;
-    gchar *ret, *tmp, *hashkey;
+    gchar *ret, *hashkey;
     gchar *meta; /* becomes owned by more_info? no need to free? */
     GSList *l;
-    gchar *icons=g_strdup("");
+    GString *tmp = g_string_new(NULL);
+    GString *icons = g_string_new(NULL);
 
-    tmp = g_strdup_printf("$!CPU_META$%s=|Summary\n", "all");
+    g_string_append_printf(tmp, "$!CPU_META$%s=|Summary\n", "all");
 
     meta = processor_meta(processors);
     moreinfo_add_with_prefix("DEV", "CPU_META", meta);
@@ -783,10 +783,10 @@ gchar *processor_get_info(GSList * processors)
             tag_vendor(&model_name, 0, v->name_short ? v->name_short : v->name, v->ansi_color, params.fmt_opts);
 
         // bp: not convinced it looks good, but here's how it would be done...
-        //icons = h_strdup_cprintf("Icon$CPU%d$cpu%d=processor.png\n", icons, processor->id, processor->id);
+        //g_string_append_printf(icons, "Icon$CPU%d$cpu%d=processor.png\n", processor->id, processor->id);
 
-        tmp = g_strdup_printf("%s$CPU%d$cpu%d=%.2f %s|%s|%d:%d\n",
-                  tmp, processor->id,
+        g_string_append_printf(tmp, "$CPU%d$cpu%d=%.2f %s|%s|%d:%d\n",
+                  processor->id,
                   processor->id,
                   processor->cpu_mhz, _("MHz"),
                   model_name,
@@ -809,9 +809,9 @@ gchar *processor_get_info(GSList * processors)
                   "ShowColumnHeaders=true\n"
                   "%s"
                   "[Processors]\n"
-                  "%s", _("Device"), _("Frequency"), _("Model"), _("Socket:Core"), icons, tmp);
-    g_free(tmp);
-    g_free(icons);
+                  "%s", _("Device"), _("Frequency"), _("Model"), _("Socket:Core"), icons->str, tmp->str);
+    g_string_free(tmp, TRUE);
+    g_string_free(icons, TRUE);
 
     // now here's something fun...
     struct Info *i = info_unflatten(ret);
@@ -79,6 +79,7 @@ void scan_shares(gboolean reload)
 static gchar *__statistics = NULL;
 void scan_statistics(gboolean reload)
 {
+    GString *stats;
     FILE *netstat;
     gchar buffer[256];
     gchar *netstat_path;
@@ -86,8 +87,7 @@ void scan_statistics(gboolean reload)
 
     SCAN_START();
 
-    g_free(__statistics);
-    __statistics = g_strdup("");
+    stats = g_string_new(NULL);
 
     if ((netstat_path = find_program("netstat"))) {
       gchar *command_line = g_strdup_printf("%s -s", netstat_path);
@@ -99,8 +99,7 @@ void scan_statistics(gboolean reload)
 
             tmp = g_ascii_strup(strend(buffer, ':'), -1);
 
-            __statistics = h_strdup_cprintf("[%s]\n",
-                                            __statistics,
+            g_string_append_printf(stats, "[%s]\n",
                                             tmp);
             g_free(tmp);
 
@@ -110,12 +109,10 @@ void scan_statistics(gboolean reload)
             while (*tmp && isspace(*tmp)) tmp++;
                 /* the bolded-space/dot used here is a hardinfo shell hack */
                 if (params.markup_ok)
-                    __statistics = h_strdup_cprintf("<b> </b>#%d=%s\n",
-                                            __statistics,
+                    g_string_append_printf(stats, "<b> </b>#%d=%s\n",
                                             line++, tmp);
                 else
-                    __statistics = h_strdup_cprintf(">#%d=%s\n",
-                                            __statistics,
+                    g_string_append_printf(stats, ">#%d=%s\n",
                                             line++, tmp);
           }
         }
@@ -127,19 +124,22 @@ void scan_statistics(gboolean reload)
       g_free(netstat_path);
     }
 
+    g_free(__statistics);
+    __statistics = g_string_free(stats, FALSE);
+
     SCAN_END();
 }
 
 static gchar *__nameservers = NULL;
 void scan_dns(gboolean reload)
 {
+    GString *ns;
     FILE *resolv;
     gchar buffer[256];
 
     SCAN_START();
 
-    g_free(__nameservers);
-    __nameservers = g_strdup("");
+    ns = g_string_new(NULL);
 
     if ((resolv = fopen("/etc/resolv.conf", "r"))) {
       while (fgets(buffer, 256, resolv)) {
@@ -154,12 +154,10 @@ void scan_dns(gboolean reload)
           sa.sin_addr.s_addr = inet_addr(ip);
 
           if (getnameinfo((struct sockaddr *)&sa, sizeof(sa), hbuf, sizeof(hbuf), NULL, 0, NI_NAMEREQD)) {
-              __nameservers = h_strdup_cprintf("%s=\n",
-                                               __nameservers,
+              g_string_append_printf(ns, "%s=\n",
                                                ip);
           } else {
-              __nameservers = h_strdup_cprintf("%s=%s\n",
-                                               __nameservers,
+              g_string_append_printf(ns, "%s=%s\n",
                                                ip, hbuf);
           }
 
@@ -169,6 +167,9 @@ void scan_dns(gboolean reload)
       fclose(resolv);
     }
 
+    g_free(__nameservers);
+    __nameservers = g_string_free(ns, FALSE);
+
     SCAN_END();
 }
 
@@ -182,14 +183,14 @@ void scan_network(gboolean reload)
 static gchar *__routing_table = NULL;
 void scan_route(gboolean reload)
 {
+    GString *routes;
     FILE *route;
     gchar buffer[256];
     gchar *route_path;
 
     SCAN_START();
 
-    g_free(__routing_table);
-    __routing_table = g_strdup("");
+    routes = g_string_new(NULL);
 
     if ((route_path = find_program("route"))) {
       gchar *command_line = g_strdup_printf("%s -n", route_path);
@@ -205,8 +206,7 @@ void scan_route(gboolean reload)
           buffer[47] = '\0';
           buffer[53] = '\0';
 
-          __routing_table = h_strdup_cprintf("%s / %s=%s|%s|%s\n",
-                                             __routing_table,
+          g_string_append_printf(routes, "%s / %s=%s|%s|%s\n",
                                              g_strstrip(buffer), g_strstrip(buffer + 16),
                                              g_strstrip(buffer + 72),
                                              g_strstrip(buffer + 48),
@@ -220,19 +220,22 @@ void scan_route(gboolean reload)
       g_free(route_path);
     }
 
+    g_free(__routing_table);
+    __routing_table = g_string_free(routes, FALSE);
+
     SCAN_END();
 }
 
 static gchar *__arp_table = NULL;
 void scan_arp(gboolean reload)
 {
+    GString *arp_table;
     FILE *arp;
     gchar buffer[256];
 
     SCAN_START();
 
-    g_free(__arp_table);
-    __arp_table = g_strdup("");
+    arp_table = g_string_new(NULL);
 
     if ((arp = fopen("/proc/net/arp", "r"))) {
       /* eat first line */
@@ -242,8 +245,7 @@ void scan_arp(gboolean reload)
         buffer[15] = '\0';
         buffer[58] = '\0';
 
-        __arp_table = h_strdup_cprintf("%s=%s|%s\n",
-                                       __arp_table,
+        g_string_append_printf(arp_table, "%s=%s|%s\n",
                                        g_strstrip(buffer),
                                        g_strstrip(buffer + 72),
                                        g_strstrip(buffer + 41));
@@ -252,20 +254,23 @@ void scan_arp(gboolean reload)
       fclose(arp);
     }
 
+    g_free(__arp_table);
+    __arp_table = g_string_free(arp_table, FALSE);
+
     SCAN_END();
 }
 
 static gchar *__connections = NULL;
 void scan_connections(gboolean reload)
 {
+    GString *conns;
     FILE *netstat;
     gchar buffer[256];
     gchar *netstat_path;
 
     SCAN_START();
 
-    g_free(__connections);
-    __connections = g_strdup("");
+    conns = g_string_new(NULL);
 
     if ((netstat_path = find_program("netstat"))) {
       gchar *command_line = g_strdup_printf("%s -an", netstat_path);
@@ -277,8 +282,7 @@ void scan_connections(gboolean reload)
           buffer[67] = '\0';
 
           if (g_str_has_prefix(buffer, "tcp") || g_str_has_prefix(buffer, "udp")) {
-            __connections = h_strdup_cprintf("%s=%s|%s|%s\n",
-                                             __connections,
+            g_string_append_printf(conns, "%s=%s|%s|%s\n",
                                              g_strstrip(buffer + 20),	/* local address */
                                              g_strstrip(buffer),		/* protocol */
                                              g_strstrip(buffer + 44),	/* foreign address */
@@ -293,6 +297,9 @@ void scan_connections(gboolean reload)
       g_free(netstat_path);
     }
 
+    g_free(__connections);
+    __connections = g_string_free(conns, FALSE);
+
     SCAN_END();
 }
 
@@ -393,7 +400,7 @@ gchar *hi_more_info(gchar * entry)
     gchar *info = moreinfo_lookup_with_prefix("NET", entry);
 
     if (info)
-	return g_strdup(info);
+	return info;
 
     return g_strdup_printf("[%s]", entry);
 }
@@ -327,7 +327,8 @@ static void scan_net_interfaces_24(void)
     FILE *proc_net;
     NetInfo ni;
     gchar buffer[256];
-    gchar *devid, *detailed;
+    GString *ifaces, *icons, *detailed;
+    gchar *devid;
     gdouble recv_bytes;
     gdouble recv_errors;
     gdouble recv_packets;
@@ -346,16 +347,13 @@ static void scan_net_interfaces_24(void)
     return;
     }
 
-    g_free(network_interfaces);
-
-    g_free(network_icons);
-
-    network_interfaces = g_strdup_printf("[%s]\n", _("Network Interfaces"));
-    network_icons = g_strdup("");
+    ifaces = g_string_new(NULL);
+    icons = g_string_new(NULL);
+    g_string_append_printf(ifaces, "[%s]\n", _("Network Interfaces"));
 
     proc_net = fopen("/proc/net/dev", "r");
     if (!proc_net)
-        return;
+        goto out;
 
     while (fgets(buffer, 256, proc_net)) {
     if (strchr(buffer, ':')) {
@@ -388,18 +386,16 @@ static void scan_net_interfaces_24(void)
 
         devid = g_strdup_printf("NET%s", ifacename);
 
-        network_interfaces =
-        h_strdup_cprintf
-        ("$%s$%s=%s|%.2lf%s|%.2lf%s\n",
-         network_interfaces, devid, ifacename, ni.ip[0] ? ni.ip : "",
+        g_string_append_printf(ifaces, "$%s$%s=%s|%.2lf%s|%.2lf%s\n",
+         devid, ifacename, ni.ip[0] ? ni.ip : "",
          trans_mb, _("MiB"), recv_mb, _("MiB"));
         net_get_iface_type(ifacename, &iface_type, &iface_icon, &ni);
 
-        network_icons = h_strdup_cprintf("Icon$%s$%s=%s.png\n",
-                         network_icons, devid,
+        g_string_append_printf(icons, "Icon$%s$%s=%s.png\n", devid,
                          ifacename, iface_icon);
 
-        detailed = g_strdup_printf("[%s]\n"
+        detailed = g_string_new(NULL);
+        g_string_append_printf(detailed, "[%s]\n"
                        "%s=%s\n" /* Interface Type */
                        "%s=%02x:%02x:%02x:%02x:%02x:%02x\n" /* MAC */
                        "%s=%d\n" /* MTU */
@@ -437,7 +433,7 @@ static void scan_net_interfaces_24(void)
                 txpower = g_strdup(_("(Unknown)"));
             }
 
-            detailed = h_strdup_cprintf("\n[%s]\n"
+            g_string_append_printf(detailed, "\n[%s]\n"
                 "%s=%s\n" /* Network Name (SSID) */
                 "%s=%d%s\n" /* Bit Rate */
                 "%s=%s\n" /* Transmission Power */
@@ -445,7 +441,6 @@ static void scan_net_interfaces_24(void)
                 "%s=%d\n" /* Status */
                 "%s=%d\n" /* Link Quality */
                 "%s=%d %s / %d %s (%s)\n",
-                detailed,
                 _("Wireless Properties"),
                 _("Network Name (SSID)"), ni.wi_essid,
                 _("Bit Rate"), ni.wi_rate / 1000000, _("Mb/s"),
@@ -463,11 +458,10 @@ static void scan_net_interfaces_24(void)
 #endif
 
         if (ni.ip[0] || ni.mask[0] || ni.broadcast[0]) {
-        detailed =
-            h_strdup_cprintf("\n[%s]\n"
+        g_string_append_printf(detailed, "\n[%s]\n"
                      "%s=%s\n"
                      "%s=%s\n"
-                     "%s=%s\n", detailed,
+                     "%s=%s\n",
                      _("Internet Protocol (IPv4)"),
                      _("IP Address"), ni.ip[0] ? ni.ip : _("(Not set)"),
                      _("Mask"), ni.mask[0] ? ni.mask : _("(Not set)"),
@@ -475,11 +469,17 @@ static void scan_net_interfaces_24(void)
                         ni.broadcast[0] ? ni.broadcast : _("(Not set)") );
         }
 
-        moreinfo_add_with_prefix("NET", devid, detailed);
+        moreinfo_add_with_prefix("NET", devid, g_string_free(detailed, FALSE));
         g_free(devid);
     }
     }
     fclose(proc_net);
+
+out:
+    g_free(network_interfaces);
+    g_free(network_icons);
+    network_interfaces = g_string_free(ifaces, FALSE);
+    network_icons = g_string_free(icons, FALSE);
 }
 
 void scan_net_interfaces(void)
@@ -26,14 +26,11 @@ gchar *nfs_shares_list = NULL;
 void
 scan_nfs_shared_directories(void)
 {
+    GString *exports_str = g_string_new(NULL);
     FILE *exports;
     gint count = 0;
     gchar buf[512];
     
-    g_free(nfs_shares_list);
-
-    nfs_shares_list = g_strdup("");
-    
     if ((exports = fopen("/etc/exports", "r"))) {
         while (fgets(buf, 512, exports)) {
             if (buf[0] != '/')
@@ -42,18 +39,17 @@ scan_nfs_shared_directories(void)
             strend(buf, ' ');
             strend(buf, '\t');
 
-            nfs_shares_list = h_strdup_cprintf("%s=\n", 
-                                               nfs_shares_list, buf);
+            g_string_append_printf(exports_str, "%s=\n", buf);
             count++;
         }
 
         fclose(exports);
     }
 
-    if (!count) {
-        g_free(nfs_shares_list);
-        
-        nfs_shares_list = g_strdup("No NFS exports=\n");
-    }
+    if (!count)
+        g_string_assign(exports_str, "No NFS exports=\n");
+
+    g_free(nfs_shares_list);
+    nfs_shares_list = g_string_free(exports_str, FALSE);
 }
 
@@ -22,6 +22,7 @@
 #include "network.h"
 
 gchar *smb_shares_list = NULL;
+static GString *smb_shares_str;
 
 void scan_samba_from_string(gchar *str, gsize length);
 void scan_samba_usershares(void);
@@ -32,10 +33,7 @@ scan_samba(void)
     gchar *str;
     gsize length;
 
-    if (smb_shares_list) {
-        g_free(smb_shares_list);
-        smb_shares_list = g_strdup("");
-    }
+    smb_shares_str = g_string_new(NULL);
 
     if (g_file_get_contents("/etc/samba/smb.conf",
                             &str, &length, NULL)) {
@@ -45,6 +43,9 @@ scan_samba(void)
     }
 
     scan_samba_usershares();
+
+    g_free(smb_shares_list);
+    smb_shares_list = g_string_free(smb_shares_str, FALSE);
 }
 
 void
@@ -96,7 +97,7 @@ scan_samba_from_string(gchar *str, gsize length)
         if (*_smbconf == ';') *_smbconf = '\0';
 
     if (!g_key_file_load_from_data(keyfile, str, length, 0, &error)) {
-        smb_shares_list = g_strdup("Cannot parse smb.conf=\n");
+        g_string_append(smb_shares_str, "Cannot parse smb.conf=\n");
         if (error)
             g_error_free(error);
         goto cleanup;
@@ -106,8 +107,7 @@ scan_samba_from_string(gchar *str, gsize length)
     while (groups[i]) {
         if (g_key_file_has_key(keyfile, groups[i], "path", NULL)) {
             gchar *path = g_key_file_get_string(keyfile, groups[i], "path", NULL);
-            smb_shares_list = h_strdup_cprintf("%s=%s\n",
-                                               smb_shares_list,
+            g_string_append_printf(smb_shares_str, "%s=%s\n",
                                                groups[i], path);
             g_free(path);
         }
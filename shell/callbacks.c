@@ -86,7 +86,7 @@ void cb_copy_to_clipboard()
 	report_table(ctx, data);
 	report_footer(ctx);
 
-	gtk_clipboard_set_text(clip, ctx->output, -1);
+	gtk_clipboard_set_text(clip, ctx->output->str, -1);
 
 	g_free(data);
 	report_context_free(ctx);
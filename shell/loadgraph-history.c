@@ -0,0 +1,269 @@
+/*
+ * Simple Load Graph - value history
+ * Copyright (C) 2006 L. A. F. Pereira <l@tia.mat.br>
+ *
+ * The Simple Load Graph is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License, version 2.1, as published by the Free Software Foundation.
+ *
+ * The Simple Load Graph is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the Simple Load Graph; if not, write to the Free
+ * Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ * 02111-1307 USA.
+ */
+
+/*
+ * A series keeps the last LG_HISTORY_RECENT samples as they came, and
+ * min/max/avg rollups of older ones: every point of the first level sums
+ * up 10 samples, every point of the second one 60. At one sample per
+ * second, that's 10 minutes at full resolution, then one hour, then six.
+ *
+ * What is asked for is brought down to the number of points the graph has
+ * room for with Largest-Triangle-Three-Buckets, which keeps the peaks that
+ * plain decimation would drop. Each point also carries the min/max of
+ * everything it stands for, so a spike averaged away by a rollup or left
+ * out by LTTB still shows up in the range drawn around the line.
+ *
+ * Series are only fed while the shell updates a field's page; nothing
+ * samples fields in the background, so there are gaps in the history of
+ * pages that weren't being looked at.
+ */
+
+#include "loadgraph.h"
+#include "g-ring.h"
+
+#define LG_HISTORY_RECENT 600
+#define LG_HISTORY_POINTS 360
+#define LG_HISTORY_LEVELS 2
+
+/* samples per point of each level; each one a multiple of the previous */
+static const guint level_factor[LG_HISTORY_LEVELS] = { 10, 60 };
+
+typedef struct {
+    gdouble min, max, avg;
+} LoadGraphRollup;
+
+typedef struct {
+    GRing *ring;                /* LoadGraphRollup */
+    guint n;                    /* points in ring */
+
+    /* the point being summed up */
+    LoadGraphRollup acc;
+    guint count;
+} LoadGraphLevel;
+
+struct _LoadGraphSeries {
+    gint interval;              /* ms between samples */
+    guint64 n_samples;
+
+    GRing *recent;              /* gdouble */
+    guint n_recent;
+
+    LoadGraphLevel levels[LG_HISTORY_LEVELS];
+};
+
+LoadGraphSeries *load_graph_series_new(gint interval)
+{
+    LoadGraphSeries *series = g_new0(LoadGraphSeries, 1);
+    gint i;
+
+    series->interval = interval;
+    series->recent = g_ring_sized_new(sizeof(gdouble), LG_HISTORY_RECENT, NULL);
+    for (i = 0; i < LG_HISTORY_LEVELS; i++)
+        series->levels[i].ring =
+            g_ring_sized_new(sizeof(LoadGraphRollup), LG_HISTORY_POINTS, NULL);
+
+    return series;
+}
+
+void load_graph_series_free(LoadGraphSeries *series)
+{
+    gint i;
+
+    if (!series)
+        return;
+
+    g_ring_unref(series->recent);
+    for (i = 0; i < LG_HISTORY_LEVELS; i++)
+        g_ring_unref(series->levels[i].ring);
+    g_free(series);
+}
+
+static void level_add(LoadGraphSeries *series, gint l, const LoadGraphRollup *r)
+{
+    LoadGraphLevel *level = &series->levels[l];
+    guint inputs = l ? level_factor[l] / level_factor[l - 1] : level_factor[0];
+
+    if (level->count++) {
+        level->acc.min = MIN(level->acc.min, r->min);
+        level->acc.max = MAX(level->acc.max, r->max);
+        level->acc.avg += r->avg;
+    } else {
+        level->acc = *r;
+    }
+
+    if (level->count < inputs)
+        return;
+
+    level->acc.avg /= level->count;
+    level->count = 0;
+
+    g_ring_append_val(level->ring, level->acc);
+    if (level->n < LG_HISTORY_POINTS)
+        level->n++;
+
+    if (l + 1 < LG_HISTORY_LEVELS)
+        level_add(series, l + 1, &level->acc);
+}
+
+void load_graph_series_add(LoadGraphSeries *series, gdouble value)
+{
+    LoadGraphRollup r;
+
+    if (isnan(value))
+        return;
+
+    g_ring_append_val(series->recent, value);
+    if (series->n_recent < LG_HISTORY_RECENT)
+        series->n_recent++;
+    series->n_samples++;
+
+    r.min = r.max = r.avg = value;
+    level_add(series, 0, &r);
+}
+
+gboolean load_graph_series_last(LoadGraphSeries *series, gdouble *value)
+{
+    if (!series || !series->n_recent)
+        return FALSE;
+
+    *value = g_ring_get_index(series->recent, gdouble, 0);
+    return TRUE;
+}
+
+gint load_graph_series_get_interval(LoadGraphSeries *series)
+{
+    return series ? series->interval : 0;
+}
+
+/* samples the oldest point there is goes back */
+guint load_graph_series_span_max(LoadGraphSeries *series)
+{
+    guint64 covered = (guint64)level_factor[LG_HISTORY_LEVELS - 1] *
+                      LG_HISTORY_POINTS;
+
+    if (!series)
+        return 0;
+    return (guint)MIN(series->n_samples, covered);
+}
+
+/* Largest-Triangle-Three-Buckets: the first and last points are kept, and
+ * from each bucket in between, the point making the largest triangle with
+ * the one kept before and the average of the next bucket; its range is
+ * widened to the whole bucket's. */
+static guint lttb(const LoadGraphPoint *in, guint n,
+                  LoadGraphPoint *out, guint threshold)
+{
+    gdouble every = (gdouble)(n - 2) / (threshold - 2);
+    guint a = 0, o = 0, i, j;
+
+    out[o++] = in[0];
+
+    for (i = 0; i < threshold - 2; i++) {
+        guint start = (guint)(i * every) + 1;
+        guint end = (guint)((i + 1) * every) + 1;
+        guint avg_start = end;
+        guint avg_end = MIN((guint)((i + 2) * every) + 1, n);
+        gdouble avg_x = 0.0, avg_y = 0.0, max_area = -1.0;
+        guint next = start;
+        gdouble lo = in[start].lo, hi = in[start].hi;
+
+        if (avg_end <= avg_start)
+            avg_end = MIN(avg_start + 1, n);
+        for (j = avg_start; j < avg_end; j++) {
+            avg_x += in[j].x;
+            avg_y += in[j].y;
+        }
+        avg_x /= avg_end - avg_start;
+        avg_y /= avg_end - avg_start;
+
+        for (j = start; j < end && j < n - 1; j++) {
+            gdouble area = fabs((in[a].x - avg_x) * (in[j].y - in[a].y) -
+                                (in[a].x - in[j].x) * (avg_y - in[a].y));
+
+            if (area > max_area) {
+                max_area = area;
+                next = j;
+            }
+            lo = MIN(lo, in[j].lo);
+            hi = MAX(hi, in[j].hi);
+        }
+
+        out[o] = in[next];
+        out[o].lo = lo;
+        out[o++].hi = hi;
+        a = next;
+    }
+
+    out[o++] = in[n - 1];
+
+    return o;
+}
+
+/* Fills points with at most max_points points covering the last span
+ * samples, oldest first, from the finest level going back that far.
+ * Returns how many were filled. */
+guint load_graph_series_get(LoadGraphSeries *series, guint span,
+                            LoadGraphPoint *points, guint max_points)
+{
+    LoadGraphPoint *all;
+    guint factor = 1, avail, i;
+    gint l = -1;
+
+    if (!series || !span || max_points < 3)
+        return 0;
+
+    if (span > LG_HISTORY_RECENT) {
+        for (l = 0; l < LG_HISTORY_LEVELS - 1; l++) {
+            if (level_factor[l] * LG_HISTORY_POINTS >= span)
+                break;
+        }
+        factor = level_factor[l];
+    }
+
+    avail = (span + factor - 1) / factor;
+    avail = MIN(avail, l < 0 ? series->n_recent : series->levels[l].n);
+    if (!avail)
+        return 0;
+
+    all = avail > max_points ? g_new(LoadGraphPoint, avail) : points;
+    for (i = 0; i < avail; i++) {
+        guint age = avail - 1 - i;
+
+        all[i].x = (gdouble)span - 1 - (gdouble)age * factor;
+        if (l < 0) {
+            all[i].y = g_ring_get_index(series->recent, gdouble, age);
+            all[i].lo = all[i].hi = all[i].y;
+        } else {
+            LoadGraphRollup *r = &g_ring_get_index(series->levels[l].ring,
+                                                   LoadGraphRollup, age);
+
+            all[i].y = r->avg;
+            all[i].lo = r->min;
+            all[i].hi = r->max;
+        }
+    }
+
+    if (all == points)
+        return avail;
+
+    avail = lttb(all, avail, points, max_points);
+    g_free(all);
+
+    return avail;
+}
@@ -24,6 +24,7 @@ static const gchar *default_colors[] = { "#73d216",
 struct _LoadGraph {
     GtkWidget *uber_widget;
     gdouble cur_value[LG_MAX_LINES];
+    LoadGraphSeries *series[LG_MAX_LINES];
     gint height;
 };
 
@@ -33,6 +34,11 @@ _sample_func (UberLineGraph *graph,
                  gpointer   user_data)
 {
     LoadGraph *lg = (LoadGraph *)user_data;
+    gdouble value;
+
+    /* uber-graph keeps its own history; only the latest sample is needed */
+    if (load_graph_series_last(lg->series[line-1], &value))
+        return value;
     return lg->cur_value[line-1];
 }
 
@@ -85,6 +91,7 @@ void load_graph_clear(LoadGraph * lg)
     if (lg != NULL) {
         for (i = 0; i < LG_MAX_LINES; i++) {
             lg->cur_value[i] = UBER_LINE_GRAPH_NO_VALUE;
+            lg->series[i] = NULL;
         }
         uber_graph_scale_changed(UBER_GRAPH(lg->uber_widget));
     }
@@ -119,6 +126,17 @@ void load_graph_update_ex(LoadGraph *lg, guint line, gdouble value)
         lg->cur_value[line] = value;
 }
 
+void load_graph_set_series(LoadGraph *lg, guint line, LoadGraphSeries *series)
+{
+    if (lg != NULL && line < LG_MAX_LINES)
+        lg->series[line] = series;
+}
+
+void load_graph_redraw(LoadGraph *lg)
+{
+    /* sampled by uber-graph on its own */
+}
+
 void load_graph_update(LoadGraph * lg, gdouble value)
 {
     load_graph_update_ex(lg, 0, value);
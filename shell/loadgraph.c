@@ -25,21 +25,31 @@
 
 #include "loadgraph.h"
 
+#define LG_MAX_LINES 3
+#define LG_POINT_WIDTH 2    /* pixels */
+
+/* the first line follows load_graph_set_color() */
+static const LoadGraphColor line_colors[LG_MAX_LINES] = {
+    LG_COLOR_GREEN, LG_COLOR_BLUE, LG_COLOR_RED
+};
+
 struct _LoadGraph {
     GdkPixmap     *buf;
     GdkGC         *grid;
-    GdkGC         *trace;
+    GdkGC         *trace[LG_MAX_LINES];
     GdkGC         *fill;
     GtkWidget     *area;
 
-    gint          *data;
+    LoadGraphSeries *series[LG_MAX_LINES];
+    gboolean   own_series[LG_MAX_LINES];
+    guint      span;    /* samples shown */
     gfloat         scale;
 
     gint       size;
     gint       width, height;
     LoadGraphColor color;
 
-    gint       max_value, remax_count;
+    gdouble    max_value;
 
     PangoLayout   *layout;
     gchar     *suffix;
@@ -60,7 +70,7 @@ LoadGraph *load_graph_new(gint size)
     lg->title = g_strdup("");
     lg->area = gtk_drawing_area_new();
     lg->size = (size * 3) / 2;
-    lg->data = g_new0(gint, lg->size);
+    lg->span = lg->size;
 
     lg->scale = 1.0;
 
@@ -68,11 +78,11 @@ LoadGraph *load_graph_new(gint size)
     lg->height = size * 2;
 
     lg->max_value = 1;
-    lg->remax_count = 0;
 
     lg->layout = pango_layout_new(gtk_widget_get_pango_context(lg->area));
 
     gtk_widget_set_size_request(lg->area, lg->width, lg->height);
+    gtk_widget_add_events(lg->area, GDK_SCROLL_MASK);
     gtk_widget_show(lg->area);
 
     return lg;
@@ -118,16 +128,27 @@ GtkWidget *load_graph_get_framed(LoadGraph * lg)
     return align;
 }
 
+void load_graph_set_series(LoadGraph *lg, guint line, LoadGraphSeries *series)
+{
+    if (line >= LG_MAX_LINES)
+        return;
+
+    if (lg->own_series[line])
+        load_graph_series_free(lg->series[line]);
+    lg->series[line] = series;
+    lg->own_series[line] = FALSE;
+}
+
 void load_graph_clear(LoadGraph * lg)
 {
     gint i;
 
-    for (i = 0; i < lg->size; i++)
-        lg->data[i] = 0;
+    for (i = 0; i < LG_MAX_LINES; i++)
+        load_graph_set_series(lg, i, NULL);
 
+    lg->span = lg->size;
     lg->scale = 1.0;
     lg->max_value = 1;
-    lg->remax_count = 0;
 
     load_graph_set_title(lg, "");
 
@@ -137,17 +158,21 @@ void load_graph_clear(LoadGraph * lg)
 void load_graph_set_color(LoadGraph * lg, LoadGraphColor color)
 {
     lg->color = color;
-    gdk_rgb_gc_set_foreground(lg->trace, lg->color);
+    gdk_rgb_gc_set_foreground(lg->trace[0], lg->color);
     gdk_rgb_gc_set_foreground(lg->fill, lg->color - 0x303030);
     gdk_rgb_gc_set_foreground(lg->grid, lg->color - 0xcdcdcd);
 }
 
 void load_graph_destroy(LoadGraph * lg)
 {
-    g_free(lg->data);
+    gint i;
+
+    for (i = 0; i < LG_MAX_LINES; i++) {
+        load_graph_set_series(lg, i, NULL);
+        g_object_unref(lg->trace[i]);
+    }
     gtk_widget_destroy(lg->area);
     gdk_pixmap_unref(lg->buf);
-    g_object_unref(lg->trace);
     g_object_unref(lg->grid);
     g_object_unref(lg->fill);
     g_object_unref(lg->layout);
@@ -166,16 +191,45 @@ static gboolean _expose(GtkWidget * widget, GdkEventExpose * event,
     return FALSE;
 }
 
+/* the wheel goes back in time (down) and forth (up), within the history of
+ * the first line */
+static gboolean _scroll(GtkWidget * widget, GdkEventScroll * event,
+            gpointer user_data)
+{
+    LoadGraph *lg = (LoadGraph *) user_data;
+    guint span_max;
+
+    span_max = MAX(load_graph_series_span_max(lg->series[0]), (guint)lg->size);
+
+    if (event->direction == GDK_SCROLL_DOWN)
+        lg->span = MIN(lg->span * 4, span_max);
+    else if (event->direction == GDK_SCROLL_UP)
+        lg->span = MAX(lg->span / 4, (guint)lg->size);
+    else
+        return FALSE;
+
+    _draw(lg);
+    return TRUE;
+}
+
 void load_graph_configure_expose(LoadGraph * lg)
 {
+    gint i;
+
     /* creates the backing store pixmap */
     gtk_widget_realize(lg->area);
     lg->buf = gdk_pixmap_new(lg->area->window, lg->width, lg->height, -1);
 
     /* create the graphic contexts */
     lg->grid = gdk_gc_new(GDK_DRAWABLE(lg->buf));
-    lg->trace = gdk_gc_new(GDK_DRAWABLE(lg->buf));
     lg->fill = gdk_gc_new(GDK_DRAWABLE(lg->buf));
+    for (i = 0; i < LG_MAX_LINES; i++) {
+        lg->trace[i] = gdk_gc_new(GDK_DRAWABLE(lg->buf));
+        gdk_rgb_gc_set_foreground(lg->trace[i], line_colors[i]);
+        gdk_gc_set_line_attributes(lg->trace[i],
+                       1, GDK_LINE_SOLID,
+                       GDK_CAP_PROJECTING, GDK_JOIN_ROUND);
+    }
 
     /* the default color is green */
     load_graph_set_color(lg, LG_COLOR_GREEN);
@@ -186,13 +240,11 @@ void load_graph_configure_expose(LoadGraph * lg)
                    GDK_CAP_NOT_LAST, GDK_JOIN_ROUND);
     gdk_gc_set_dashes(lg->grid, 0, (gint8*)"\2\2", 2);
 
-    gdk_gc_set_line_attributes(lg->trace,
-                   1, GDK_LINE_SOLID,
-                   GDK_CAP_PROJECTING, GDK_JOIN_ROUND);
-
     /* configures the expose event */
     g_signal_connect(G_OBJECT(lg->area), "expose-event",
              (GCallback) _expose, lg);
+    g_signal_connect(G_OBJECT(lg->area), "scroll-event",
+             (GCallback) _scroll, lg);
 }
 
 static void _draw_title(LoadGraph * lg, const char* title) {
@@ -202,12 +254,12 @@ static void _draw_title(LoadGraph * lg, const char* title) {
     int height = 0;
     pango_layout_get_pixel_size(lg->layout, &width, &height);
     gint position = (lg->width / 2) - (width / 2);
-    gdk_draw_layout(GDK_DRAWABLE(lg->buf), lg->trace, position, 2,
+    gdk_draw_layout(GDK_DRAWABLE(lg->buf), lg->trace[0], position, 2,
                     lg->layout);
     g_free(tmp);
 }
 
-static void _draw_label_and_line(LoadGraph * lg, gint position, gint value)
+static void _draw_label_and_line(LoadGraph * lg, gint position, gdouble value)
 {
     gchar *tmp;
 
@@ -220,44 +272,103 @@ static void _draw_label_and_line(LoadGraph * lg, gint position, gint value)
 
     /* draw label */
     tmp =
-    g_strdup_printf("<span size=\"x-small\">%d%s</span>", value,
-            lg->suffix);
+    g_strdup_printf("<span size=\"x-small\">%.*f%s</span>",
+            lg->max_value < 10 ? 1 : 0, value, lg->suffix);
 
     pango_layout_set_markup(lg->layout, tmp, -1);
     pango_layout_set_width(lg->layout,
                lg->area->allocation.width * PANGO_SCALE);
-    gdk_draw_layout(GDK_DRAWABLE(lg->buf), lg->trace, 2, position,
+    gdk_draw_layout(GDK_DRAWABLE(lg->buf), lg->trace[0], 2, position,
             lg->layout);
 
     g_free(tmp);
 }
 
+/* e.g. "1h", for the title of a graph going back further than usual */
+static gchar *_span_str(LoadGraph * lg)
+{
+    gint interval = load_graph_series_get_interval(lg->series[0]);
+    guint secs;
+
+    if (lg->span <= (guint)lg->size || interval <= 0)
+        return NULL;
+
+    secs = (guint)((guint64)lg->span * interval / 1000);
+    if (secs >= 3600)
+        return g_strdup_printf("%.1fh", secs / 3600.0);
+    if (secs >= 60)
+        return g_strdup_printf("%umin", secs / 60);
+    return g_strdup_printf("%us", secs);
+}
+
 static void _draw(LoadGraph * lg)
 {
     GdkDrawable *draw = GDK_DRAWABLE(lg->buf);
+    LoadGraphPoint *points[LG_MAX_LINES];
+    guint n_points[LG_MAX_LINES];
+    guint max_points = lg->width / LG_POINT_WIDTH;
+    gdouble max = 0.0;
+    gchar *span;
     gint i, d;
+    guint j;
 
     /* clears the drawing area */
     gdk_draw_rectangle(draw, lg->area->style->black_gc,
                TRUE, 0, 0, lg->width, lg->height);
 
-
-    /* the graph */
-    GdkPoint *points = g_new0(GdkPoint, lg->size + 1);
-
-    for (i = 0; i < lg->size; i++) {
-        points[i].x = i * 4;
-        points[i].y = lg->height - lg->data[i] * lg->scale;
+    /* what there's room for of each line, and the scale fitting them all */
+    for (i = 0; i < LG_MAX_LINES; i++) {
+        points[i] = g_new(LoadGraphPoint, max_points);
+        n_points[i] = load_graph_series_get(lg->series[i], lg->span,
+                                            points[i], max_points);
+        for (j = 0; j < n_points[i]; j++)
+            max = MAX(max, points[i][j].hi);
     }
+    lg->max_value = max > 0.0 ? max : 1;
+
+    /* always use 90% of it */
+    lg->scale = 0.90 * ((gfloat) lg->height / lg->max_value);
+
+    /* the graphs; the first one is filled, the others drawn on top; where
+     * a point stands for several samples, their min..max is a bar */
+    for (i = 0; i < LG_MAX_LINES; i++) {
+        GdkPoint *gp;
+        GdkSegment *range;
+        guint n = n_points[i], n_range = 0;
+
+        if (n < 2)
+            continue;
+
+        gp = g_new(GdkPoint, n + 2);
+        range = g_new(GdkSegment, n);
+        for (j = 0; j < n; j++) {
+            gp[j + 1].x = points[i][j].x * lg->width / (lg->span - 1);
+            gp[j + 1].y = lg->height - points[i][j].y * lg->scale;
+
+            if (points[i][j].hi > points[i][j].lo) {
+                range[n_range].x1 = range[n_range].x2 = gp[j + 1].x;
+                range[n_range].y1 = lg->height - points[i][j].lo * lg->scale;
+                range[n_range].y2 = lg->height - points[i][j].hi * lg->scale;
+                n_range++;
+            }
+        }
 
-    points[0].x = points[1].x = 0;
-    points[0].y = points[i].y = lg->height;
-    points[i].x = points[i - 1].x = lg->width;
+        if (i == 0) {
+            gp[0].x = gp[1].x;
+            gp[0].y = gp[n + 1].y = lg->height;
+            gp[n + 1].x = gp[n].x;
+            gdk_draw_polygon(draw, lg->fill, TRUE, gp, n + 2);
+        }
+        if (n_range)
+            gdk_draw_segments(draw, lg->trace[i], range, n_range);
+        gdk_draw_lines(draw, lg->trace[i], gp + 1, n);
 
-    gdk_draw_polygon(draw, lg->fill, TRUE, points, lg->size + 1);
-    gdk_draw_polygon(draw, lg->trace, FALSE, points, lg->size + 1);
+        g_free(range);
+        g_free(gp);
+    }
 
-    g_free(points);
+    for (i = 0; i < LG_MAX_LINES; i++)
+        g_free(points[i]);
 
     /* vertical bars */
     for (i = lg->width, d = 0; i > 1; i--, d++)
@@ -271,56 +382,44 @@ static void _draw(LoadGraph * lg)
     _draw_label_and_line(lg, 3 * (lg->height / 4), lg->max_value / 4);
 
     /* graph title */
-    _draw_title(lg, lg->title);
+    span = _span_str(lg);
+    if (span) {
+        gchar *title = g_strdup_printf("%s (%s)", lg->title, span);
+
+        _draw_title(lg, title);
+        g_free(title);
+        g_free(span);
+    } else {
+        _draw_title(lg, lg->title);
+    }
 
     gtk_widget_queue_draw(lg->area);
 }
 
-void load_graph_update_ex(LoadGraph *lg, guint line, gdouble value)
+void load_graph_redraw(LoadGraph * lg)
 {
-    /* not implemented */
-    if (line == 0)
-        load_graph_update(lg, value);
+    _draw(lg);
 }
 
-void load_graph_update(LoadGraph * lg, gdouble v)
+/* lines fed this way keep their own history */
+void load_graph_update_ex(LoadGraph *lg, guint line, gdouble value)
 {
-    gint i;
-    gint value = (gint)v;
-
-    if (value < 0)
+    if (line >= LG_MAX_LINES)
         return;
 
-    /* shift-right our data */
-    for (i = 0; i < lg->size - 1; i++) {
-        lg->data[i] = lg->data[i + 1];
-    }
-
-    /* insert the updated value */
-    lg->data[i] = value;
-
-    /* calculates the maximum value */
-    if (lg->remax_count++ > 20) {
-        /* only finds the maximum amongst the data every 20 times */
-        lg->remax_count = 0;
-
-        gint max = lg->data[0];
-        for (i = 1; i < lg->size; i++) {
-            if (lg->data[i] > max)
-            max = lg->data[i];
-        }
-
-        lg->max_value = max;
-    } else {
-        /* otherwise, select the maximum between the current maximum
-           and the supplied value */
-        lg->max_value = MAX(value, lg->max_value);
+    if (!lg->series[line]) {
+        lg->series[line] = load_graph_series_new(0);
+        lg->own_series[line] = TRUE;
     }
+    load_graph_series_add(lg->series[line], value);
+}
 
-    /* recalculates the scale; always use 90% of it */
-    lg->scale = 0.90 * ((gfloat) lg->height / (gfloat) lg->max_value);
+void load_graph_update(LoadGraph * lg, gdouble value)
+{
+    if (value < 0)
+        return;
 
-    /* redraw */
+    load_graph_update_ex(lg, 0, value);
     _draw(lg);
 }
 
@@ -22,6 +22,7 @@
 #include <shell.h>
 #include <iconcache.h>
 #include <hardinfo.h>
+#include <snapshot.h>
 #include <config.h>
 
 static ReportDialog *report_dialog_new(GtkTreeModel * model,
@@ -32,9 +33,34 @@ static FileTypes file_types[] = {
     {"HTML (*.html)", "text/html", ".html", report_context_html_new},
     {"Plain Text (*.txt)", "text/plain", ".txt", report_context_text_new},
     {"Shell Dump (*.txt)", "text/plain", ".txt", report_context_shell_new},
+    {"JSON (*.json)", "application/json", ".json", report_context_json_new},
     {NULL, NULL, NULL, NULL}
 };
 
+/* Everything the emitters write goes through these: to the stream, where
+ * stdio buffers it, or appended to the output string, so a report is
+ * written in one pass instead of being copied on every line. */
+static void report_puts(ReportContext *ctx, const gchar *str)
+{
+    if (ctx->stream)
+        fputs(str, ctx->stream);
+    else
+        g_string_append(ctx->output, str);
+}
+
+static void G_GNUC_PRINTF(2, 3)
+report_printf(ReportContext *ctx, const gchar *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    if (ctx->stream)
+        vfprintf(ctx->stream, format, args);
+    else
+        g_string_append_vprintf(ctx->output, format, args);
+    va_end(args);
+}
+
 /* virtual functions */
 void report_header(ReportContext * ctx)
 { ctx->header(ctx); }
@@ -198,20 +224,88 @@ void report_context_configure(ReportContext * ctx, GKeyFile * keyfile)
 
 }
 
+/* same as report_context_configure(), for the struct Info form */
+static void report_context_configure_info(ReportContext *ctx, struct Info *info)
+{
+    /* in the order of info_column_titles */
+    static const gint column_bits[INFO_N_COLUMNS] = {
+        REPORT_COL_TEXTVALUE, REPORT_COL_VALUE, REPORT_COL_PROGRESS,
+        REPORT_COL_EXTRA1, REPORT_COL_EXTRA2,
+    };
+    guint i, j;
+
+    if (ctx->icon_refs)
+        g_hash_table_destroy(ctx->icon_refs);
+    ctx->icon_refs = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+
+    ctx->show_column_headers = info->column_headers_visible;
+
+    for (i = 0; i < INFO_N_COLUMNS; i++) {
+        if (!info->column_titles[i])
+            continue;
+
+        ctx->columns |= column_bits[i];
+        g_hash_table_replace(ctx->column_titles,
+                             g_strdup(info_column_titles[i]),
+                             g_strdup(info->column_titles[i]));
+    }
+
+    if (info->view_type == SHELL_VIEW_PROGRESS) {
+        ctx->columns &= ~REPORT_COL_VALUE;
+        ctx->columns |= REPORT_COL_PROGRESS;
+    }
+
+    for (i = 0; i < info->groups->len; i++) {
+        struct InfoGroup *group = &g_array_index(info->groups, struct InfoGroup, i);
+
+        if (!group->fields)
+            continue;
+
+        for (j = 0; j < group->fields->len; j++) {
+            struct InfoField *field = &g_array_index(group->fields, struct InfoField, j);
+            gchar *key;
+
+            if (!field->icon)
+                continue;
+
+            key = info_field_key(field, i, j);
+            cache_icon(ctx, field->icon);
+            g_hash_table_insert(ctx->icon_refs, key_mi_tag(key),
+                                g_strdup(field->icon));
+            g_free(key);
+        }
+    }
+}
+
 static void report_html_details_start(ReportContext *ctx, gchar *key, gchar *value, gsize longest_key) {
     guint cols = report_get_visible_columns(ctx);
     report_key_value(ctx, key, value, longest_key);
     ctx->parent_columns = ctx->columns;
     ctx->columns = REPORT_COL_VALUE;
-    ctx->output = h_strdup_cprintf("<tr><td colspan=\"%d\"><table class=\"details\">\n", ctx->output, cols);
+    report_printf(ctx, "<tr><td colspan=\"%d\"><table class=\"details\">\n", cols);
 }
 
 static void report_html_details_end(ReportContext *ctx) {
-    ctx->output = h_strdup_cprintf("</table></td></tr>\n", ctx->output);
+    report_puts(ctx, "</table></td></tr>\n");
     ctx->columns = ctx->parent_columns;
     ctx->parent_columns = 0;
 }
 
+/* details and "..." fields come from wherever the entry's data came from */
+static gchar *report_entry_more_info(ReportContext *ctx, gchar *tag)
+{
+    if (ctx->snapshot)
+        return snapshot_get_more_info(ctx->entry, tag);
+    return g_strdup(ctx->entry->morefunc(tag));
+}
+
+static gchar *report_entry_field(ReportContext *ctx, gchar *key)
+{
+    if (ctx->snapshot)
+        return snapshot_get_field(ctx->entry, key);
+    return ctx->entry->fieldfunc(key);
+}
+
 void report_details(ReportContext *ctx, gchar *key, gchar *value, gchar *details, gsize longest_key)
 {
     GKeyFile *key_file = g_key_file_new();
@@ -262,7 +356,7 @@ void report_details(ReportContext *ctx, gchar *key, gchar *value, gchar *details
 
                 if (g_str_equal(value, "...")) {
                     g_free(value);
-                    if (!(value = ctx->entry->fieldfunc(key))) {
+                    if (!(value = report_entry_field(ctx, key))) {
                         value = g_strdup("...");
                     }
                 }
@@ -302,19 +396,20 @@ static void report_table_shell_dump(ReportContext *ctx, gchar *key_file_str, int
                 *eq = 0;
                 key = p; value = eq + 1;
 
-                ctx->output = h_strdup_cprintf("%s%s=%s\n", ctx->output, indent, key, value);
+                report_printf(ctx, "%s%s=%s\n", indent, key, value);
                 if (key_wants_details(key) || params.force_all_details) {
                     gchar *mi_tag = key_mi_tag(key);
-                    gchar *mi_data = ctx->entry->morefunc(mi_tag); /*const*/
+                    gchar *mi_data = report_entry_more_info(ctx, mi_tag);
 
                     if (mi_data)
                         report_table_shell_dump(ctx, mi_data, level + 1);
 
+                    g_free(mi_data);
                     g_free(mi_tag);
                 }
 
             } else
-                ctx->output = h_strdup_cprintf("%s%s\n", ctx->output, indent, p);
+                report_printf(ctx, "%s%s\n", indent, p);
             p = next_nl + 1;
         }
     }
@@ -323,6 +418,41 @@ static void report_table_shell_dump(ReportContext *ctx, gchar *key_file_str, int
     return;
 }
 
+/* one row of report_table() or report_table_info(); key is the shell's
+ * "$flags tag$label" form */
+static void report_table_field(ReportContext *ctx, gchar *key,
+                               const gchar *value, gsize longest_key)
+{
+    gchar *field_value;
+
+    if (!g_utf8_validate(key, -1, NULL) || !g_utf8_validate(value, -1, NULL))
+        return;
+
+    if (!g_str_equal(value, "...") ||
+        !(field_value = report_entry_field(ctx, key)))
+        field_value = g_strdup(value);
+
+    if ( key_is_flagged(key) ) {
+        gchar *mi_tag = key_mi_tag(key);
+        gchar *mi_data = NULL;
+
+        if (key_wants_details(key) || params.force_all_details)
+            mi_data = report_entry_more_info(ctx, mi_tag);
+
+        if (mi_data)
+            report_details(ctx, key, field_value, mi_data, longest_key);
+        else
+            report_key_value(ctx, key, field_value, longest_key);
+
+        g_free(mi_data);
+        g_free(mi_tag);
+    } else {
+        report_key_value(ctx, key, field_value, longest_key);
+    }
+
+    g_free(field_value);
+}
+
 void report_table(ReportContext * ctx, gchar * text)
 {
     GKeyFile *key_file = NULL;
@@ -384,34 +514,8 @@ void report_table(ReportContext * ctx, gchar * text)
             raw_value = g_key_file_get_value(key_file, tmpgroup, key, NULL);
             value = g_strcompress(raw_value); /* un-escape \n, \t, etc */
 
-            if (g_utf8_validate(key, -1, NULL) && g_utf8_validate(value, -1, NULL)) {
-                strend(key, '#');
-
-                if (g_str_equal(value, "...")) {
-                    g_free(value);
-                    if (!(value = ctx->entry->fieldfunc(key))) {
-                        value = g_strdup("...");
-                    }
-                }
-
-                if ( key_is_flagged(key) ) {
-                    gchar *mi_tag = key_mi_tag(key);
-                    gchar *mi_data = NULL; /*const*/
-
-                    if (key_wants_details(key) || params.force_all_details)
-                        mi_data = ctx->entry->morefunc(mi_tag);
-
-                    if (mi_data)
-                        report_details(ctx, key, value, mi_data, longest_key);
-                    else
-                        report_key_value(ctx, key, value, longest_key);
-
-                    g_free(mi_tag);
-                } else {
-                    report_key_value(ctx, key, value, longest_key);
-                }
-
-            }
+            strend(key, '#');
+            report_table_field(ctx, key, value, longest_key);
 
             g_free(value);
             g_free(raw_value);
@@ -426,13 +530,45 @@ void report_table(ReportContext * ctx, gchar * text)
     g_key_file_free(key_file);
 }
 
-static void report_html_header(ReportContext * ctx)
+void report_table_info(ReportContext *ctx, struct Info *info)
 {
-    g_free(ctx->output);
+    guint i, j;
+
+    ctx->columns = REPORT_COL_VALUE;
+    ctx->show_column_headers = FALSE;
+    report_context_configure_info(ctx, info);
+
+    for (i = 0; i < info->groups->len; i++) {
+        struct InfoGroup *group = &g_array_index(info->groups, struct InfoGroup, i);
+        gsize longest_key = 0;
+
+        if (!group->fields)
+            continue;
 
-    ctx->output =
-	g_strdup_printf
-	("<!DOCTYPE HTML PUBLIC \"-//W3C//DTD HTML 4.0 Final//EN\">\n"
+        info_group_sort(group);
+        report_subsubtitle(ctx, (gchar *)(group->name ? group->name : ""));
+
+        for (j = 0; j < group->fields->len; j++) {
+            struct InfoField *field = &g_array_index(group->fields, struct InfoField, j);
+
+            longest_key = MAX(longest_key, strlen(field->name));
+        }
+
+        for (j = 0; j < group->fields->len; j++) {
+            struct InfoField *field = &g_array_index(group->fields, struct InfoField, j);
+            gchar *key = info_field_key(field, i, j);
+
+            report_table_field(ctx, key, field->value ? field->value : "",
+                               longest_key);
+            g_free(key);
+        }
+    }
+}
+
+static void report_html_header(ReportContext * ctx)
+{
+    report_printf
+	(ctx, "<!DOCTYPE HTML PUBLIC \"-//W3C//DTD HTML 4.0 Final//EN\">\n"
 	 "<html><head>\n" "<title>HardInfo (%s) System Report</title>\n"
 	 "<meta http-equiv=\"Content-Type\" content=\"text/html; charset=utf-8\">\n"
 	 "<style>\n" "    body    { background: #fff }\n"
@@ -455,26 +591,26 @@ static void report_html_header(ReportContext * ctx)
 
 static void report_html_footer(ReportContext * ctx)
 {
-    ctx->output = h_strconcat(ctx->output, "</table>", NULL);
-    ctx->output = h_strconcat(ctx->output, "<style>\n", NULL);
+    report_puts(ctx, "</table>");
+    report_puts(ctx, "<style>\n");
     GList *l = NULL, *keys = g_hash_table_get_keys(ctx->icon_data);
     for(l = keys; l; l = l->next) {
         gchar *data = g_hash_table_lookup(ctx->icon_data, (gchar*)l->data);
         if (data)
-            ctx->output = h_strconcat(ctx->output, data, NULL);
+            report_puts(ctx, data);
     }
     g_list_free(keys);
-    ctx->output = h_strconcat(ctx->output, "</style>\n", NULL);
-    ctx->output = h_strconcat(ctx->output, "</html>", NULL);
+    report_puts(ctx, "</style>\n");
+    report_puts(ctx, "</html>");
 }
 
 static void report_html_title(ReportContext * ctx, gchar * text)
 {
     if (!ctx->first_table) {
-      ctx->output = h_strdup_cprintf("</table>", ctx->output);
+      report_puts(ctx, "</table>");
     }
 
-    ctx->output = h_strdup_cprintf("<h1 class=\"title\">%s</h1>", ctx->output, text);
+    report_printf(ctx, "<h1 class=\"title\">%s</h1>", text);
 }
 
 static void report_html_subtitle(ReportContext * ctx, gchar * text)
@@ -482,7 +618,7 @@ static void report_html_subtitle(ReportContext * ctx, gchar * text)
     gint columns = report_get_visible_columns(ctx);
 
     if (!ctx->first_table) {
-      ctx->output = h_strdup_cprintf("</table>", ctx->output);
+      report_puts(ctx, "</table>");
     } else {
       ctx->first_table = FALSE;
     }
@@ -496,9 +632,8 @@ static void report_html_subtitle(ReportContext * ctx, gchar * text)
         icon = g_strdup("");
     }
 
-    ctx->output = h_strdup_cprintf("<table><tr><td class=\"icon_subtitle\">%s</td><td colspan=\"%d\" class=\"stit"
+    report_printf(ctx, "<table><tr><td class=\"icon_subtitle\">%s</td><td colspan=\"%d\" class=\"stit"
 				  "le\">%s</td></tr>\n",
-				  ctx->output,
                   icon,
 				  columns,
 				  text);
@@ -509,9 +644,8 @@ static void report_html_subsubtitle(ReportContext * ctx, gchar * text)
 {
     gint columns = report_get_visible_columns(ctx);
 
-    ctx->output = h_strdup_cprintf("<tr><td colspan=\"%d\" class=\"ssti"
+    report_printf(ctx, "<tr><td colspan=\"%d\" class=\"ssti"
 				  "tle\">%s</td></tr>\n",
-				  ctx->output,
 				  columns+1,
 				  text);
 }
@@ -538,24 +672,21 @@ report_html_key_value(ReportContext * ctx, gchar *key, gchar *value, gsize longe
     gchar *name = (gchar*)key_get_name(key);
 
     if (columns == 2) {
-      ctx->output = h_strdup_cprintf("<tr%s><td class=\"icon\">%s</td><td class=\"field\">%s</td>"
+      report_printf(ctx, "<tr%s><td class=\"icon\">%s</td><td class=\"field\">%s</td>"
                                     "<td class=\"value\">%s</td></tr>\n",
-                                    ctx->output,
                                     highlight ? " class=\"hilight\"" : "",
                                     icon, name, value);
     } else {
       values = g_strsplit(value, "|", columns);
       mc = g_strv_length(values) - 1;
 
-      ctx->output = h_strdup_cprintf("\n<tr%s>\n<td class=\"icon\">%s</td><td class=\"field\">%s</td>", ctx->output, highlight ? " class=\"hilight\"" : "", icon, name);
+      report_printf(ctx, "\n<tr%s>\n<td class=\"icon\">%s</td><td class=\"field\">%s</td>", highlight ? " class=\"hilight\"" : "", icon, name);
 
       for (i = mc; i >= 0; i--) {
-        ctx->output = h_strdup_cprintf("<td class=\"value\">%s</td>",
-                                       ctx->output,
-                                       values[i]);
+        report_printf(ctx, "<td class=\"value\">%s</td>", values[i]);
       }
 
-      ctx->output = h_strdup_cprintf("</tr>\n", ctx->output);
+      report_puts(ctx, "</tr>\n");
 
       g_strfreev(values);
     }
@@ -564,39 +695,29 @@ report_html_key_value(ReportContext * ctx, gchar *key, gchar *value, gsize longe
 
 static void report_text_header(ReportContext * ctx)
 {
-    g_free(ctx->output);
-
-    ctx->output = g_strdup("");
 }
 
 static void report_text_footer(ReportContext * ctx)
 {
 }
 
-static void report_text_title(ReportContext * ctx, gchar * text)
+static void report_text_underlined(ReportContext * ctx, gchar * text,
+                                   gchar underline)
 {
-    gchar *str = (gchar *) ctx->output;
-    int i = strlen(text);
+    gchar *line = g_strnfill(strlen(text), underline);
 
-    str = h_strdup_cprintf("\n%s\n", str, text);
-    for (; i; i--)
-	str = h_strconcat(str, "*", NULL);
+    report_printf(ctx, "\n%s\n%s\n\n", text, line);
+    g_free(line);
+}
 
-    str = h_strconcat(str, "\n\n", NULL);
-    ctx->output = str;
+static void report_text_title(ReportContext * ctx, gchar * text)
+{
+    report_text_underlined(ctx, text, '*');
 }
 
 static void report_text_subtitle(ReportContext * ctx, gchar * text)
 {
-    gchar *str = ctx->output;
-    int i = strlen(text);
-
-    str = h_strdup_cprintf("\n%s\n", str, text);
-    for (; i; i--)
-	str = h_strconcat(str, "-", NULL);
-
-    str = h_strconcat(str, "\n\n", NULL);
-    ctx->output = str;
+    report_text_underlined(ctx, text, '-');
 }
 
 static void report_text_subsubtitle(ReportContext * ctx, gchar * text)
@@ -604,7 +725,7 @@ static void report_text_subsubtitle(ReportContext * ctx, gchar * text)
     gchar indent[10] = "   ";
     if (!ctx->in_details)
         indent[0] = 0;
-    ctx->output = h_strdup_cprintf("%s-%s-\n", ctx->output, indent, text);
+    report_printf(ctx, "%s-%s-\n", indent, text);
 }
 
 static void
@@ -637,35 +758,287 @@ report_text_key_value(ReportContext * ctx, gchar *key, gchar *value, gsize longe
               gchar **lines = g_strsplit(value, "\n", 0);
               for(i=0; lines[i]; i++) {
                   if (i == 0)
-                      ctx->output = h_strdup_cprintf("%s%s : %s\n", ctx->output, pf, rjname, lines[i]);
+                      report_printf(ctx, "%s%s : %s\n", pf, rjname, lines[i]);
                   else
-                      ctx->output = h_strdup_cprintf("%s%s   %s\n", ctx->output, pf, field_spacer, lines[i]);
+                      report_printf(ctx, "%s%s   %s\n", pf, field_spacer, lines[i]);
               }
               g_strfreev(lines);
           } else {
-              ctx->output = h_strdup_cprintf("%s%s : %s\n", ctx->output, pf, rjname, value);
+              report_printf(ctx, "%s%s : %s\n", pf, rjname, value);
           }
       } else
-          ctx->output = h_strdup_cprintf("%s%s\n", ctx->output, pf, rjname);
+          report_printf(ctx, "%s%s\n", pf, rjname);
     } else {
       values = g_strsplit(value, "|", columns);
       mc = g_strv_length(values) - 1;
 
-      ctx->output = h_strdup_cprintf("%s%s", ctx->output, pf, rjname);
+      report_printf(ctx, "%s%s", pf, rjname);
 
       for (i = mc; i >= 0; i--) {
-        ctx->output = h_strdup_cprintf("\t%s",
-                                       ctx->output,
-                                       values[i]);
+        report_printf(ctx, "\t%s", values[i]);
       }
 
-      ctx->output = h_strdup_cprintf("\n", ctx->output);
+      report_puts(ctx, "\n");
 
       g_strfreev(values);
     }
     g_free(pf);
 }
 
+/*
+ * JSON: {"version": ..., "locale": ..., "modules": [{"name": ..., "id": ...,
+ * "entries": [{"name": ..., "id": ..., "groups": [{"name": ...,
+ * "fields": [field, ...]}, ...]}, ...]}, ...]}, the ids being the same in
+ * any language ("devices", "pci-devices"),
+ * a field being {"name", "tag", "value", "number", "unit", "columns",
+ * "highlight", "details"} with only what applies: "number" (and "unit")
+ * when the value is one, "columns" for tables with more than one value
+ * column, "details" (a list of groups) with the details of the tag.
+ */
+#define REPORT_JSON_TABLE_DEPTH 3   /* after report_subtitle(): groups */
+
+/* values come from DMI, EDID, etc. as they are, so bytes that aren't
+ * UTF-8 are replaced with U+FFFD to keep the output valid JSON */
+static void report_json_string(ReportContext *ctx, const gchar *str)
+{
+    GString *json = g_string_sized_new(strlen(str) + 2);
+    const gchar *p;
+
+    g_string_append_c(json, '"');
+    for (p = str; *p; p++) {
+        if ((guchar)*p >= 0x80) {
+            if ((gint)g_utf8_get_char_validated(p, -1) < 0) {
+                g_string_append(json, "\\ufffd");
+            } else {
+                const gchar *next = g_utf8_next_char(p);
+                g_string_append_len(json, p, next - p);
+                p = next - 1;
+            }
+            continue;
+        }
+
+        switch (*p) {
+        case '"':
+            g_string_append(json, "\\\"");
+            break;
+        case '\\':
+            g_string_append(json, "\\\\");
+            break;
+        case '\n':
+            g_string_append(json, "\\n");
+            break;
+        case '\t':
+            g_string_append(json, "\\t");
+            break;
+        default:
+            if ((guchar)*p < 0x20)
+                g_string_append_printf(json, "\\u%04x", (guchar)*p);
+            else
+                g_string_append_c(json, *p);
+        }
+    }
+    g_string_append_c(json, '"');
+
+    report_puts(ctx, json->str);
+    g_string_free(json, TRUE);
+}
+
+/* "3.20 GHz" is 3.2 "GHz", "45%" is 45 "%"; versions, addresses and ids
+ * aren't numbers */
+static gboolean report_json_number(const gchar *value, gdouble *number,
+                                   const gchar **unit)
+{
+    const gchar *p = value;
+    gsize digits;
+
+    if (*p == '-' || *p == '+')
+        p++;
+    digits = strspn(p, "0123456789");
+    if (!digits)
+        return FALSE;
+    p += digits;
+    if (*p == '.' && g_ascii_isdigit(p[1]))
+        p += 1 + strspn(p + 1, "0123456789");
+
+    if (*p == '%' && !p[1]) {
+        *unit = p;
+    } else if (*p == ' ' && p[1] && !strchr(p + 1, ' ') &&
+               (g_ascii_isalpha(p[1]) || (guchar)p[1] >= 0x80 || p[1] == '%')) {
+        *unit = p + 1;
+    } else if (!*p) {
+        *unit = NULL;
+    } else {
+        return FALSE;
+    }
+
+    *number = g_ascii_strtod(value, NULL);
+    return TRUE;
+}
+
+static void report_json_close_to(ReportContext *ctx, gint depth)
+{
+    for (; ctx->json_depth > depth; ctx->json_depth--)
+        report_puts(ctx, "]}");
+}
+
+/* a new element in the innermost array */
+static void report_json_item(ReportContext *ctx)
+{
+    if (!ctx->json_first[ctx->json_depth])
+        report_puts(ctx, ",");
+    ctx->json_first[ctx->json_depth] = FALSE;
+}
+
+/* {"name": name, "id": id, "<list>": [ */
+static void report_json_open(ReportContext *ctx, gint depth, const gchar *name,
+                             const gchar *id, const gchar *list)
+{
+    report_json_close_to(ctx, depth);
+    report_json_item(ctx);
+    report_puts(ctx, "\n{\"name\":");
+    report_json_string(ctx, name);
+    if (id) {
+        report_puts(ctx, ",\"id\":");
+        report_json_string(ctx, id);
+    }
+    report_printf(ctx, ",\"%s\":[", list);
+
+    ctx->json_depth++;
+    g_assert(ctx->json_depth < G_N_ELEMENTS(ctx->json_first));
+    ctx->json_first[ctx->json_depth] = TRUE;
+}
+
+static gint report_json_table_depth(ReportContext *ctx)
+{
+    return ctx->in_details ? ctx->json_details : REPORT_JSON_TABLE_DEPTH;
+}
+
+static void report_json_header(ReportContext *ctx)
+{
+    const gchar *locale;
+
+    report_puts(ctx, "{\"version\":");
+    report_json_string(ctx, VERSION);
+    /* names are translated, see report_diff() */
+    report_puts(ctx, ",\"locale\":");
+    locale = setlocale(LC_MESSAGES, NULL);
+    report_json_string(ctx, locale ? locale : "C");
+    report_puts(ctx, ",\"modules\":[");
+
+    ctx->json_depth = 1;
+    ctx->json_first[1] = TRUE;
+}
+
+static void report_json_footer(ReportContext *ctx)
+{
+    report_json_close_to(ctx, 0);
+    report_puts(ctx, "\n");
+}
+
+static void report_json_title(ReportContext *ctx, gchar *text)
+{
+    report_json_open(ctx, 1, text, ctx->module ? ctx->module->id : NULL,
+                     "entries");
+}
+
+static void report_json_subtitle(ReportContext *ctx, gchar *text)
+{
+    report_json_open(ctx, 2, text, ctx->entry ? ctx->entry->id : NULL,
+                     "groups");
+}
+
+static void report_json_subsubtitle(ReportContext *ctx, gchar *text)
+{
+    report_json_open(ctx, report_json_table_depth(ctx), text, NULL, "fields");
+}
+
+/* ,"number":...,"unit":... if value is a number */
+static void report_json_typed_value(ReportContext *ctx, const gchar *value)
+{
+    gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+    const gchar *unit;
+    gdouble number;
+
+    if (!report_json_number(value, &number, &unit))
+        return;
+
+    report_printf(ctx, ",\"number\":%s",
+                  g_ascii_formatd(buf, sizeof(buf), "%.15g", number));
+    if (unit) {
+        report_puts(ctx, ",\"unit\":");
+        report_json_string(ctx, unit);
+    }
+}
+
+/* the field's object, still open */
+static void report_json_field(ReportContext *ctx, gchar *key, gchar *value)
+{
+    gint columns = report_get_visible_columns(ctx);
+    gchar *tag, *label;
+
+    if (ctx->json_depth == report_json_table_depth(ctx))
+        report_json_open(ctx, ctx->json_depth, "", NULL, "fields");
+
+    if (!value)
+        value = "";
+    key_get_components(key, NULL, &tag, NULL, &label, NULL, TRUE);
+
+    report_json_item(ctx);
+    report_puts(ctx, "\n{\"name\":");
+    report_json_string(ctx, label ? label : "");
+    if (tag) {
+        report_puts(ctx, ",\"tag\":");
+        report_json_string(ctx, tag);
+    }
+    report_puts(ctx, ",\"value\":");
+    report_json_string(ctx, value);
+
+    if (columns > 2 && !ctx->in_details) {
+        gchar **values = g_strsplit(value, "|", columns);
+        gint i;
+
+        report_puts(ctx, ",\"columns\":[");
+        for (i = g_strv_length(values) - 1; i >= 0; i--) {
+            report_json_string(ctx, values[i]);
+            if (i)
+                report_puts(ctx, ",");
+        }
+        report_puts(ctx, "]");
+        g_strfreev(values);
+    } else {
+        report_json_typed_value(ctx, value);
+    }
+
+    if (key_is_highlighted(key))
+        report_puts(ctx, ",\"highlight\":true");
+
+    g_free(tag);
+    g_free(label);
+}
+
+static void report_json_key_value(ReportContext *ctx, gchar *key, gchar *value,
+                                  gsize longest_key)
+{
+    report_json_field(ctx, key, value);
+    report_puts(ctx, "}");
+}
+
+static void report_json_details_start(ReportContext *ctx, gchar *key,
+                                      gchar *value, gsize longest_key)
+{
+    report_json_field(ctx, key, value);
+    report_puts(ctx, ",\"details\":[");
+
+    ctx->json_details = ++ctx->json_depth;
+    ctx->json_first[ctx->json_depth] = TRUE;
+}
+
+static void report_json_details_end(ReportContext *ctx)
+{
+    /* the "details" list and the field */
+    report_json_close_to(ctx, ctx->json_details - 1);
+}
+
 static GSList *report_create_module_list_from_dialog(ReportDialog * rd)
 {
     ShellModule *module;
@@ -706,6 +1079,8 @@ static GSList *report_create_module_list_from_dialog(ReportDialog * rd)
 
 		gtk_tree_model_get(model, &child, TREE_COL_MODULE_ENTRY, &entry,
 				   -1);
+		if (!module->id)
+		    module->id = g_strdup(entry->module->id);
 		module->entries = g_slist_append(module->entries, entry);
 	    }
 	}
@@ -716,9 +1091,222 @@ static GSList *report_create_module_list_from_dialog(ReportDialog * rd)
     return modules;
 }
 
+/* the table of one entry, calling into its module */
+static void report_entry_table(ReportContext *ctx, ShellModuleEntry *entry)
+{
+    gchar *data;
+
+    ctx->entry = entry;
+    /* report_table() calls into the module as well; a scan may be
+     * running on the shell's worker */
+    module_entry_lock();
+    if ((data = snapshot_get(entry))) {
+        ctx->snapshot = TRUE;
+        report_table(ctx, data);
+        ctx->snapshot = FALSE;
+        g_free(data);
+    } else if (entry->infofunc && ctx->format != REPORT_FORMAT_SHELL) {
+        struct Info *info;
+
+        module_entry_scan(entry);
+        if ((info = module_entry_info(entry))) {
+            report_table_info(ctx, info);
+            if (snapshot_wants(entry)) {
+                data = info_to_key_file(info);
+                snapshot_update(entry, data);
+                snapshot_collect(entry);
+                g_free(data);
+            }
+        }
+        info_free(info);
+    } else {
+        module_entry_scan(entry);
+        data = module_entry_function(entry);
+        snapshot_update(entry, data);
+        report_table(ctx, data);
+        snapshot_collect(entry);
+        g_free(data);
+    }
+    module_entry_unlock();
+}
+
+/*
+ * Without the shell, entries are scanned and their tables rendered on a
+ * thread per lock group (see module_entry_lock()): in order within a group,
+ * and groups at the same time, each table in a context of its own. The
+ * report is put together in order as they get done, so it takes about as
+ * long as the slowest group instead of all of them.
+ *
+ * Each table is written to the stream as soon as the ones before it are,
+ * and a group doesn't start a table more than REPORT_JOBS_AHEAD tables
+ * ahead of that, so only that many are ever held in memory.
+ */
+#define REPORT_JOBS_AHEAD 8
+
+typedef struct {
+    ShellModuleEntry *entry;
+    ReportContext *ctx;
+    guint index;               /* in report order */
+    gboolean done;
+} ReportJob;
+
+static GMutex report_jobs_mutex;
+static GCond report_jobs_cond;
+static guint report_jobs_written;   /* tables written to the stream */
+
+static ReportContext *report_context_fork(ReportContext *ctx)
+{
+    ReportContext *fork = g_new(ReportContext, 1);
+
+    *fork = *ctx;
+    fork->stream = NULL;
+    fork->output = g_string_new(NULL);
+    fork->column_titles = g_hash_table_new_full(g_str_hash, g_str_equal,
+                                                g_free, g_free);
+    fork->icon_refs = NULL;
+    /* tables start right after report_subtitle() */
+    fork->json_depth = REPORT_JSON_TABLE_DEPTH;
+    fork->json_first[REPORT_JSON_TABLE_DEPTH] = TRUE;
+    if (ctx->icon_data)
+        fork->icon_data = g_hash_table_new_full(g_str_hash, g_str_equal,
+                                                g_free, g_free);
+
+    return fork;
+}
+
+/* writes what fork rendered and frees it */
+static void report_context_join(ReportContext *ctx, ReportContext *fork)
+{
+    GHashTableIter iter;
+    gpointer key, value;
+
+    report_puts(ctx, fork->output->str);
+    ctx->columns = fork->columns;
+    ctx->parent_columns = fork->parent_columns;
+    ctx->show_column_headers = fork->show_column_headers;
+    /* the fork only wrote from the tables down; the levels above are
+     * still those of ctx, as report_title() and report_subtitle() left
+     * them */
+    ctx->json_depth = fork->json_depth;
+    memcpy(ctx->json_first + REPORT_JSON_TABLE_DEPTH,
+           fork->json_first + REPORT_JSON_TABLE_DEPTH,
+           sizeof(ctx->json_first) -
+           REPORT_JSON_TABLE_DEPTH * sizeof(ctx->json_first[0]));
+
+    if (fork->icon_data) {
+        g_hash_table_iter_init(&iter, fork->icon_data);
+        while (g_hash_table_iter_next(&iter, &key, &value)) {
+            if (!g_hash_table_lookup(ctx->icon_data, key)) {
+                g_hash_table_iter_steal(&iter);
+                g_hash_table_insert(ctx->icon_data, key, value);
+            }
+        }
+    }
+
+    report_context_free(fork);
+}
+
+static void report_group_worker(gpointer data, gpointer user_data)
+{
+    GSList *jobs = (GSList *)data, *l;
+
+    module_entry_lock_group(((ReportJob *)jobs->data)->entry->module);
+    for (l = jobs; l; l = l->next) {
+        ReportJob *job = (ReportJob *)l->data;
+
+        /* the table being waited for is always the next one of some
+         * group, and within the window, so this can't deadlock */
+        g_mutex_lock(&report_jobs_mutex);
+        while (job->index >= report_jobs_written + REPORT_JOBS_AHEAD)
+            g_cond_wait(&report_jobs_cond, &report_jobs_mutex);
+        g_mutex_unlock(&report_jobs_mutex);
+
+        report_entry_table(job->ctx, job->entry);
+        free_auto_free_thread_final();
+
+        g_mutex_lock(&report_jobs_mutex);
+        job->done = TRUE;
+        g_cond_broadcast(&report_jobs_cond);
+        g_mutex_unlock(&report_jobs_mutex);
+    }
+    module_entry_lock_group(NULL);
+
+    g_slist_free(jobs);
+}
+
+/* NULL if there's no point: a single lock group */
+static GPtrArray *report_jobs_start(ReportContext *ctx, GSList *modules)
+{
+    GHashTable *groups = g_hash_table_new(g_direct_hash, g_direct_equal);
+    GPtrArray *jobs = g_ptr_array_new();
+    GThreadPool *pool;
+    GList *lists, *l;
+    GSList *entries;
+    guint i;
+
+    report_jobs_written = 0;
+
+    for (; modules; modules = modules->next) {
+        ShellModule *module = (ShellModule *)modules->data;
+
+        for (entries = module->entries; entries; entries = entries->next) {
+            ShellModuleEntry *entry = (ShellModuleEntry *)entries->data;
+            ReportJob *job;
+
+            if (entry->flags & MODULE_FLAG_HIDE)
+                continue;
+
+            job = g_new0(ReportJob, 1);
+            job->entry = entry;
+            job->ctx = report_context_fork(ctx);
+            job->index = jobs->len;
+            g_ptr_array_add(jobs, job);
+
+            g_hash_table_insert(groups, module->lock_group,
+                g_slist_prepend(g_hash_table_lookup(groups, module->lock_group),
+                                job));
+        }
+    }
+
+    pool = g_hash_table_size(groups) < 2 ? NULL :
+           g_thread_pool_new(report_group_worker, NULL,
+                             g_hash_table_size(groups), FALSE, NULL);
+    lists = g_hash_table_get_values(groups);
+    for (l = lists; l; l = l->next) {
+        if (pool)
+            g_thread_pool_push(pool, g_slist_reverse(l->data), NULL);
+        else
+            g_slist_free(l->data);
+    }
+    g_list_free(lists);
+    g_hash_table_destroy(groups);
+
+    if (!pool) {
+        for (i = 0; i < jobs->len; i++) {
+            ReportJob *job = g_ptr_array_index(jobs, i);
+
+            report_context_free(job->ctx);
+            g_free(job);
+        }
+        g_ptr_array_free(jobs, TRUE);
+        return NULL;
+    }
+
+    /* the groups already pushed are still done */
+    g_thread_pool_free(pool, FALSE, FALSE);
+
+    return jobs;
+}
+
 static void
 report_create_inner_from_module_list(ReportContext * ctx, GSList * modules)
 {
+    GPtrArray *jobs = NULL;
+    guint n = 0;
+
+    if (!params.gui_running)
+        jobs = report_jobs_start(ctx, modules);
+
     for (; modules; modules = modules->next) {
 	ShellModule *module = (ShellModule *) modules->data;
 	GSList *entries;
@@ -726,6 +1314,7 @@ report_create_inner_from_module_list(ReportContext * ctx, GSList * modules)
 	if (!params.gui_running && !params.quiet)
 	    fprintf(stderr, "\033[40;32m%s\033[0m\n", module->name);
 
+	ctx->module = module;
 	report_title(ctx, module->name);
 
 	for (entries = module->entries; entries; entries = entries->next) {
@@ -741,10 +1330,30 @@ report_create_inner_from_module_list(ReportContext * ctx, GSList * modules)
 
 	    ctx->entry = entry;
 	    report_subtitle(ctx, entry->name);
-	    module_entry_scan(entry);
-	    report_table(ctx, module_entry_function(entry));
+
+	    if (jobs) {
+	        ReportJob *job = g_ptr_array_index(jobs, n++);
+
+	        g_mutex_lock(&report_jobs_mutex);
+	        while (!job->done)
+	            g_cond_wait(&report_jobs_cond, &report_jobs_mutex);
+	        g_mutex_unlock(&report_jobs_mutex);
+
+	        report_context_join(ctx, job->ctx);
+	        g_free(job);
+
+	        g_mutex_lock(&report_jobs_mutex);
+	        report_jobs_written = n;
+	        g_cond_broadcast(&report_jobs_cond);
+	        g_mutex_unlock(&report_jobs_mutex);
+	    } else {
+	        report_entry_table(ctx, entry);
+	    }
 	}
     }
+
+    if (jobs)
+        g_ptr_array_free(jobs, TRUE);
 }
 
 void report_module_list_free(GSList * modules)
@@ -814,7 +1423,7 @@ ReportContext *report_context_html_new()
     ctx->details_keyvalue = report_html_key_value;
     ctx->details_end = report_html_details_end;
 
-    ctx->output = g_strdup("");
+    ctx->output = g_string_new(NULL);
     ctx->format = REPORT_FORMAT_HTML;
 
     ctx->column_titles = g_hash_table_new_full(g_str_hash, g_str_equal,
@@ -843,7 +1452,7 @@ ReportContext *report_context_text_new()
     ctx->details_keyvalue = report_text_key_value;
     ctx->details_end = report_text_footer; /* nothing */
 
-    ctx->output = g_strdup("");
+    ctx->output = g_string_new(NULL);
     ctx->format = REPORT_FORMAT_TEXT;
 
     ctx->column_titles = g_hash_table_new_full(g_str_hash, g_str_equal,
@@ -866,7 +1475,7 @@ ReportContext *report_context_shell_new()
     /* special format handled in report_table(),
      * doesn't need the others. */
 
-    ctx->output = g_strdup("");
+    ctx->output = g_string_new(NULL);
     ctx->format = REPORT_FORMAT_SHELL;
 
     ctx->column_titles = g_hash_table_new_full(g_str_hash, g_str_equal,
@@ -876,6 +1485,33 @@ ReportContext *report_context_shell_new()
     return ctx;
 }
 
+ReportContext *report_context_json_new()
+{
+    ReportContext *ctx;
+
+    ctx = g_new0(ReportContext, 1);
+    ctx->header = report_json_header;
+    ctx->footer = report_json_footer;
+    ctx->title = report_json_title;
+    ctx->subtitle = report_json_subtitle;
+    ctx->subsubtitle = report_json_subsubtitle;
+    ctx->keyvalue = report_json_key_value;
+
+    ctx->details_start = report_json_details_start;
+    ctx->details_section = report_json_subsubtitle;
+    ctx->details_keyvalue = report_json_key_value;
+    ctx->details_end = report_json_details_end;
+
+    ctx->output = g_string_new(NULL);
+    ctx->format = REPORT_FORMAT_JSON;
+
+    ctx->column_titles = g_hash_table_new_full(g_str_hash, g_str_equal,
+                                               g_free, g_free);
+    ctx->first_table = TRUE;
+
+    return ctx;
+}
+
 void report_context_free(ReportContext * ctx)
 {
     g_hash_table_destroy(ctx->column_titles);
@@ -883,7 +1519,8 @@ void report_context_free(ReportContext * ctx)
         g_hash_table_destroy(ctx->icon_refs);
     if(ctx->icon_data)
         g_hash_table_destroy(ctx->icon_data);
-    g_free(ctx->output);
+    if (ctx->output)
+        g_string_free(ctx->output, TRUE);
     g_free(ctx);
 }
 
@@ -917,13 +1554,230 @@ gchar *report_create_from_module_list_format(GSList * modules,
     ctx = create_context();
 
     report_create_from_module_list(ctx, modules);
-    retval = g_strdup(ctx->output);
+    retval = g_string_free(ctx->output, FALSE);
+    ctx->output = NULL;
 
     report_context_free(ctx);
 
     return retval;
 }
 
+/* Like report_create_from_module_list_format(), but writes the report to
+ * stream as it goes. */
+gboolean report_write_from_module_list_format(GSList *modules,
+                                              ReportFormat format,
+                                              FILE *stream)
+{
+    ReportContext *(*create_context) ();
+    ReportContext *ctx;
+
+    if (format >= N_REPORT_FORMAT)
+	return FALSE;
+
+    create_context = file_types[format].data;
+    if (!create_context)
+	return FALSE;
+
+    ctx = create_context();
+    ctx->stream = stream;
+
+    report_create_from_module_list(ctx, modules);
+    fflush(stream);
+
+    report_context_free(ctx);
+
+    return !ferror(stream);
+}
+
+/*
+ * --query: each pattern is a path of globs, "module/entry/group/field",
+ * matched without regard to case against the ids of the module and entry,
+ * which are the same in any language (devices/pci-devices), and the names
+ * of the group and field, which are translated (LC_ALL=C keeps them
+ * stable). With three parts, the last one is either a group or a field:
+ * devices/sensors/temp* as well as computer/summary/memory. Paths are
+ * printed the same way.
+ *
+ * Only the entries some pattern can match are scanned, so only their
+ * modules (and the ones they depend on) are initialized. Matching fields
+ * are printed as "path: value" lines or, with -f json, as a JSON list of
+ * {"path", "value", "number", "unit"}.
+ */
+static gboolean report_query_part(const gchar *pattern, const gchar *name)
+{
+    gchar *lower = g_utf8_strdown(name ? name : "", -1);
+    gboolean match = g_pattern_match_simple(pattern, lower);
+
+    g_free(lower);
+    return match;
+}
+
+static gboolean report_query_entry_match(gchar **parts, ShellModule *module,
+                                         ShellModuleEntry *entry)
+{
+    return report_query_part(parts[0], module->id) &&
+           (!parts[1] || report_query_part(parts[1], entry->id));
+}
+
+static gboolean report_query_field_match(gchar **parts, const gchar *group,
+                                         const gchar *field)
+{
+    switch (g_strv_length(parts)) {
+    case 1:
+    case 2:
+        return TRUE;
+    case 3:
+        return report_query_part(parts[2], group) ||
+               report_query_part(parts[2], field);
+    default:
+        return report_query_part(parts[2], group) &&
+               report_query_part(parts[3], field);
+    }
+}
+
+static void report_query_print(ReportContext *ctx, gint n, const gchar *path,
+                               const gchar *value)
+{
+    if (ctx->format != REPORT_FORMAT_JSON) {
+        report_printf(ctx, "%s: %s\n", path, value);
+        return;
+    }
+
+    report_puts(ctx, n ? ",\n{\"path\":" : "\n{\"path\":");
+    report_json_string(ctx, path);
+    report_puts(ctx, ",\"value\":");
+    report_json_string(ctx, value);
+    report_json_typed_value(ctx, value);
+    report_puts(ctx, "}");
+}
+
+/* prints the fields of entry matching queries, n being the number printed
+ * so far; returns the new one */
+static gint report_query_entry(ReportContext *ctx, GPtrArray *queries,
+                               ShellModule *module, ShellModuleEntry *entry,
+                               gint n)
+{
+    struct Info *info = NULL;
+    gboolean from_key_file = TRUE;
+    gchar *data;
+    guint i, j, q;
+
+    ctx->entry = entry;
+    module_entry_lock();
+    if ((data = snapshot_get(entry))) {
+        ctx->snapshot = TRUE;
+    } else {
+        module_entry_scan(entry);
+        if ((info = module_entry_info(entry)))
+            from_key_file = FALSE;
+        else
+            data = module_entry_function(entry);
+    }
+    if (data) {
+        info = info_unflatten(data);
+        g_free(data);
+    }
+
+    for (i = 0; info && i < info->groups->len; i++) {
+        struct InfoGroup *group = &g_array_index(info->groups, struct InfoGroup, i);
+
+        for (j = 0; group->fields && j < group->fields->len; j++) {
+            struct InfoField *field = &g_array_index(group->fields, struct InfoField, j);
+            gchar *name = g_strdup(field->name ? field->name : "");
+            gchar *value = NULL, *path;
+
+            strend(name, '#');
+            for (q = 0; q < queries->len; q++) {
+                if (report_query_entry_match(g_ptr_array_index(queries, q),
+                                             module, entry) &&
+                    report_query_field_match(g_ptr_array_index(queries, q),
+                                             group->name, name))
+                    break;
+            }
+            if (q == queries->len) {
+                g_free(name);
+                continue;
+            }
+
+            if (field->value && g_str_equal(field->value, "...")) {
+                gchar *key = info_field_key(field, i, j);
+
+                value = report_entry_field(ctx, key);
+                g_free(key);
+            }
+            if (!value)
+                value = from_key_file ? g_strcompress(field->value ? field->value : "")
+                                      : g_strdup(field->value ? field->value : "");
+
+            path = g_strdup_printf("%s/%s/%s/%s", module->id, entry->id,
+                                   group->name ? group->name : "", name);
+            report_query_print(ctx, n++, path, value);
+
+            g_free(path);
+            g_free(value);
+            g_free(name);
+        }
+    }
+
+    ctx->snapshot = FALSE;
+    module_entry_unlock();
+    info_free(info);
+
+    return n;
+}
+
+/* returns the number of fields printed */
+gint report_query(GSList *modules, gchar **patterns, ReportFormat format,
+                  FILE *stream)
+{
+    GPtrArray *queries = g_ptr_array_new_with_free_func((GDestroyNotify)g_strfreev);
+    ReportContext *ctx;
+    GSList *entries;
+    gint n = 0;
+    guint q;
+
+    for (; *patterns; patterns++) {
+        gchar *lower = g_utf8_strdown(*patterns, -1);
+
+        g_ptr_array_add(queries, g_strsplit(lower, "/", 4));
+        g_free(lower);
+    }
+
+    ctx = format == REPORT_FORMAT_JSON ? report_context_json_new()
+                                       : report_context_text_new();
+    ctx->stream = stream;
+    if (ctx->format == REPORT_FORMAT_JSON)
+        report_puts(ctx, "[");
+
+    for (; modules; modules = modules->next) {
+        ShellModule *module = (ShellModule *)modules->data;
+
+        for (entries = module->entries; entries; entries = entries->next) {
+            ShellModuleEntry *entry = (ShellModuleEntry *)entries->data;
+
+            if (entry->flags & MODULE_FLAG_HIDE)
+                continue;
+
+            for (q = 0; q < queries->len; q++) {
+                if (report_query_entry_match(g_ptr_array_index(queries, q),
+                                             module, entry))
+                    break;
+            }
+            if (q < queries->len)
+                n = report_query_entry(ctx, queries, module, entry, n);
+        }
+    }
+
+    if (ctx->format == REPORT_FORMAT_JSON)
+        report_puts(ctx, "\n]\n");
+    fflush(stream);
+
+    report_context_free(ctx);
+    g_ptr_array_free(queries, TRUE);
+
+    return n;
+}
+
 static gboolean report_generate(ReportDialog * rd)
 {
     GSList *modules;
@@ -956,8 +1810,8 @@ static gboolean report_generate(ReportDialog * rd)
     ctx = create_context();
     modules = report_create_module_list_from_dialog(rd);
 
+    ctx->stream = stream;
     report_create_from_module_list(ctx, modules);
-    fputs(ctx->output, stream);
     fclose(stream);
 
     if (ctx->format == REPORT_FORMAT_HTML) {
@@ -32,6 +32,7 @@
 #include "iconcache.h"
 #include "menu.h"
 #include "stock.h"
+#include "snapshot.h"
 
 #include "callbacks.h"
 
@@ -54,11 +55,19 @@ static ShellInfoTree *info_tree_new(void);
 static void module_selected(gpointer data);
 static void module_selected_show_info(ShellModuleEntry * entry,
 				      gboolean reload);
+static void module_selected_show_info_data(ShellModuleEntry *entry,
+                                           const gchar *key_data,
+                                           struct Info *info,
+                                           gboolean reload);
 static void info_selected(GtkTreeSelection * ts, gpointer data);
 static void info_selected_show_extra(const gchar *tag);
 static gboolean reload_section(gpointer data);
 static gboolean rescan_section(gpointer data);
-static gboolean update_field(gpointer data);
+static gboolean update_fields(gpointer data);
+static void info_tree_set_str(GtkTreeIter *iter, gint column, const gchar *value);
+static void scan_queue(ShellModuleEntry *entry, gboolean rescan, gboolean show);
+static void scan_worker(gpointer data, gpointer user_data);
+static gboolean summary_done(gpointer data);
 
 /*
  * Globals ********************************************************************
@@ -67,6 +76,38 @@ static gboolean update_field(gpointer data);
 static Shell *shell = NULL;
 static GHashTable *update_tbl = NULL;
 static GSList *update_sfusrc = NULL;
+static GHashTable *field_history = NULL;   /* "entry/field" -> LoadGraphSeries */
+static guint reload_source = 0;
+static guint rescan_source = 0;
+
+/* Scans run on this pool, so the window isn't frozen while a module runs
+ * external programs. Module code isn't thread safe and every call into it
+ * holds module_entry_lock() anyway, so a single worker is enough. */
+static GThreadPool *scan_pool = NULL;
+static GThread *shell_thread = NULL;
+static gint scan_generation = 0;  /* bumped when the selection changes */
+static gint scans_shown = 0;      /* jobs whose result will be shown */
+static guint scan_pulse_source = 0;
+static ShellModuleEntry *shown_entry = NULL;  /* whose data is in the view */
+
+typedef struct {
+    gchar *icon, *name, *value;
+} ShellSummaryItem;
+
+typedef struct {
+    ShellModuleEntry *entry;
+    gint generation;
+    gboolean rescan;
+    gboolean show;
+    gchar *key_data;
+    struct Info *info;        /* instead of key_data, if the entry has one */
+
+    /* instead of entry: a module's summary (ShellSummaryItem), which also
+     * has to wait for the module to be initialized */
+    ShellModule *summary;
+    GSList *summary_items;
+    gboolean summary_failed;
+} ShellScanJob;
 
 gchar *lginterval = NULL;
 
@@ -235,8 +276,18 @@ void shell_action_set_active(const gchar * action_name, gboolean setting)
     }
 }
 
+/* modules report progress from their scan callbacks, which may be running
+ * on the scan pool; only the main thread can touch the window */
+static gboolean shell_in_worker(void)
+{
+    return params.gui_running && shell_thread && g_thread_self() != shell_thread;
+}
+
 void shell_status_pulse(void)
 {
+    if (shell_in_worker())
+	return;
+
     if (params.gui_running) {
 	if (shell->_pulses++ == 5) {
 	    /* we're pulsing for some time, disable the interface and change the cursor
@@ -257,6 +308,9 @@ void shell_status_pulse(void)
 
 void shell_status_set_percentage(gint percentage)
 {
+    if (shell_in_worker())
+	return;
+
     if (params.gui_running) {
 	gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(shell->progress),
 				      (float) percentage / 100.0);
@@ -278,7 +332,7 @@ void shell_status_set_percentage(gint percentage)
 
 void shell_view_set_enabled(gboolean setting)
 {
-    if (!params.gui_running)
+    if (!params.gui_running || shell_in_worker())
 	return;
 
     if (setting) {
@@ -299,7 +353,7 @@ void shell_view_set_enabled(gboolean setting)
 
 void shell_status_set_enabled(gboolean setting)
 {
-    if (!params.gui_running)
+    if (!params.gui_running || shell_in_worker())
 	return;
 
     if (setting)
@@ -317,6 +371,13 @@ void shell_do_reload(void)
     if (!params.gui_running || !shell->selected)
 	return;
 
+    if (!(shell->selected->flags & MODULE_FLAG_SYNC_SCAN)) {
+        /* results replace the current ones when ready */
+        if (!shell->selected->scans_pending)
+            scan_queue(shell->selected, TRUE, TRUE);
+        return;
+    }
+
     shell_action_set_enabled("RefreshAction", FALSE);
     shell_action_set_enabled("CopyAction", FALSE);
     shell_action_set_enabled("ReportAction", FALSE);
@@ -333,6 +394,9 @@ void shell_do_reload(void)
 
 void shell_status_update(const gchar * message)
 {
+    if (shell_in_worker())
+	return;
+
     if (params.gui_running) {
 	gtk_label_set_markup(GTK_LABEL(shell->status), message);
 	gtk_progress_bar_pulse(GTK_PROGRESS_BAR(shell->progress));
@@ -795,6 +859,11 @@ void shell_init(GSList * modules)
 
     update_tbl = g_hash_table_new_full(g_str_hash, g_str_equal,
                                        g_free, destroy_update_tbl_value);
+    field_history = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                          (GDestroyNotify)load_graph_series_free);
+
+    shell_thread = g_thread_self();
+    scan_pool = g_thread_pool_new(scan_worker, NULL, 1, FALSE, NULL);
 
     gtk_box_pack_start(GTK_BOX(shell->hbox), shell->tree->scroll,
                        FALSE, FALSE, 0);
@@ -846,66 +915,165 @@ void shell_init(GSList * modules)
     g_idle_add(select_first_tree_item, NULL);
 }
 
-static gboolean update_field(gpointer data)
+static void update_fields_remove(ShellFieldUpdateSource *src)
 {
-    ShellFieldUpdate *fu;
-    struct UpdateTableItem *item;
+    GSList *l;
+
+    for (l = src->sfus; l; l = l->next) {
+        ShellFieldUpdate *fu = (ShellFieldUpdate *)l->data;
+
+        g_free(fu->field_name);
+        g_free(fu);
+    }
+    g_slist_free(src->sfus);
 
-    fu = (ShellFieldUpdate *)data;
-    g_return_val_if_fail(fu != NULL, FALSE);
+    update_sfusrc = g_slist_remove(update_sfusrc, src);
+    g_free(src);
+}
 
-    DEBUG("update_field [%s]", fu->field_name);
+/* One tick for all the fields with the same UpdateInterval: the values are
+ * fetched under a single module lock, then set in one go, only where they
+ * changed. */
+static void shell_field_history_add(ShellFieldUpdate *fu, const gchar *value)
+{
+    gchar *end;
+    gdouble v = g_ascii_strtod(value, &end);
 
-    item = g_hash_table_lookup(update_tbl, fu->field_name);
-    if (!item) {
+    /* only values starting with a number, e.g. "42.0 MiB" */
+    if (end != value)
+        load_graph_series_add(fu->series, v);
+}
+
+/* The selected fields (more than one with Ctrl) are drawn on top of each
+ * other, as far as the load graph has lines for them. */
+static void shell_load_graph_show_selected(void)
+{
+    static guint shown = 0;
+    gchar *title = NULL;
+    GSList *s, *l;
+    guint line = 0, l_shown;
+
+    for (s = update_sfusrc; s; s = s->next) {
+        ShellFieldUpdateSource *src = (ShellFieldUpdateSource *)s->data;
+
+        for (l = src->sfus; l; l = l->next) {
+            ShellFieldUpdate *fu = (ShellFieldUpdate *)l->data;
+            struct UpdateTableItem *item;
+            const gchar *label;
+
+            item = g_hash_table_lookup(update_tbl, fu->field_name);
+            if (!item || !item->is_iter ||
+                !gtk_tree_selection_iter_is_selected(shell->info_tree->selection,
+                                                     item->iter))
+                continue;
+
+            label = g_utf8_strrchr(fu->field_name, -1, '$');
+            label = label ? label + 1 : fu->field_name;
+
+            load_graph_set_series(shell->loadgraph, line++, fu->series);
+            title = appf(title, ", ", "%s", label);
+        }
+    }
+
+    /* lines no longer selected; ones past what the load graph has are
+     * ignored */
+    for (l_shown = line; line < shown; line++)
+        load_graph_set_series(shell->loadgraph, line, NULL);
+    shown = l_shown;
+
+    load_graph_set_title(shell->loadgraph, title ? title : "");
+    load_graph_redraw(shell->loadgraph);
+    g_free(title);
+}
+
+static gboolean update_fields(gpointer data)
+{
+    ShellFieldUpdateSource *src = (ShellFieldUpdateSource *)data;
+    ShellModuleEntry *entry;
+    struct UpdateTableItem **items;
+    gchar **values;
+    GSList *l;
+    gint i, n;
+
+    entry = ((ShellFieldUpdate *)src->sfus->data)->entry;
+
+    /* otherwise, cleanup and destroy the timeout */
+    if (!entry->selected || (!entry->fieldfunc && !entry->fieldsfunc)) {
+        update_fields_remove(src);
         return FALSE;
     }
 
-    /* if the entry is still selected, update it */
-    if (fu->entry->selected && fu->entry->fieldfunc) {
-        gchar *value = fu->entry->fieldfunc(fu->field_name);
-
-        if (item->is_iter) {
-            /*
-             * this function is also used to feed the load graph when ViewType
-             * is SHELL_VIEW_LOAD_GRAPH
-             */
-            if (shell->view_type == SHELL_VIEW_LOAD_GRAPH &&
-                gtk_tree_selection_iter_is_selected(shell->info_tree->selection,
-                                                    item->iter)) {
-
-                load_graph_set_title(shell->loadgraph, fu->field_name);
-                load_graph_update(shell->loadgraph, atof(value));
-            }
+    /* busy scanning; try again on the next tick */
+    if (!module_entry_trylock())
+        return TRUE;
 
-            GtkTreeStore *store = GTK_TREE_STORE(shell->info_tree->model);
-            gtk_tree_store_set(store, item->iter, INFO_TREE_COL_VALUE, value, -1);
-        } else {
-            GList *children = gtk_container_get_children(GTK_CONTAINER(item->widget));
-            gtk_label_set_markup(GTK_LABEL(children->next->data), value);
-            g_list_free(children);
+    n = g_slist_length(src->sfus);
+    items = g_new0(struct UpdateTableItem *, n);
+    values = g_new0(gchar *, n + 1);
+
+    if (entry->fieldsfunc) {
+        /* in one call; the module may refresh what they come from once */
+        gchar **fields = g_new0(gchar *, n + 1), **batch;
+        gint n_fields = 0;
+
+        for (i = 0, l = src->sfus; l; l = l->next, i++) {
+            ShellFieldUpdate *fu = (ShellFieldUpdate *)l->data;
+
+            items[i] = g_hash_table_lookup(update_tbl, fu->field_name);
+            if (items[i])
+                fields[n_fields++] = fu->field_name;
         }
 
-        g_free(value);
-        return TRUE;
+        batch = g_new0(gchar *, n_fields + 1);
+        entry->fieldsfunc(entry->number, fields, batch);
+        for (i = 0, n_fields = 0; i < n; i++) {
+            if (items[i])
+                values[i] = batch[n_fields++];
+        }
+        g_free(batch);
+        g_free(fields);
+    } else {
+        for (i = 0, l = src->sfus; l; l = l->next, i++) {
+            ShellFieldUpdate *fu = (ShellFieldUpdate *)l->data;
+
+            items[i] = g_hash_table_lookup(update_tbl, fu->field_name);
+            if (items[i])
+                values[i] = entry->fieldfunc(fu->field_name);
+        }
     }
+    module_entry_unlock();
 
-    if (update_sfusrc) {
-        GSList *sfu;
+    DEBUG("update_fields [%dms, %d fields]", src->interval, n);
 
-        for (sfu = update_sfusrc; sfu; sfu = sfu->next) {
-            g_free(sfu->data);
-        }
+    for (i = 0, l = src->sfus; l; l = l->next, i++) {
+        ShellFieldUpdate *fu = (ShellFieldUpdate *)l->data;
+
+        if (!items[i] || !values[i])
+            continue;
 
-        g_slist_free(update_sfusrc);
-        update_sfusrc = NULL;
+        shell_field_history_add(fu, values[i]);
+
+        if (items[i]->is_iter) {
+            info_tree_set_str(items[i]->iter, INFO_TREE_COL_VALUE, values[i]);
+        } else {
+            GList *children = gtk_container_get_children(GTK_CONTAINER(items[i]->widget));
+            gtk_label_set_markup(GTK_LABEL(children->next->data), values[i]);
+            g_list_free(children);
+        }
     }
 
-    /* otherwise, cleanup and destroy the timeout */
-    g_free(fu->field_name);
-    g_free(fu);
+    /* not a strv: fields whose row is gone have no value */
+    for (i = 0; i < n; i++)
+        g_free(values[i]);
+    g_free(values);
+    g_free(items);
 
-    return FALSE;
+    /* the history is also what the load graph shows, when ViewType is
+     * SHELL_VIEW_LOAD_GRAPH */
+    if (shell->view_type == SHELL_VIEW_LOAD_GRAPH)
+        shell_load_graph_show_selected();
+
+    return TRUE;
 }
 
 #if GTK_CHECK_VERSION(3, 0, 0)
@@ -939,74 +1107,80 @@ static void detail_view_clear(DetailView *detail_view)
     RANGE_SET_VALUE(detail_view, hscrollbar, 0.0);
 }
 
-static gboolean reload_section(gpointer data)
+/* shows key_data (or info) in place of the entry's current data; the info
+ * tree is updated in place (see InfoTreeLevel), so it keeps its selection
+ * and scroll position by itself */
+static void reload_section_show(ShellModuleEntry *entry, const gchar *key_data,
+                                struct Info *info)
 {
-    ShellModuleEntry *entry = (ShellModuleEntry *)data;
 #if GTK_CHECK_VERSION(2, 14, 0)
     GdkWindow *gdk_window = gtk_widget_get_window(GTK_WIDGET(shell->window));
 #endif
+    double pos_detail_scroll;
 
-    /* if the entry is still selected, update it */
-    if (entry->selected) {
-        GtkTreePath *path = NULL;
-        GtkTreeIter iter;
-        double pos_info_scroll;
-        double pos_detail_scroll;
-
-        /* save current position */
+    /* save current position */
 #if GTK_CHECK_VERSION(3, 0, 0)
-        /* TODO:GTK3 */
+    /* TODO:GTK3 */
 #else
-        pos_info_scroll = RANGE_GET_VALUE(info_tree, vscrollbar);
-        pos_detail_scroll = RANGE_GET_VALUE(detail_view, vscrollbar);
+    pos_detail_scroll = RANGE_GET_VALUE(detail_view, vscrollbar);
 #endif
 
-        /* avoid drawing the window while we reload */
+    /* avoid drawing the window while we reload */
 #if GTK_CHECK_VERSION(2, 14, 0)
-        gdk_window_freeze_updates(gdk_window);
+    gdk_window_freeze_updates(gdk_window);
 #else
-        gdk_window_freeze_updates(shell->window->window);
+    gdk_window_freeze_updates(shell->window->window);
 #endif
 
-        /* gets the current selected path */
-        if (gtk_tree_selection_get_selected(shell->info_tree->selection,
-                                            &shell->info_tree->model, &iter)) {
-            path = gtk_tree_model_get_path(shell->info_tree->model, &iter);
-        }
-
-        /* update the information, clear the treeview and populate it again */
-        module_entry_reload(entry);
-        detail_view_clear(shell->detail_view);
-        module_selected_show_info(entry, TRUE);
-
-        /* if there was a selection, reselect it */
-        if (path) {
-            gtk_tree_selection_select_path(shell->info_tree->selection, path);
-            gtk_tree_view_set_cursor(GTK_TREE_VIEW(shell->info_tree->view),
-                                     path, NULL, FALSE);
-            gtk_tree_path_free(path);
-        } else {
-            /* restore position */
-#if GTK_CHECK_VERSION(3, 0, 0)
-            /* TODO:GTK3 */
-#else
-            RANGE_SET_VALUE(info_tree, vscrollbar, pos_info_scroll);
-#endif
-        }
+    /* the detail view is populated again */
+    detail_view_clear(shell->detail_view);
+    module_selected_show_info_data(entry, key_data, info, TRUE);
 
 #if !GTK_CHECK_VERSION(3, 0, 0)
-        RANGE_SET_VALUE(detail_view, vscrollbar, pos_detail_scroll);
+    RANGE_SET_VALUE(detail_view, vscrollbar, pos_detail_scroll);
 #endif
 
-        /* make the window drawable again */
+    /* make the window drawable again */
 #if GTK_CHECK_VERSION(2, 14, 0)
-        gdk_window_thaw_updates(gdk_window);
+    gdk_window_thaw_updates(gdk_window);
 #else
-        gdk_window_thaw_updates(shell->window->window);
+    gdk_window_thaw_updates(shell->window->window);
 #endif
-    }
+}
+
+static gboolean reload_section(gpointer data)
+{
+    ShellModuleEntry *entry = (ShellModuleEntry *)data;
+
+    /* the scan in progress will be shown soon enough */
+    if (entry->selected && entry->scans_pending)
+        return TRUE;
 
     /* destroy the timeout: it'll be set up again */
+    reload_source = 0;
+
+    /* if the entry is still selected, update it */
+    if (!entry->selected)
+        return FALSE;
+
+    if (entry->flags & MODULE_FLAG_SYNC_SCAN) {
+        gchar *key_data = NULL;
+        struct Info *info;
+
+        module_entry_lock();
+        module_entry_reload(entry);
+        info = module_entry_info(entry);
+        if (!info)
+            key_data = module_entry_function(entry);
+        reload_section_show(entry, key_data, info);
+        module_entry_unlock();
+
+        info_free(info);
+        g_free(key_data);
+    } else {
+        scan_queue(entry, TRUE, TRUE);
+    }
+
     return FALSE;
 }
 
@@ -1014,9 +1188,17 @@ static gboolean rescan_section(gpointer data)
 {
     ShellModuleEntry *entry = (ShellModuleEntry *) data;
 
-    module_entry_reload(entry);
+    if (!entry->selected) {
+        rescan_source = 0;
+        return FALSE;
+    }
 
-    return entry->selected;
+    if (entry->flags & MODULE_FLAG_SYNC_SCAN)
+        module_entry_reload(entry);
+    else if (!entry->scans_pending)
+        scan_queue(entry, TRUE, FALSE);
+
+    return TRUE;
 }
 
 static gint
@@ -1069,6 +1251,11 @@ static void set_view_type(ShellViewType viewtype, gboolean reload)
     shell->view_type = viewtype;
     shell->_order_type = SHELL_ORDER_DESCENDING;
 
+    /* fields can be graphed together */
+    gtk_tree_selection_set_mode(shell->info_tree->selection,
+                                viewtype == SHELL_VIEW_LOAD_GRAPH ?
+                                GTK_SELECTION_MULTIPLE : GTK_SELECTION_SINGLE);
+
     /* use an unsorted tree model */
     GtkTreeSortable *sortable = GTK_TREE_SORTABLE(shell->info_tree->model);
 
@@ -1126,7 +1313,8 @@ static void set_view_type(ShellViewType viewtype, gboolean reload)
         gtk_widget_show(shell->info_tree->scroll);
         gtk_notebook_set_current_page(GTK_NOTEBOOK(shell->notebook), 0);
         gtk_widget_show(shell->notebook);
-        load_graph_clear(shell->loadgraph);
+        if (!reload)
+            load_graph_clear(shell->loadgraph);
 
         if (type_changed) {
 #if GTK_CHECK_VERSION(2, 18, 0)
@@ -1166,6 +1354,114 @@ static void set_view_type(ShellViewType viewtype, gboolean reload)
     }
 }
 
+/* fields with the same interval share a timeout; see update_fields() */
+static void shell_add_field_update(ShellModuleEntry *entry,
+                                   const gchar *field_name, gint ms)
+{
+    ShellFieldUpdate *fu = g_new0(ShellFieldUpdate, 1);
+    ShellFieldUpdateSource *sfutbl = NULL;
+    GSList *l;
+    gchar *key;
+
+    fu->field_name = g_strdup(field_name);
+    fu->entry = entry;
+
+    /* kept for as long as hardinfo runs, whichever entry is selected */
+    key = g_strdup_printf("%s/%s", entry->name, field_name);
+    fu->series = g_hash_table_lookup(field_history, key);
+    if (!fu->series) {
+        fu->series = load_graph_series_new(ms);
+        g_hash_table_insert(field_history, key, fu->series);
+    } else {
+        g_free(key);
+    }
+
+    for (l = update_sfusrc; l; l = l->next) {
+        if (((ShellFieldUpdateSource *)l->data)->interval == ms) {
+            sfutbl = (ShellFieldUpdateSource *)l->data;
+            break;
+        }
+    }
+
+    if (!sfutbl) {
+        sfutbl = g_new0(ShellFieldUpdateSource, 1);
+        sfutbl->interval = ms;
+        sfutbl->source_id = g_timeout_add(ms, update_fields, sfutbl);
+        update_sfusrc = g_slist_prepend(update_sfusrc, sfutbl);
+    }
+
+    sfutbl->sfus = g_slist_prepend(sfutbl->sfus, fu);
+}
+
+static void shell_set_reload_interval(ShellModuleEntry *entry, gint ms)
+{
+    /* only the entry being shown reloads */
+    if (reload_source)
+        g_source_remove(reload_source);
+    reload_source = g_timeout_add(ms, reload_section, entry);
+}
+
+static void shell_set_column_title(const gchar *column, const gchar *title)
+{
+    GtkTreeViewColumn *col = NULL;
+
+    if (g_str_equal(column, "Extra1")) {
+        col = shell->info_tree->col_extra1;
+    } else if (g_str_equal(column, "Extra2")) {
+        col = shell->info_tree->col_extra2;
+    } else if (g_str_equal(column, "Value")) {
+        col = shell->info_tree->col_value;
+    } else if (g_str_equal(column, "TextValue")) {
+        col = shell->info_tree->col_textvalue;
+    } else if (g_str_equal(column, "Progress")) {
+        col = shell->info_tree->col_progress;
+    }
+
+    if (col) {
+        gtk_tree_view_column_set_title(col, title);
+        gtk_tree_view_column_set_visible(col, TRUE);
+    }
+}
+
+/* tag, or name for untagged fields */
+static void shell_set_field_icon(const gchar *tag, const gchar *name,
+                                 const gchar *file)
+{
+    struct UpdateTableItem *item;
+    GdkPixbuf *pixbuf;
+
+    item = g_hash_table_lookup(update_tbl, tag ? tag : name);
+    if (!item)
+        return;
+
+    pixbuf = icon_cache_get_pixbuf_at_size(file, 22, 22);
+    if (item->is_iter) {
+        GdkPixbuf *current;
+
+        /* rows are reused on reload */
+        gtk_tree_model_get(shell->info_tree->model, item->iter,
+                           INFO_TREE_COL_PBUF, &current, -1);
+        if (current != pixbuf)
+            gtk_tree_store_set(GTK_TREE_STORE(shell->info_tree->model),
+                               item->iter, INFO_TREE_COL_PBUF, pixbuf, -1);
+        if (current)
+            g_object_unref(current);
+    } else {
+        GList *children = gtk_container_get_children(GTK_CONTAINER(item->widget));
+        gtk_image_set_from_pixbuf(GTK_IMAGE(children->data), pixbuf);
+        gtk_widget_show(GTK_WIDGET(children->data));
+        g_list_free(children);
+    }
+}
+
+static void shell_set_zebra(gboolean setting)
+{
+#if GTK_CHECK_VERSION(3, 0, 0)
+#else
+    gtk_tree_view_set_rules_hint(GTK_TREE_VIEW(shell->info_tree->view), setting);
+#endif
+}
+
 static void group_handle_special(GKeyFile *key_file,
                                  ShellModuleEntry *entry,
                                  const gchar *group,
@@ -1183,8 +1479,6 @@ static void group_handle_special(GKeyFile *key_file,
         gchar *key = keys[i];
 
         if (g_str_has_prefix(key, "UpdateInterval$")) {
-            ShellFieldUpdate *fu = g_new0(ShellFieldUpdate, 1);
-            ShellFieldUpdateSource *sfutbl;
             gint ms;
 
             ms = g_key_file_get_integer(key_file, group, key, NULL);
@@ -1195,14 +1489,7 @@ static void group_handle_special(GKeyFile *key_file,
              * send both tag and label and let the hi_get_field() function use
              * key_get_components() to split it. */
             const gchar *chk = g_utf8_strchr(key, -1, '$');
-            fu->field_name = g_strdup(key_is_flagged(chk) ? chk : chk + 1);
-            fu->entry = entry;
-
-            sfutbl = g_new0(ShellFieldUpdateSource, 1);
-            sfutbl->source_id = g_timeout_add(ms, update_field, fu);
-            sfutbl->sfu = fu;
-
-            update_sfusrc = g_slist_prepend(update_sfusrc, sfutbl);
+            shell_add_field_update(entry, key_is_flagged(chk) ? chk : chk + 1, ms);
         } else if (g_str_equal(key, "NormalizePercentage")) {
             shell->normalize_percentage =
                 g_key_file_get_boolean(key_file, group, key, NULL);
@@ -1214,82 +1501,40 @@ static void group_handle_special(GKeyFile *key_file,
             gint ms;
 
             ms = g_key_file_get_integer(key_file, group, key, NULL);
-
-            g_timeout_add(ms, reload_section, entry);
+            shell_set_reload_interval(entry, ms);
         } else if (g_str_equal(key, "RescanInterval")) {
             gint ms;
 
             ms = g_key_file_get_integer(key_file, group, key, NULL);
 
-            g_timeout_add(ms, rescan_section, entry);
+            if (rescan_source)
+                g_source_remove(rescan_source);
+            rescan_source = g_timeout_add(ms, rescan_section, entry);
         } else if (g_str_equal(key, "ShowColumnHeaders")) {
             headers_visible =
                 g_key_file_get_boolean(key_file, group, key, NULL);
         } else if (g_str_has_prefix(key, "ColumnTitle")) {
-            GtkTreeViewColumn *column = NULL;
             gchar *value, *title = g_utf8_strchr(key, -1, '$') + 1;
 
             value = g_key_file_get_value(key_file, group, key, NULL);
-
-            if (g_str_equal(title, "Extra1")) {
-                column = shell->info_tree->col_extra1;
-            } else if (g_str_equal(title, "Extra2")) {
-                column = shell->info_tree->col_extra2;
-            } else if (g_str_equal(title, "Value")) {
-                column = shell->info_tree->col_value;
-            } else if (g_str_equal(title, "TextValue")) {
-                column = shell->info_tree->col_textvalue;
-            } else if (g_str_equal(title, "Progress")) {
-                column = shell->info_tree->col_progress;
-            }
-
-            if (column) {
-                gtk_tree_view_column_set_title(column, value);
-                gtk_tree_view_column_set_visible(column, TRUE);
-            }
-
+            shell_set_column_title(title, value);
             g_free(value);
         } else if (g_str_equal(key, "OrderType")) {
             shell->_order_type =
                 g_key_file_get_integer(key_file, group, key, NULL);
         } else if (g_str_has_prefix(key, "Icon$")) {
-            struct UpdateTableItem *item;
-
             const gchar *ikey = g_utf8_strchr(key, -1, '$');
-            gchar *tag, *name;
+            gchar *tag, *name, *file;
             key_get_components(ikey, NULL, &tag, &name, NULL, NULL, TRUE);
 
-            if (tag)
-                item = g_hash_table_lookup(update_tbl, tag);
-             else
-                item = g_hash_table_lookup(update_tbl, name);
+            file = g_key_file_get_value(key_file, group, key, NULL);
+            shell_set_field_icon(tag, name, file);
+
+            g_free(file);
             g_free(name);
             g_free(tag);
-
-            if (item) {
-                gchar *file = g_key_file_get_value(key_file, group, key, NULL);
-                GdkPixbuf *pixbuf = icon_cache_get_pixbuf_at_size(file, 22, 22);
-
-                g_free(file);
-
-                if (item->is_iter) {
-                    gtk_tree_store_set(
-                        GTK_TREE_STORE(shell->info_tree->model), item->iter,
-                        INFO_TREE_COL_PBUF, pixbuf, -1);
-                } else {
-                    GList *children = gtk_container_get_children(GTK_CONTAINER(item->widget));
-                    gtk_image_set_from_pixbuf(GTK_IMAGE(children->data), pixbuf);
-                    gtk_widget_show(GTK_WIDGET(children->data));
-                    g_list_free(children);
-                }
-            }
         } else if (g_str_equal(key, "Zebra")) {
-#if GTK_CHECK_VERSION(3, 0, 0)
-#else
-            gtk_tree_view_set_rules_hint(
-                GTK_TREE_VIEW(shell->info_tree->view),
-                g_key_file_get_boolean(key_file, group, key, NULL));
-#endif
+            shell_set_zebra(g_key_file_get_boolean(key_file, group, key, NULL));
         }
     }
 
@@ -1297,23 +1542,159 @@ static void group_handle_special(GKeyFile *key_file,
                                       headers_visible);
 }
 
+/* Rows are added to the info tree through an InfoTreeLevel: rows already
+ * under its parent are reused, in order, for the rows with the same name,
+ * and only the values that changed are set. On a reload the tree keeps
+ * its selection and scroll position, and unchanged rows aren't redrawn. */
+typedef struct {
+    GtkTreeIter parent;
+    gboolean has_parent;
+    GtkTreeIter next;       /* first row not reused yet */
+    gboolean has_next;
+} InfoTreeLevel;
+
+static void info_tree_level_init(InfoTreeLevel *level, GtkTreeIter *parent)
+{
+    level->has_parent = parent != NULL;
+    if (parent)
+        level->parent = *parent;
+    level->has_next = gtk_tree_model_iter_children(shell->info_tree->model,
+                                                   &level->next, parent);
+}
+
+/* iter: the row for name, reused (moved in place if need be) or inserted */
+static void info_tree_level_take(InfoTreeLevel *level, GtkTreeIter *iter,
+                                 const gchar *name)
+{
+    GtkTreeModel *model = shell->info_tree->model;
+    GtkTreeStore *store = GTK_TREE_STORE(model);
+    GtkTreeIter row;
+    gboolean found = FALSE;
+    gint skipped = 0;
+
+    if (level->has_next) {
+        row = level->next;
+        do {
+            gchar *row_name;
+
+            gtk_tree_model_get(model, &row, INFO_TREE_COL_NAME, &row_name, -1);
+            found = g_strcmp0(row_name, name) == 0;
+            g_free(row_name);
+        } while (!found && ++skipped && gtk_tree_model_iter_next(model, &row));
+    }
+
+    if (!found) {
+        gtk_tree_store_insert_before(store, iter,
+                                     level->has_parent ? &level->parent : NULL,
+                                     level->has_next ? &level->next : NULL);
+    } else if (skipped) {
+        /* the rows in between may be wanted later */
+        gtk_tree_store_move_before(store, &row, &level->next);
+        *iter = row;
+    } else {
+        *iter = row;
+        level->has_next = gtk_tree_model_iter_next(model, &level->next);
+    }
+}
+
+/* removes the rows that weren't reused */
+static void info_tree_level_finish(InfoTreeLevel *level)
+{
+    GtkTreeStore *store = GTK_TREE_STORE(shell->info_tree->model);
+
+    while (level->has_next)
+        level->has_next = gtk_tree_store_remove(store, &level->next);
+}
+
+/* sets a string column only if it changed */
+static void info_tree_set_str(GtkTreeIter *iter, gint column, const gchar *value)
+{
+    gchar *current;
+
+    gtk_tree_model_get(shell->info_tree->model, iter, column, &current, -1);
+    if (g_strcmp0(current, value))
+        gtk_tree_store_set(GTK_TREE_STORE(shell->info_tree->model), iter,
+                           column, value, -1);
+    g_free(current);
+}
+
+/* values: the value and extra columns; values[0] is replaced if it is
+ * "..." */
+static void info_tree_add_row(ShellModuleEntry *entry, InfoTreeLevel *level,
+                              const gchar *key, gchar **values, gsize vcount)
+{
+    GtkTreeModel *model = shell->info_tree->model;
+    GtkTreeIter child, grandchild;
+
+    if (entry->fieldfunc && values[0] && g_str_equal(values[0], "...")) {
+        g_free(values[0]);
+        values[0] = entry->fieldfunc((gchar *)key);
+    }
+
+    struct UpdateTableItem *item = g_new0(struct UpdateTableItem, 1);
+    gchar *flags, *tag, *name, *label;
+    key_get_components(key, &flags, &tag, &name, &label, NULL, TRUE);
+
+    //TODO: name was formerly used where label is here. Check all uses
+    //for problems.
+    info_tree_level_take(level, &child, flags ? label : key);
+
+    /* was a group */
+    while (gtk_tree_model_iter_children(model, &grandchild, &child))
+        gtk_tree_store_remove(GTK_TREE_STORE(model), &grandchild);
+
+    info_tree_set_str(&child, INFO_TREE_COL_VALUE, vcount > 0 ? values[0] : NULL);
+    info_tree_set_str(&child, INFO_TREE_COL_EXTRA1, vcount > 1 ? values[1] : NULL);
+    info_tree_set_str(&child, INFO_TREE_COL_EXTRA2, vcount > 2 ? values[2] : NULL);
+    info_tree_set_str(&child, INFO_TREE_COL_NAME, flags ? label : key);
+    info_tree_set_str(&child, INFO_TREE_COL_DATA, flags);
+
+    item->is_iter = TRUE;
+    item->iter = gtk_tree_iter_copy(&child);
+
+    if (flags) {
+        g_hash_table_insert(update_tbl, tag, item);
+    } else {
+        g_hash_table_insert(update_tbl, name, item);
+        g_free(tag);
+    }
+    g_free(label);
+    g_free(flags);
+}
+
+/* parent: the group's row, for an InfoTreeLevel of its fields */
+static void info_tree_add_group(InfoTreeLevel *level, GtkTreeIter *parent,
+                                const gchar *group)
+{
+    gchar *tmp = g_strdup(group);
+
+    strend(tmp, '#');
+    info_tree_level_take(level, parent, tmp);
+
+    /* may have been a field */
+    info_tree_set_str(parent, INFO_TREE_COL_VALUE, NULL);
+    info_tree_set_str(parent, INFO_TREE_COL_EXTRA1, NULL);
+    info_tree_set_str(parent, INFO_TREE_COL_EXTRA2, NULL);
+    info_tree_set_str(parent, INFO_TREE_COL_DATA, NULL);
+    info_tree_set_str(parent, INFO_TREE_COL_NAME, tmp);
+    g_free(tmp);
+}
+
 static void group_handle_normal(GKeyFile *key_file,
                                 ShellModuleEntry *entry,
                                 const gchar *group,
                                 gchar **keys,
-                                gsize ngroups)
+                                gsize ngroups,
+                                InfoTreeLevel *top)
 {
+    InfoTreeLevel children, *level = top;
     GtkTreeIter parent;
-    GtkTreeStore *store = GTK_TREE_STORE(shell->info_tree->model);
     gint i;
 
     if (ngroups > 1) {
-        gtk_tree_store_append(store, &parent, NULL);
-
-        gchar *tmp = g_strdup(group);
-        strend(tmp, '#');
-        gtk_tree_store_set(store, &parent, INFO_TREE_COL_NAME, tmp, -1);
-        g_free(tmp);
+        info_tree_add_group(top, &parent, group);
+        info_tree_level_init(&children, &parent);
+        level = &children;
     }
 
     g_key_file_set_list_separator(key_file, '|');
@@ -1322,7 +1703,6 @@ static void group_handle_normal(GKeyFile *key_file,
         gchar *key = keys[i];
         gchar **values;
         gsize vcount = 0;
-        GtkTreeIter child;
 
         values = g_key_file_get_string_list(key_file, group, key, &vcount, NULL);
         if (!vcount) {
@@ -1337,50 +1717,12 @@ static void group_handle_normal(GKeyFile *key_file,
             }
         }
 
-        if (entry->fieldfunc && values[0] && g_str_equal(values[0], "...")) {
-            g_free(values[0]);
-            values[0] = entry->fieldfunc(key);
-        }
-
-        if (ngroups == 1) {
-            gtk_tree_store_append(store, &child, NULL);
-        } else {
-            gtk_tree_store_append(store, &child, &parent);
-        }
-
-        if (vcount > 0)
-            gtk_tree_store_set(store, &child, INFO_TREE_COL_VALUE,
-                               values[0], -1);
-        if (vcount > 1)
-            gtk_tree_store_set(store, &child, INFO_TREE_COL_EXTRA1,
-                               values[1], -1);
-        if (vcount > 2)
-            gtk_tree_store_set(store, &child, INFO_TREE_COL_EXTRA2,
-                               values[2], -1);
-
-        struct UpdateTableItem *item = g_new0(struct UpdateTableItem, 1);
-        item->is_iter = TRUE;
-        item->iter = gtk_tree_iter_copy(&child);
-        gchar *flags, *tag, *name, *label;
-        key_get_components(key, &flags, &tag, &name, &label, NULL, TRUE);
-
-        if (flags) {
-            //TODO: name was formerly used where label is here. Check all uses
-            //for problems.
-            gtk_tree_store_set(store, &child, INFO_TREE_COL_NAME, label,
-                               INFO_TREE_COL_DATA, flags, -1);
-            g_hash_table_insert(update_tbl, tag, item);
-            g_free(label);
-        } else {
-            gtk_tree_store_set(store, &child, INFO_TREE_COL_NAME, key,
-                               INFO_TREE_COL_DATA, NULL, -1);
-            g_hash_table_insert(update_tbl, name, item);
-            g_free(tag);
-        }
-        g_free(flags);
-
+        info_tree_add_row(entry, level, key, values, vcount);
         g_strfreev(values);
     }
+
+    if (level != top)
+        info_tree_level_finish(level);
 }
 
 static void update_progress()
@@ -1476,20 +1818,12 @@ void shell_set_note_from_entry(ShellModuleEntry * entry)
 
 void shell_clear_field_updates(void)
 {
-    if (update_sfusrc) {
-        GSList *sfusrc;
-
-        for (sfusrc = update_sfusrc; sfusrc; sfusrc = sfusrc->next) {
-            ShellFieldUpdateSource *src =
-                (ShellFieldUpdateSource *) sfusrc->data;
-            g_source_remove(src->source_id);
-            g_free(src->sfu->field_name);
-            g_free(src->sfu);
-            g_free(src);
-        }
+    while (update_sfusrc) {
+        ShellFieldUpdateSource *src =
+            (ShellFieldUpdateSource *) update_sfusrc->data;
 
-        g_slist_free(update_sfusrc);
-        update_sfusrc = NULL;
+        g_source_remove(src->source_id);
+        update_fields_remove(src);
     }
 }
 
@@ -1529,21 +1863,45 @@ static gboolean select_marked_or_first_item(gpointer data)
     return FALSE;
 }
 
-static void module_selected_show_info_list(GKeyFile *key_file,
-                                           ShellModuleEntry *entry,
-                                           gchar **groups,
-                                           gsize ngroups)
+/* A new entry is shown on an empty tree, detached from the view while
+ * it's filled; a reload updates the rows in place (see InfoTreeLevel). */
+static void info_tree_begin(gboolean reload)
 {
-    GtkTreeStore *store = GTK_TREE_STORE(shell->info_tree->model);
-    gint i;
+    if (reload)
+        return;
 
-    gtk_tree_store_clear(store);
+    gtk_tree_store_clear(GTK_TREE_STORE(shell->info_tree->model));
 
     g_object_ref(shell->info_tree->model);
     gtk_tree_view_set_model(GTK_TREE_VIEW(shell->info_tree->view), NULL);
 
     gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(shell->info_tree->view),
                                       FALSE);
+}
+
+static void info_tree_end(gboolean reload, gsize ngroups)
+{
+    if (!reload) {
+        g_object_unref(shell->info_tree->model);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(shell->info_tree->view),
+                                shell->info_tree->model);
+    }
+    gtk_tree_view_expand_all(GTK_TREE_VIEW(shell->info_tree->view));
+    gtk_tree_view_set_show_expanders(GTK_TREE_VIEW(shell->info_tree->view),
+                                     ngroups > 1);
+}
+
+static void module_selected_show_info_list(GKeyFile *key_file,
+                                           ShellModuleEntry *entry,
+                                           gchar **groups,
+                                           gsize ngroups,
+                                           gboolean reload)
+{
+    InfoTreeLevel top;
+    gint i;
+
+    info_tree_begin(reload);
+    info_tree_level_init(&top, NULL);
 
     for (i = 0; groups[i]; i++) {
         gchar **keys = g_key_file_get_keys(key_file, groups[i], NULL, NULL);
@@ -1551,18 +1909,14 @@ static void module_selected_show_info_list(GKeyFile *key_file,
         if (groups[i][0] == '$') {
             group_handle_special(key_file, entry, groups[i], keys);
         } else {
-            group_handle_normal(key_file, entry, groups[i], keys, ngroups);
+            group_handle_normal(key_file, entry, groups[i], keys, ngroups, &top);
         }
 
         g_strfreev(keys);
     }
 
-    g_object_unref(shell->info_tree->model);
-    gtk_tree_view_set_model(GTK_TREE_VIEW(shell->info_tree->view),
-                            shell->info_tree->model);
-    gtk_tree_view_expand_all(GTK_TREE_VIEW(shell->info_tree->view));
-    gtk_tree_view_set_show_expanders(GTK_TREE_VIEW(shell->info_tree->view),
-                                     ngroups > 1);
+    info_tree_level_finish(&top);
+    info_tree_end(reload, ngroups);
 }
 
 static gboolean detail_activate_link (GtkLabel *label, gchar *uri, gpointer user_data) {
@@ -1607,6 +1961,122 @@ static gchar *vendor_info_markup(const Vendor *v) {
     return ven_mt;
 }
 
+static GtkWidget *detail_view_add_group(const gchar *group, gsize nkeys)
+{
+    gchar *group_label = g_strdup(group);
+    strend(group_label, '#');
+
+    gchar *tmp = g_strdup_printf("<b>%s</b>", group_label);
+    GtkWidget *label = gtk_label_new(tmp);
+    gtk_label_set_use_markup(GTK_LABEL(label), TRUE);
+    GtkWidget *frame = gtk_frame_new(NULL);
+    gtk_frame_set_label_widget(GTK_FRAME(frame), label);
+    gtk_frame_set_shadow_type(GTK_FRAME(frame), GTK_SHADOW_NONE);
+    g_free(tmp);
+    g_free(group_label);
+
+    gtk_container_set_border_width(GTK_CONTAINER(frame), 6);
+    gtk_box_pack_start(GTK_BOX(shell->detail_view->view), frame, FALSE,
+                       FALSE, 0);
+
+    GtkWidget *table = gtk_table_new(nkeys, 2, FALSE);
+    gtk_container_set_border_width(GTK_CONTAINER(table), 4);
+    gtk_container_add(GTK_CONTAINER(frame), table);
+
+    gtk_widget_show(table);
+    gtk_widget_show(label);
+    gtk_widget_show(frame);
+
+    return table;
+}
+
+/* takes value; row is advanced past what was added */
+static void detail_view_add_row(GtkWidget *table, gint *row,
+                                ShellModuleEntry *entry, const gchar *key,
+                                gchar *value)
+{
+    gchar *key_markup;
+    gchar *name, *label, *tag, *flags;
+    key_get_components(key, &flags, &tag, &name, &label, NULL, TRUE);
+
+    if (entry && entry->fieldfunc && value && g_str_equal(value, "...")) {
+        g_free(value);
+        value = entry->fieldfunc((gchar *)key);
+    }
+
+    gboolean has_ven = key_value_has_vendor_string(flags);
+    const Vendor *v = has_ven ? vendor_match(value, NULL) : NULL;
+
+    key_markup =
+        g_strdup_printf("<span color=\"#666\">%s</span>", label);
+
+    GtkWidget *key_label = gtk_label_new(key_markup);
+    gtk_label_set_use_markup(GTK_LABEL(key_label), TRUE);
+    gtk_misc_set_alignment(GTK_MISC(key_label), 1.0f, 0.5f);
+
+    GtkWidget *value_label = gtk_label_new(value);
+    gtk_label_set_use_markup(GTK_LABEL(value_label), TRUE);
+    gtk_label_set_selectable(GTK_LABEL(value_label), TRUE);
+#if !GTK_CHECK_VERSION(3, 0, 0)
+    gtk_label_set_line_wrap(GTK_LABEL(value_label), TRUE);
+#endif
+    gtk_misc_set_alignment(GTK_MISC(value_label), 0.0f, 0.5f);
+
+    GtkWidget *value_icon = gtk_image_new();
+
+    GtkWidget *value_box = gtk_hbox_new(FALSE, 4);
+    gtk_box_pack_start(GTK_BOX(value_box), value_icon, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(value_box), value_label, TRUE, TRUE, 0);
+
+    g_signal_connect(key_label, "activate-link", G_CALLBACK(detail_activate_link), NULL);
+    g_signal_connect(value_label, "activate-link", G_CALLBACK(detail_activate_link), NULL);
+
+    gtk_widget_show(key_label);
+    gtk_widget_show(value_box);
+    gtk_widget_show(value_label);
+
+    gtk_table_attach(GTK_TABLE(table), key_label, 0, 1, *row, *row + 1,
+                     GTK_FILL, GTK_FILL, 6, 4);
+    gtk_table_attach(GTK_TABLE(table), value_box, 1, 2, *row, *row + 1,
+                     GTK_FILL | GTK_EXPAND, GTK_FILL, 0, 4);
+    (*row)++;
+
+    if (v) {
+        /* insert a row */
+        gchar *vendor_markup = vendor_info_markup(v);
+        GtkWidget *vendor_label = gtk_label_new(vendor_markup);
+        gtk_label_set_use_markup(GTK_LABEL(vendor_label), TRUE);
+        gtk_label_set_selectable(GTK_LABEL(vendor_label), TRUE);
+        gtk_misc_set_alignment(GTK_MISC(vendor_label), 0.0f, 0.5f);
+        g_signal_connect(vendor_label, "activate-link", G_CALLBACK(detail_activate_link), NULL);
+        GtkWidget *vendor_box = gtk_hbox_new(FALSE, 4);
+        gtk_box_pack_start(GTK_BOX(vendor_box), vendor_label, TRUE, TRUE, 0);
+        gtk_table_attach(GTK_TABLE(table), vendor_box, 1, 2, *row, *row + 1,
+                         GTK_FILL | GTK_EXPAND, GTK_FILL, 0, 4);
+        (*row)++;
+        gtk_widget_show(vendor_box);
+        gtk_widget_show(vendor_label);
+        g_free(vendor_markup);
+    }
+
+    struct UpdateTableItem *item = g_new0(struct UpdateTableItem, 1);
+    item->is_iter = FALSE;
+    item->widget = g_object_ref(value_box);
+
+    if (tag) {
+        g_hash_table_insert(update_tbl, tag, item);
+        g_free(name);
+    } else {
+        g_hash_table_insert(update_tbl, name, item);
+        g_free(tag);
+    }
+
+    g_free(flags);
+    g_free(value);
+    g_free(key_markup);
+    g_free(label);
+}
+
 static void module_selected_show_info_detail(GKeyFile *key_file,
                                              ShellModuleEntry *entry,
                                              gchar **groups)
@@ -1618,141 +2088,246 @@ static void module_selected_show_info_detail(GKeyFile *key_file,
     for (i = 0; groups[i]; i++) {
         gsize nkeys;
         gchar **keys = g_key_file_get_keys(key_file, groups[i], &nkeys, NULL);
-        gchar *group_label = g_strdup(groups[i]);
-        strend(group_label, '#');
 
         if (entry && groups[i][0] == '$') {
             group_handle_special(key_file, entry, groups[i], keys);
         } else {
-            gchar *tmp = g_strdup_printf("<b>%s</b>", group_label);
-            GtkWidget *label = gtk_label_new(tmp);
-            gtk_label_set_use_markup(GTK_LABEL(label), TRUE);
-            GtkWidget *frame = gtk_frame_new(NULL);
-            gtk_frame_set_label_widget(GTK_FRAME(frame), label);
-            gtk_frame_set_shadow_type(GTK_FRAME(frame), GTK_SHADOW_NONE);
-            g_free(tmp);
-
-            gtk_container_set_border_width(GTK_CONTAINER(frame), 6);
-            gtk_box_pack_start(GTK_BOX(shell->detail_view->view), frame, FALSE,
-                               FALSE, 0);
-
-            GtkWidget *table = gtk_table_new(nkeys, 2, FALSE);
-            gtk_container_set_border_width(GTK_CONTAINER(table), 4);
-            gtk_container_add(GTK_CONTAINER(frame), table);
-
-            gint j, a = 0;
+            GtkWidget *table = detail_view_add_group(groups[i], nkeys);
+            gint j, row = 0;
+
             for (j = 0; keys[j]; j++) {
-                gchar *key_markup;
-                gchar *value;
-                gchar *name, *label, *tag, *flags;
-                key_get_components(keys[j], &flags, &tag, &name, &label, NULL, TRUE);
+                gchar *value = g_key_file_get_string(key_file, groups[i], keys[j], NULL);
 
-                value = g_key_file_get_string(key_file, groups[i], keys[j], NULL);
+                detail_view_add_row(table, &row, entry, keys[j], value);
+            }
+        }
 
-                if (entry && entry->fieldfunc && value && g_str_equal(value, "...")) {
-                    g_free(value);
-                    value = entry->fieldfunc(keys[j]);
-                }
+        g_strfreev(keys);
+    }
+}
 
-                gboolean has_ven = key_value_has_vendor_string(flags);
-                const Vendor *v = has_ven ? vendor_match(value, NULL) : NULL;
+static gboolean scan_pulse(gpointer data)
+{
+    gtk_progress_bar_pulse(GTK_PROGRESS_BAR(shell->progress));
+    return TRUE;
+}
 
-                key_markup =
-                    g_strdup_printf("<span color=\"#666\">%s</span>", label);
+static void scan_status_start(const gchar *name)
+{
+    gchar *status;
 
-                GtkWidget *key_label = gtk_label_new(key_markup);
-                gtk_label_set_use_markup(GTK_LABEL(key_label), TRUE);
-                gtk_misc_set_alignment(GTK_MISC(key_label), 1.0f, 0.5f);
+    status = g_strdup_printf(_("Scanning %s..."), name);
+    gtk_label_set_markup(GTK_LABEL(shell->status), status);
+    g_free(status);
 
-                GtkWidget *value_label = gtk_label_new(value);
-                gtk_label_set_use_markup(GTK_LABEL(value_label), TRUE);
-                gtk_label_set_selectable(GTK_LABEL(value_label), TRUE);
-#if !GTK_CHECK_VERSION(3, 0, 0)
-                gtk_label_set_line_wrap(GTK_LABEL(value_label), TRUE);
+    if (scans_shown++)
+        return;
+
+    shell_status_set_enabled(TRUE);
+    scan_pulse_source = g_timeout_add(100, scan_pulse, NULL);
+}
+
+static void scan_status_stop(void)
+{
+    if (--scans_shown)
+        return;
+
+    if (scan_pulse_source) {
+        g_source_remove(scan_pulse_source);
+        scan_pulse_source = 0;
+    }
+    shell_status_set_enabled(FALSE);
+}
+
+static void module_selected_reset_scroll(void)
+{
+    gtk_tree_view_columns_autosize(GTK_TREE_VIEW(shell->info_tree->view));
+
+    /* urgh. why don't GTK do this when the model is cleared? */
+#if GTK_CHECK_VERSION(3, 0, 0)
+    /* TODO:GTK3 */
+#else
+    RANGE_SET_VALUE(info_tree, vscrollbar, 0.0);
+    RANGE_SET_VALUE(info_tree, hscrollbar, 0.0);
+    RANGE_SET_VALUE(detail_view, vscrollbar, 0.0);
+    RANGE_SET_VALUE(detail_view, hscrollbar, 0.0);
 #endif
-                gtk_misc_set_alignment(GTK_MISC(value_label), 0.0f, 0.5f);
-
-                GtkWidget *value_icon = gtk_image_new();
-
-                GtkWidget *value_box = gtk_hbox_new(FALSE, 4);
-                gtk_box_pack_start(GTK_BOX(value_box), value_icon, FALSE, FALSE, 0);
-                gtk_box_pack_start(GTK_BOX(value_box), value_label, TRUE, TRUE, 0);
-
-                g_signal_connect(key_label, "activate-link", G_CALLBACK(detail_activate_link), NULL);
-                g_signal_connect(value_label, "activate-link", G_CALLBACK(detail_activate_link), NULL);
-
-                gtk_widget_show(key_label);
-                gtk_widget_show(value_box);
-                gtk_widget_show(value_label);
-
-                gtk_table_attach(GTK_TABLE(table), key_label, 0, 1, j + a, j + a + 1,
-                                 GTK_FILL, GTK_FILL, 6, 4);
-                gtk_table_attach(GTK_TABLE(table), value_box, 1, 2, j + a, j + a + 1,
-                                 GTK_FILL | GTK_EXPAND, GTK_FILL, 0, 4);
-
-                if (v) {
-                    a++; /* insert a row */
-                    gchar *vendor_markup = vendor_info_markup(v);
-                    GtkWidget *vendor_label = gtk_label_new(vendor_markup);
-                    gtk_label_set_use_markup(GTK_LABEL(vendor_label), TRUE);
-                    gtk_label_set_selectable(GTK_LABEL(vendor_label), TRUE);
-                    gtk_misc_set_alignment(GTK_MISC(vendor_label), 0.0f, 0.5f);
-                    g_signal_connect(vendor_label, "activate-link", G_CALLBACK(detail_activate_link), NULL);
-                    GtkWidget *vendor_box = gtk_hbox_new(FALSE, 4);
-                    gtk_box_pack_start(GTK_BOX(vendor_box), vendor_label, TRUE, TRUE, 0);
-                    gtk_table_attach(GTK_TABLE(table), vendor_box, 1, 2, j + a, j + a + 1,
-                                     GTK_FILL | GTK_EXPAND, GTK_FILL, 0, 4);
-                    gtk_widget_show(vendor_box);
-                    gtk_widget_show(vendor_label);
-                    g_free(vendor_markup);
-                }
-
-                struct UpdateTableItem *item = g_new0(struct UpdateTableItem, 1);
-                item->is_iter = FALSE;
-                item->widget = g_object_ref(value_box);
-
-                if (tag) {
-                    g_hash_table_insert(update_tbl, tag, item);
-                    g_free(name);
-                } else {
-                    g_hash_table_insert(update_tbl, name, item);
-                    g_free(tag);
-                }
-
-                g_free(flags);
-                g_free(value);
-                g_free(key_markup);
-                g_free(label);
-            }
+}
 
-            gtk_widget_show(table);
-            gtk_widget_show(label);
-            gtk_widget_show(frame);
+/* main thread: shows the result if the entry is still selected */
+static gboolean scan_done(gpointer data)
+{
+    ShellScanJob *job = (ShellScanJob *)data;
+    ShellModuleEntry *entry = job->entry;
+
+    if ((job->key_data || job->info) && entry->selected &&
+        job->generation == g_atomic_int_get(&scan_generation)) {
+        /* showing calls into the module for "..." fields and the note;
+         * the next job may have taken the lock already */
+        if (!module_entry_trylock()) {
+            g_timeout_add(50, scan_done, job);
+            return FALSE;
         }
 
-        g_strfreev(keys);
-        g_free(group_label);
+        if (shown_entry == entry) {
+            reload_section_show(entry, job->key_data, job->info);
+        } else {
+            module_selected_show_info_data(entry, job->key_data, job->info,
+                                           FALSE);
+            module_selected_reset_scroll();
+        }
+        module_entry_unlock();
+    }
+
+    if (job->key_data || job->info) {
+        g_free(entry->scan_data);
+        info_free(entry->scan_info);
+        entry->scan_data = job->key_data;
+        entry->scan_info = job->info;
     }
+
+    entry->scans_pending--;
+    if (job->show)
+        scan_status_stop();
+
+    g_free(job);
+    return FALSE;
 }
 
-static void
-module_selected_show_info(ShellModuleEntry *entry, gboolean reload)
+/* the summary page's items; its Method= are called in here too */
+static void summary_collect(ShellScanJob *job)
 {
-    GdkWindow *gdk_window = gtk_widget_get_window(GTK_WIDGET(shell->info_tree->view));
-    gsize ngroups;
+    GKeyFile *keyfile = g_key_file_new();
+    gchar **groups, *detail;
     gint i;
 
-    gdk_window_freeze_updates(gdk_window);
+    module_init_wait(job->summary);
+    module_entry_lock();
+    detail = job->summary->summaryfunc();
+    module_entry_unlock();
 
-    module_entry_scan(entry);
-    if (!reload) {
-        /* recreate the iter hash table */
+    if (!detail || !g_key_file_load_from_data(keyfile, detail,
+                                              strlen(detail), 0, NULL)) {
+        job->summary_failed = TRUE;
+        goto out;
+    }
+
+    groups = g_key_file_get_groups(keyfile, NULL);
+    for (i = 0; groups[i]; i++) {
+        ShellSummaryItem *item = g_new0(ShellSummaryItem, 1);
+        gchar *method;
+
+        item->icon = g_key_file_get_string(keyfile, groups[i], "Icon", NULL);
+        item->name = g_strdup(groups[i]);
+        method = g_key_file_get_string(keyfile, groups[i], "Method", NULL);
+        item->value = method ? module_call_method(method) : g_strdup("N/A");
+        g_free(method);
+
+        job->summary_items = g_slist_prepend(job->summary_items, item);
+    }
+    job->summary_items = g_slist_reverse(job->summary_items);
+    g_strfreev(groups);
+
+out:
+    g_free(detail);
+    g_key_file_free(keyfile);
+}
+
+static void scan_worker(gpointer data, gpointer user_data)
+{
+    ShellScanJob *job = (ShellScanJob *)data;
+
+    if (job->summary) {
+        if (job->generation == g_atomic_int_get(&scan_generation))
+            summary_collect(job);
+        free_auto_free_thread_final();
+        g_idle_add(summary_done, job);
+        return;
+    }
+
+    /* skip it if another entry got selected while this was queued */
+    if (!job->show ||
+        job->generation == g_atomic_int_get(&scan_generation)) {
+        module_entry_lock();
+        if (job->rescan)
+            module_entry_reload(job->entry);
+        else
+            module_entry_scan(job->entry);
+        if (job->show) {
+            job->info = module_entry_info(job->entry);
+            if (!job->info)
+                job->key_data = module_entry_function(job->entry);
+        }
+        if (snapshot_wants(job->entry)) {
+            if (job->info) {
+                gchar *key_data = info_to_key_file(job->info);
+
+                snapshot_update(job->entry, key_data);
+                g_free(key_data);
+            } else {
+                snapshot_update(job->entry, job->key_data);
+            }
+        }
+        module_entry_unlock();
+    }
+
+    /* the info was detached; what the scan idle_free()d can go */
+    free_auto_free_thread_final();
+
+    g_idle_add(scan_done, job);
+}
+
+/* Scans the entry on the scan pool; with show, the result replaces what is
+ * on the view when ready, if the entry is still selected. */
+static void scan_queue(ShellModuleEntry *entry, gboolean rescan, gboolean show)
+{
+    ShellScanJob *job = g_new0(ShellScanJob, 1);
+
+    job->entry = entry;
+    job->generation = g_atomic_int_get(&scan_generation);
+    job->rescan = rescan;
+    job->show = show;
+
+    entry->scans_pending++;
+    if (show)
+        scan_status_start(entry->name);
+
+    g_thread_pool_push(scan_pool, job, NULL);
+}
+
+/* Shows the data from the last scan, or from the snapshot, if there is
+ * one, while the entry is scanned again. */
+static void module_selected_show_cached(ShellModuleEntry *entry)
+{
+    if (!entry->scan_data && !entry->scan_info)
+        entry->scan_data = snapshot_get(entry);
+
+    if ((entry->scan_data || entry->scan_info) && module_entry_trylock()) {
+        module_selected_show_info_data(entry, entry->scan_data,
+                                       entry->scan_info, FALSE);
+        module_entry_unlock();
+        module_selected_reset_scroll();
+    } else {
         h_hash_table_remove_all(update_tbl);
+        shell_clear_field_updates();
+        gtk_tree_store_clear(GTK_TREE_STORE(shell->info_tree->model));
+        detail_view_clear(shell->detail_view);
+        set_view_type(SHELL_VIEW_NORMAL, FALSE);
+        gtk_widget_hide(shell->note->event_box);
+        shown_entry = NULL;
     }
-    shell_clear_field_updates();
+
+    scan_queue(entry, FALSE, TRUE);
+}
+
+static void
+module_selected_show_info_key_file(ShellModuleEntry *entry,
+                                   const gchar *key_data, gboolean reload)
+{
+    gsize ngroups;
+    gint i;
 
     GKeyFile *key_file = g_key_file_new();
-    gchar *key_data = module_entry_function(entry);
 
     g_key_file_load_from_data(key_file, key_data, strlen(key_data), 0, NULL);
     set_view_type(g_key_file_get_integer(key_file, "$ShellParam$",
@@ -1768,12 +2343,168 @@ module_selected_show_info(ShellModuleEntry *entry, gboolean reload)
     if (shell->view_type == SHELL_VIEW_DETAIL) {
         module_selected_show_info_detail(key_file, entry, groups);
     } else {
-        module_selected_show_info_list(key_file, entry, groups, ngroups);
+        module_selected_show_info_list(key_file, entry, groups, ngroups, reload);
     }
 
     g_strfreev(groups);
     g_key_file_free(key_file);
-    g_free(key_data);
+}
+
+/* The struct Info counterpart of group_handle_special(); the "$ShellParam$"
+ * group comes last in the key-file form, so this is done after the groups
+ * too. */
+static void info_handle_params(struct Info *info, ShellModuleEntry *entry)
+{
+    guint i, j;
+
+    shell->normalize_percentage = info->normalize_percentage;
+    if (info->reload_interval)
+        shell_set_reload_interval(entry, info->reload_interval);
+    if (info->zebra_visible)
+        shell_set_zebra(TRUE);
+
+    for (i = 0; i < INFO_N_COLUMNS; i++) {
+        if (info->column_titles[i])
+            shell_set_column_title(info_column_titles[i], info->column_titles[i]);
+    }
+
+    for (i = 0; i < info->groups->len; i++) {
+        struct InfoGroup *group = &g_array_index(info->groups, struct InfoGroup, i);
+
+        if (!group->fields)
+            continue;
+
+        for (j = 0; j < group->fields->len; j++) {
+            struct InfoField *field = &g_array_index(group->fields, struct InfoField, j);
+
+            if (field->update_interval) {
+                gchar *name = info_field_update_name(field);
+
+                shell_add_field_update(entry, name, field->update_interval);
+                g_free(name);
+            }
+            if (field->icon) {
+                gchar *key = info_field_key(field, i, j);
+                gchar *tag = key_mi_tag(key);
+
+                shell_set_field_icon(tag, NULL, field->icon);
+                g_free(tag);
+                g_free(key);
+            }
+        }
+    }
+
+    gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(shell->info_tree->view),
+                                      info->column_headers_visible);
+}
+
+static void module_selected_show_info_list_info(struct Info *info,
+                                                ShellModuleEntry *entry,
+                                                gboolean reload)
+{
+    guint ngroups = info->groups->len;
+    InfoTreeLevel top;
+    guint i, j;
+
+    info_tree_begin(reload);
+    info_tree_level_init(&top, NULL);
+
+    for (i = 0; i < ngroups; i++) {
+        struct InfoGroup *group = &g_array_index(info->groups, struct InfoGroup, i);
+        InfoTreeLevel children, *level = &top;
+        GtkTreeIter parent;
+
+        if (!group->fields)
+            continue;
+
+        info_group_sort(group);
+        if (ngroups > 1) {
+            info_tree_add_group(&top, &parent, group->name ? group->name : "");
+            info_tree_level_init(&children, &parent);
+            level = &children;
+        }
+
+        for (j = 0; j < group->fields->len; j++) {
+            struct InfoField *field = &g_array_index(group->fields, struct InfoField, j);
+            gchar *key = info_field_key(field, i, j);
+            gchar **values = g_strsplit(field->value ? field->value : "", "|", -1);
+            gsize vcount = g_strv_length(values);
+
+            if (!vcount) {
+                g_strfreev(values);
+                values = g_new0(gchar *, 2);
+                values[0] = g_strdup("");
+                vcount = 1;
+            }
+
+            info_tree_add_row(entry, level, key, values, vcount);
+
+            g_strfreev(values);
+            g_free(key);
+        }
+
+        if (level != &top)
+            info_tree_level_finish(level);
+    }
+
+    info_tree_level_finish(&top);
+    info_handle_params(info, entry);
+    info_tree_end(reload, ngroups);
+}
+
+static void module_selected_show_info_detail_info(struct Info *info,
+                                                  ShellModuleEntry *entry)
+{
+    guint i, j;
+
+    detail_view_clear(shell->detail_view);
+
+    for (i = 0; i < info->groups->len; i++) {
+        struct InfoGroup *group = &g_array_index(info->groups, struct InfoGroup, i);
+        GtkWidget *table;
+        gint row = 0;
+
+        if (!group->fields)
+            continue;
+
+        info_group_sort(group);
+        table = detail_view_add_group(group->name ? group->name : "",
+                                      group->fields->len);
+
+        for (j = 0; j < group->fields->len; j++) {
+            struct InfoField *field = &g_array_index(group->fields, struct InfoField, j);
+            gchar *key = info_field_key(field, i, j);
+
+            detail_view_add_row(table, &row, entry, key, g_strdup(field->value));
+            g_free(key);
+        }
+    }
+
+    info_handle_params(info, entry);
+}
+
+/* shows info if there is one, key_data otherwise */
+static void
+module_selected_show_info_data(ShellModuleEntry *entry, const gchar *key_data,
+                               struct Info *info, gboolean reload)
+{
+    GdkWindow *gdk_window = gtk_widget_get_window(GTK_WIDGET(shell->info_tree->view));
+
+    gdk_window_freeze_updates(gdk_window);
+
+    /* recreate the iter hash table; the rows are added to it again */
+    h_hash_table_remove_all(update_tbl);
+    shell_clear_field_updates();
+
+    if (info) {
+        set_view_type(info->view_type, reload);
+        if (shell->view_type == SHELL_VIEW_DETAIL)
+            module_selected_show_info_detail_info(info, entry);
+        else
+            module_selected_show_info_list_info(info, entry, reload);
+    } else {
+        module_selected_show_info_key_file(entry, key_data, reload);
+    }
 
     switch (shell->view_type) {
     case SHELL_VIEW_PROGRESS_DUAL:
@@ -1791,15 +2522,38 @@ module_selected_show_info(ShellModuleEntry *entry, gboolean reload)
         }
     }
     shell_set_note_from_entry(entry);
+    shown_entry = entry;
 
     gdk_window_thaw_updates(gdk_window);
 }
 
+static void
+module_selected_show_info(ShellModuleEntry *entry, gboolean reload)
+{
+    gchar *key_data = NULL;
+    struct Info *info;
+
+    module_entry_lock();
+    module_entry_scan(entry);
+    info = module_entry_info(entry);
+    if (!info)
+        key_data = module_entry_function(entry);
+    module_selected_show_info_data(entry, key_data, info, reload);
+    module_entry_unlock();
+
+    info_free(info);
+    g_free(key_data);
+}
+
 static void info_selected_show_extra(const gchar *tag)
 {
     if (!tag || !shell->selected->morefunc)
         return;
 
+    /* the details will be shown again with the scan result */
+    if (!module_entry_trylock())
+        return;
+
     GKeyFile *key_file = g_key_file_new();
     gchar *key_data = shell->selected->morefunc((gchar *)tag);
     gchar **groups;
@@ -1808,6 +2562,7 @@ static void info_selected_show_extra(const gchar *tag)
     groups = g_key_file_get_groups(key_file, NULL);
 
     module_selected_show_info_detail(key_file, NULL, groups);
+    module_entry_unlock();
 
     g_strfreev(groups);
     g_key_file_free(key_file);
@@ -1824,11 +2579,10 @@ static gchar *detail_view_clear_value(gchar *value)
      else
      if (g_key_file_load_from_data(keyfile, value,
                                    strlen(value), 0, NULL)) {
+          GString *lines = g_string_new(NULL);
           gchar **groups;
           gint group;
 
-          return_value = g_strdup("");
-
           groups = g_key_file_get_groups(keyfile, NULL);
           for (group = 0; groups[group]; group++) {
                gchar **keys;
@@ -1844,10 +2598,12 @@ static gchar *detail_view_clear_value(gchar *value)
                         temp++;
                      temp++;
 
-                     return_value = h_strdup_cprintf("%s\n", return_value, temp);
+                     g_string_append_printf(lines, "%s\n", temp);
                   } else {
-                     return_value = g_key_file_get_string(keyfile, groups[group],
-                                                          keys[key], NULL);
+                     temp = g_key_file_get_string(keyfile, groups[group],
+                                                  keys[key], NULL);
+                     g_string_assign(lines, temp ? temp : "");
+                     g_free(temp);
                   }
                }
 
@@ -1855,6 +2611,7 @@ static gchar *detail_view_clear_value(gchar *value)
           }
 
           g_strfreev(groups);
+          return_value = g_string_free(lines, FALSE);
      } else {
           return_value = g_strdup(value);
      }
@@ -1943,55 +2700,56 @@ static void detail_view_create_header(DetailView *detail_view,
     g_free(temp);
 }
 
-static void shell_show_detail_view(void)
+static void summary_item_free(ShellSummaryItem *item)
 {
-    GKeyFile *keyfile;
-    gchar *detail;
-
-    set_view_type(SHELL_VIEW_DETAIL, FALSE);
-    detail_view_clear(shell->detail_view);
-    detail_view_create_header(shell->detail_view, shell->selected_module->name);
-
-    keyfile = g_key_file_new();
-    detail = shell->selected_module->summaryfunc();
-
-    if (g_key_file_load_from_data(keyfile, detail,
-                                  strlen(detail), 0, NULL)) {
-         gchar **groups;
-         gint group;
-
-         groups = g_key_file_get_groups(keyfile, NULL);
+    g_free(item->icon);
+    g_free(item->name);
+    g_free(item->value);
+    g_free(item);
+}
 
-         for (group = 0; groups[group]; group++) {
-             gchar *icon, *method, *method_result;
+/* main thread: fills the summary if its module is still selected */
+static gboolean summary_done(gpointer data)
+{
+    ShellScanJob *job = (ShellScanJob *)data;
+    GSList *l;
+
+    if (job->generation == g_atomic_int_get(&scan_generation) &&
+        shell->selected_module == job->summary) {
+        if (job->summary_failed) {
+            DEBUG("error while parsing detail_view");
+            set_view_type(SHELL_VIEW_NORMAL, FALSE);
+        }
+        for (l = job->summary_items; l; l = l->next) {
+            ShellSummaryItem *item = l->data;
 
-             shell_status_pulse();
+            detail_view_add_item(shell->detail_view,
+                                 item->icon, item->name, item->value);
+        }
+    }
 
-             icon = g_key_file_get_string(keyfile, groups[group], "Icon", NULL);
-             method = g_key_file_get_string(keyfile, groups[group], "Method", NULL);
-             if (method) {
-                  method_result = module_call_method(method);
-             } else {
-                  method_result = g_strdup("N/A");
-             }
+    g_slist_free_full(job->summary_items, (GDestroyNotify)summary_item_free);
+    scan_status_stop();
+    g_free(job);
 
-             detail_view_add_item(shell->detail_view,
-                                    icon, groups[group], method_result);
-             shell_status_pulse();
+    return FALSE;
+}
 
-             g_free(icon);
-             g_free(method);
-             g_free(method_result);
-         }
+/* Shows the header right away; the module may not be initialized yet, so
+ * the rest is filled in once the scan pool has it. */
+static void shell_show_detail_view(void)
+{
+    ShellScanJob *job;
 
-         g_strfreev(groups);
-    } else {
-         DEBUG("error while parsing detail_view");
-         set_view_type(SHELL_VIEW_NORMAL, FALSE);
-    }
+    set_view_type(SHELL_VIEW_DETAIL, FALSE);
+    detail_view_clear(shell->detail_view);
+    detail_view_create_header(shell->detail_view, shell->selected_module->name);
 
-    g_free(detail);
-    g_key_file_free(keyfile);
+    job = g_new0(ShellScanJob, 1);
+    job->summary = shell->selected_module;
+    job->generation = g_atomic_int_get(&scan_generation);
+    scan_status_start(job->summary->name);
+    g_thread_pool_push(scan_pool, job, NULL);
 
     shell_view_set_enabled(TRUE);
 }
@@ -2024,6 +2782,9 @@ static void module_selected(gpointer data)
         updating = TRUE;
     }
 
+    /* scans queued for the previous selection won't be shown */
+    g_atomic_int_inc(&scan_generation);
+
     if (!gtk_tree_model_iter_parent(model, &parent, &iter)) {
         memcpy(&parent, &iter, sizeof(iter));
     }
@@ -2041,19 +2802,12 @@ static void module_selected(gpointer data)
 
         entry->selected = TRUE;
         shell->selected = entry;
-        module_selected_show_info(entry, FALSE);
-
-        gtk_tree_view_columns_autosize(GTK_TREE_VIEW(shell->info_tree->view));
-
-        /* urgh. why don't GTK do this when the model is cleared? */
-#if GTK_CHECK_VERSION(3, 0, 0)
-        /* TODO:GTK3 */
-#else
-        RANGE_SET_VALUE(info_tree, vscrollbar, 0.0);
-        RANGE_SET_VALUE(info_tree, hscrollbar, 0.0);
-        RANGE_SET_VALUE(detail_view, vscrollbar, 0.0);
-        RANGE_SET_VALUE(detail_view, hscrollbar, 0.0);
-#endif
+        if (entry->flags & MODULE_FLAG_SYNC_SCAN) {
+            module_selected_show_info(entry, FALSE);
+            module_selected_reset_scroll();
+        } else {
+            module_selected_show_cached(entry);
+        }
 
         title = g_strdup_printf("%s - %s", shell->selected_module->name,
                                 entry->name);
@@ -2063,9 +2817,12 @@ static void module_selected(gpointer data)
         shell_action_set_enabled("RefreshAction", TRUE);
         shell_action_set_enabled("CopyAction", TRUE);
 
-        shell_status_update(_("Done."));
-        shell_status_set_enabled(FALSE);
+        if (!scans_shown) {
+            shell_status_update(_("Done."));
+            shell_status_set_enabled(FALSE);
+        }
     } else {
+        shown_entry = NULL;
         shell_set_title(shell, NULL);
         shell_action_set_enabled("RefreshAction", FALSE);
         shell_action_set_enabled("CopyAction", FALSE);
@@ -2089,6 +2846,12 @@ static void info_selected(GtkTreeSelection * ts, gpointer data)
     GtkTreeIter parent;
     gchar *datacol, *mi_tag;
 
+    /* nothing else to show for the rows in the load graph */
+    if (shell->view_type == SHELL_VIEW_LOAD_GRAPH) {
+        shell_load_graph_show_selected();
+        return;
+    }
+
     if (!gtk_tree_selection_get_selected(ts, &model, &parent))
 	return;
 
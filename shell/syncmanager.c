@@ -102,10 +102,15 @@ gint sync_manager_count_entries(void)
 void sync_manager_add_entry(SyncEntry *entry)
 {
 #ifdef HAS_LIBSOUP
+    /* modules may be initialized in parallel */
+    static GMutex entries_mutex;
+
     DEBUG("registering syncmanager entry ''%s''", entry->name);
 
     entry->selected = TRUE;
+    g_mutex_lock(&entries_mutex);
     entries = g_slist_append(entries, entry);
+    g_mutex_unlock(&entries_mutex);
 #else
     DEBUG("libsoup support is disabled.");
 #endif /* HAS_LIBSOUP */
@@ -129,7 +134,11 @@ void sync_manager_show(GtkWidget *parent)
     g_warning(_("HardInfo was compiled without libsoup support. (Network "
                 "Updater requires it.)"));
 #else  /* !HAS_LIBSOUP */
-    SyncDialog *sd = sync_dialog_new(parent);
+    SyncDialog *sd;
+
+    /* modules register their entries when initialized */
+    modules_init_all(modules_get_list());
+    sd = sync_dialog_new(parent);
 
     err_quark = g_quark_from_static_string("syncmanager");
 
@@ -0,0 +1,32 @@
+#!/bin/bash
+
+# checks that a full JSON report parses; entries are rendered on a thread
+# per lock group and joined back, which is where it can go wrong
+# run from test/, with hardinfo built in ../build
+
+HARDINFO="${HARDINFO:-../build/hardinfo}"
+OUT=`mktemp`
+
+"$HARDINFO" -r -f json -q > "$OUT" || { echo "hardinfo failed"; exit 1; }
+
+if python3 -m json.tool "$OUT" > /dev/null; then
+    echo "ok: -r -f json parses"
+else
+    echo "FAIL: -r -f json doesn't parse ($OUT)"
+    exit 1
+fi
+
+# DMI and EDID strings are where bytes that aren't UTF-8 turn up
+"$HARDINFO" --query 'devices/system-dmi/*' --query 'devices/monitors/*' -f json -q \
+    | python3 -m json.tool > /dev/null \
+    && echo "ok: --query -f json parses" \
+    || { echo "FAIL: --query -f json doesn't parse"; exit 1; }
+
+# against itself, and against this machine, which has to work even if
+# things changed since
+"$HARDINFO" --diff "$OUT" "$OUT" -q > /dev/null
+[ $? -eq 0 ] && echo "ok: --diff against itself" || { echo "FAIL: --diff against itself"; exit 1; }
+"$HARDINFO" --diff "$OUT" -q > /dev/null
+[ $? -le 1 ] && echo "ok: --diff against this machine" || { echo "FAIL: --diff against this machine"; exit 1; }
+
+rm "$OUT"